@@ -1,19 +1,28 @@
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "sirio/board.hpp"
+#include "sirio/cpu_features.hpp"
+#include "sirio/engine.hpp"
 #include "sirio/evaluation.hpp"
+#include "sirio/main_search_thread.hpp"
 #include "sirio/move.hpp"
+#include "sirio/pgn.hpp"
 #include "sirio/search.hpp"
 #include "sirio/syzygy.hpp"
 #include "sirio/nnue/backend.hpp"
@@ -27,11 +36,100 @@ struct TacticalPosition {
 
 namespace {
 
-#if defined(SIRIO_USE_AVX2) || defined(SIRIO_USE_AVX512)
-constexpr bool kHasNnueAcceleration = true;
-#else
-constexpr bool kHasNnueAcceleration = false;
-#endif
+struct LatencySamples {
+    std::vector<std::uint64_t> go_to_first_node_us;
+    std::vector<std::uint64_t> stop_to_result_us;
+};
+
+std::string describe_latency(const std::vector<std::uint64_t> &samples) {
+    if (samples.empty()) {
+        return "n/a";
+    }
+    std::vector<std::uint64_t> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    std::uint64_t total = std::accumulate(sorted.begin(), sorted.end(), std::uint64_t{0});
+    std::ostringstream stream;
+    stream << "avg " << total / sorted.size() << " us, median " << sorted[sorted.size() / 2]
+           << " us, max " << sorted.back() << " us";
+    return stream.str();
+}
+
+// Repeated `go infinite` / `stop` cycles, once through the persistent main search thread used by
+// the UCI loop and once spawning and joining a thread per search as the UCI loop used to.
+std::pair<LatencySamples, LatencySamples> measure_go_stop_latency(const sirio::Board &board,
+                                                                  int cycles) {
+    using Clock = std::chrono::steady_clock;
+    sirio::Engine engine{16, 1};
+    engine.set_uci_output(false);
+    sirio::SearchLimits warmup_limits;
+    warmup_limits.max_depth = 4;
+    // Lazily initialised tables and the thread-local evaluation state would otherwise land in
+    // the first measured cycle.
+    engine.search(board, warmup_limits);
+    sirio::SearchLimits limits;
+    limits.infinite = true;
+    const auto search_time = std::chrono::milliseconds{2};
+    auto micros = [](Clock::duration duration) {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+
+    LatencySamples persistent;
+    {
+        sirio::MainSearchThread driver{engine};
+        for (int cycle = 0; cycle < cycles; ++cycle) {
+            driver.start(board, limits, {});
+            std::this_thread::sleep_for(search_time);
+            driver.request_stop();
+            driver.wait();
+            auto latency = driver.last_latency();
+            persistent.go_to_first_node_us.push_back(latency.go_to_first_node_us);
+            persistent.stop_to_result_us.push_back(latency.stop_to_result_us);
+        }
+    }
+
+    LatencySamples spawned;
+    for (int cycle = 0; cycle < cycles; ++cycle) {
+        Clock::time_point go_time = Clock::now();
+        Clock::time_point entry_time{};
+        sirio::SearchResult result;
+        std::thread worker([&]() {
+            entry_time = Clock::now();
+            result = engine.search(board, limits);
+        });
+        std::this_thread::sleep_for(search_time);
+        Clock::time_point stop_time = Clock::now();
+        engine.request_stop();
+        worker.join();
+        spawned.stop_to_result_us.push_back(micros(Clock::now() - stop_time));
+        spawned.go_to_first_node_us.push_back(micros(entry_time - go_time) +
+                                              result.instrumentation.first_node_us);
+    }
+    return {persistent, spawned};
+}
+
+// Reads a numeric field such as "VmRSS" (kB) or "Threads" from /proc/self/status.
+std::optional<std::uint64_t> read_process_status(std::string_view field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.size() > field.size() && line.compare(0, field.size(), field) == 0 &&
+            line[field.size()] == ':') {
+            return std::strtoull(line.c_str() + field.size() + 1, nullptr, 10);
+        }
+    }
+    return std::nullopt;
+}
+
+std::string describe_process_footprint() {
+    auto rss = read_process_status("VmRSS");
+    auto threads = read_process_status("Threads");
+    if (!rss.has_value() || !threads.has_value()) {
+        return "pool " + std::to_string(sirio::search_thread_pool_size()) + " helpers";
+    }
+    return "RSS " + std::to_string(*rss / 1024) + " MB, " + std::to_string(*threads) +
+           " threads, pool " + std::to_string(sirio::search_thread_pool_size()) + " helpers";
+}
 
 std::optional<std::size_t> parse_iteration_value(const char *text) {
     if (!text) {
@@ -64,23 +162,151 @@ int main(int argc, char **argv) {
     speed_limits.max_depth = 4;
 
     std::uint64_t total_nodes = 0;
+    std::vector<std::uint64_t> position_nodes;
+    sirio::SearchInstrumentationSnapshot selectivity_totals;
     auto speed_start = std::chrono::steady_clock::now();
     for (const auto &fen : speed_positions) {
         sirio::Board board{fen};
         auto result = sirio::search_best_move(board, speed_limits);
         total_nodes += result.nodes;
+        position_nodes.push_back(result.nodes);
+        const auto &stats = result.instrumentation;
+        selectivity_totals.reverse_futility_cutoffs += stats.reverse_futility_cutoffs;
+        selectivity_totals.move_count_prunes += stats.move_count_prunes;
+        selectivity_totals.null_move_cutoffs += stats.null_move_cutoffs;
+        selectivity_totals.null_move_verifications += stats.null_move_verifications;
+        selectivity_totals.null_move_verification_failures += stats.null_move_verification_failures;
+        selectivity_totals.null_move_tt_skips += stats.null_move_tt_skips;
+        selectivity_totals.mate_distance_prunes += stats.mate_distance_prunes;
+        selectivity_totals.zero_window_searches += stats.zero_window_searches;
+        selectivity_totals.lmr_researches += stats.lmr_researches;
+        selectivity_totals.lmr_research_nodes += stats.lmr_research_nodes;
+        selectivity_totals.pvs_researches += stats.pvs_researches;
+        selectivity_totals.pvs_research_nodes += stats.pvs_research_nodes;
     }
     auto speed_end = std::chrono::steady_clock::now();
     auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(speed_end - speed_start);
     double seconds = static_cast<double>(elapsed_ms.count()) / 1000.0;
     double nps = seconds > 0.0 ? static_cast<double>(total_nodes) / seconds : 0.0;
 
+    std::cout << "SIMD: " << sirio::cpu::describe_simd() << "\n\n";
     std::cout << "Search speed benchmark:\n";
     std::cout << "  Positions: " << speed_positions.size() << "\n";
     std::cout << "  Time: " << elapsed_ms.count() << " ms\n";
     std::cout << "  Nodes: " << total_nodes << "\n";
     std::cout << "  Nodes per second: " << static_cast<std::uint64_t>(nps) << "\n\n";
 
+    std::cout << "Fixed-depth selectivity (depth " << speed_limits.max_depth << "):\n";
+    for (std::size_t index = 0; index < position_nodes.size(); ++index) {
+        std::cout << "  Position " << (index + 1) << " nodes: " << position_nodes[index] << "\n";
+    }
+    std::cout << "  Reverse futility cutoffs: " << selectivity_totals.reverse_futility_cutoffs << "\n";
+    std::cout << "  Move count prunes: " << selectivity_totals.move_count_prunes << "\n";
+    std::cout << "  Null-move cutoffs: " << selectivity_totals.null_move_cutoffs << "\n";
+    std::cout << "  Null-move verifications: " << selectivity_totals.null_move_verifications
+              << " (failed " << selectivity_totals.null_move_verification_failures << ")\n";
+    std::cout << "  Null-move TT skips: " << selectivity_totals.null_move_tt_skips << "\n";
+    auto share_of_nodes = [&](std::uint64_t nodes) {
+        const double share =
+            total_nodes > 0 ? 100.0 * static_cast<double>(nodes) / static_cast<double>(total_nodes) : 0.0;
+        std::ostringstream stream;
+        stream << nodes << " nodes, " << std::fixed << std::setprecision(1) << share << "%";
+        return stream.str();
+    };
+    std::cout << "  Mate-distance prunes: " << selectivity_totals.mate_distance_prunes << "\n";
+    std::cout << "  Zero-window searches: " << selectivity_totals.zero_window_searches << "\n";
+    std::cout << "  LMR re-searches: " << selectivity_totals.lmr_researches << " ("
+              << share_of_nodes(selectivity_totals.lmr_research_nodes) << ")\n";
+    std::cout << "  PVS re-searches: " << selectivity_totals.pvs_researches << " ("
+              << share_of_nodes(selectivity_totals.pvs_research_nodes) << ")\n\n";
+
+    constexpr int kLatencyCycles = 50;
+    auto [persistent_latency, spawned_latency] =
+        measure_go_stop_latency(sirio::Board{speed_positions[1]}, kLatencyCycles);
+    std::cout << "Go/stop latency (" << kLatencyCycles << " cycles):\n";
+    std::cout << "  Persistent thread go -> first node: "
+              << describe_latency(persistent_latency.go_to_first_node_us) << "\n";
+    std::cout << "  Persistent thread stop -> bestmove: "
+              << describe_latency(persistent_latency.stop_to_result_us) << "\n";
+    std::cout << "  Thread per go go -> first node: "
+              << describe_latency(spawned_latency.go_to_first_node_us) << "\n";
+    std::cout << "  Thread per go stop -> bestmove: "
+              << describe_latency(spawned_latency.stop_to_result_us) << "\n\n";
+
+    constexpr int kEngineInstances = 32;
+    std::cout << "Engine instances (" << kEngineInstances << " x Threads=1, Hash=1):\n";
+    std::cout << "  Before: " << describe_process_footprint() << "\n";
+    std::vector<std::unique_ptr<sirio::Engine>> instances;
+    auto instances_start = std::chrono::steady_clock::now();
+    for (int index = 0; index < kEngineInstances; ++index) {
+        instances.push_back(std::make_unique<sirio::Engine>(1, 1));
+    }
+    auto instances_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - instances_start);
+    std::cout << "  Startup: " << instances_elapsed.count() << " us\n";
+    std::cout << "  After: " << describe_process_footprint() << "\n";
+    instances.front()->set_threads(8);
+    std::cout << "  One instance at Threads=8: " << describe_process_footprint() << "\n";
+    instances.front()->set_threads(1);
+    std::cout << "  Back to Threads=1: " << describe_process_footprint() << "\n\n";
+    instances.clear();
+
+    constexpr int kFenRounds = 20000;
+    std::size_t fen_checksum = 0;
+    sirio::Board fen_board;
+    char fen_buffer[sirio::Board::max_fen_length];
+    auto fen_start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kFenRounds; ++round) {
+        for (const auto &fen : speed_positions) {
+            if (fen_board.parse_fen(fen) == sirio::FenError::None) {
+                fen_checksum += fen_board.halfmove_clock();
+            }
+        }
+    }
+    auto fen_parse_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - fen_start);
+    fen_start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kFenRounds; ++round) {
+        fen_checksum += fen_board.write_fen(fen_buffer, sizeof(fen_buffer));
+    }
+    auto fen_write_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - fen_start);
+    auto per_second = [](std::size_t count, std::chrono::nanoseconds elapsed) {
+        return elapsed.count() > 0
+                   ? static_cast<std::uint64_t>(static_cast<double>(count) * 1e9 /
+                                                static_cast<double>(elapsed.count()))
+                   : 0;
+    };
+    std::cout << "FEN throughput:\n";
+    std::cout << "  parse_fen: "
+              << per_second(kFenRounds * speed_positions.size(), fen_parse_elapsed)
+              << " positions/s\n";
+    std::cout << "  write_fen: " << per_second(kFenRounds, fen_write_elapsed)
+              << " positions/s (checksum " << fen_checksum << ")\n\n";
+
+    std::filesystem::path pgn_path =
+        std::filesystem::path(__FILE__).parent_path() / "ccrl_openings.pgn";
+    if (const char *pgn_override = std::getenv("SIRIO_PGN_BENCH")) {
+        pgn_path = pgn_override;
+    }
+    sirio::pgn::PgnFile pgn_file;
+    std::string pgn_error;
+    if (pgn_file.open(pgn_path.string(), &pgn_error)) {
+        auto pgn_start = std::chrono::steady_clock::now();
+        const auto pgn_stats = sirio::pgn::read_games(pgn_file.text(), {});
+        auto pgn_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - pgn_start);
+        std::cout << "PGN reader (" << pgn_path.filename().string() << ", " << pgn_stats.threads
+                  << " threads):\n";
+        std::cout << "  Games: " << pgn_stats.games << " (" << pgn_stats.errors
+                  << " with errors), moves: " << pgn_stats.moves << "\n";
+        std::cout << "  Throughput: " << per_second(pgn_stats.games, pgn_elapsed)
+                  << " games/s, " << per_second(pgn_stats.bytes, pgn_elapsed) / 1'000'000
+                  << " MB/s\n\n";
+    } else {
+        std::cout << "PGN reader benchmark skipped: " << pgn_error << "\n\n";
+    }
+
     struct EvaluationSample {
         std::string label;
         std::string fen;
@@ -164,7 +390,8 @@ int main(int argc, char **argv) {
         constexpr std::size_t kAcceleratedIterations = 200000;
         constexpr std::size_t kScalarIterations = 50000;
 
-        std::size_t iterations = kHasNnueAcceleration ? kAcceleratedIterations : kScalarIterations;
+        const bool accelerated = sirio::cpu::active_simd_level() >= sirio::cpu::SimdLevel::Avx2;
+        std::size_t iterations = accelerated ? kAcceleratedIterations : kScalarIterations;
 
         if (const char *env_override = std::getenv("SIRIO_NNUE_ITERATIONS")) {
             if (auto parsed = parse_iteration_value(env_override)) {
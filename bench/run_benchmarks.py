@@ -244,6 +244,44 @@ def run_suite(
     return SuiteResult(suite=suite, results=results, total_nodes=total_nodes, total_time_s=total_time)
 
 
+def run_smp_scaling(
+    engine: UCIEngine,
+    suite: SuiteDefinition,
+    thread_counts: List[int],
+    limit_override: Optional[SuiteLimit],
+    position_cap: Optional[int],
+) -> Dict[str, object]:
+    """Time-to-depth of the suite at each thread count, relative to the first count."""
+    limit = limit_override if limit_override is not None else suite.limit
+    if limit.type != "depth":
+        raise ValueError("SMP scaling measures time to depth and needs a depth limit")
+    rows = []
+    baseline_time: Optional[float] = None
+    for threads in thread_counts:
+        result = run_suite(engine, suite, threads, limit, position_cap)
+        deferrals = sum(int(entry.telemetry.get("smp_deferrals", 0)) for entry in result.results)
+        if baseline_time is None:
+            baseline_time = result.total_time_s
+        speedup = baseline_time / result.total_time_s if result.total_time_s > 0 else 0.0
+        rows.append(
+            {
+                "threads": threads,
+                "time_s": result.total_time_s,
+                "nodes": result.total_nodes,
+                "smp_deferrals": deferrals,
+                "speedup": speedup,
+            }
+        )
+    print(f"SMP scaling for {suite.name} (time to depth {limit.value}):")
+    print(f"  {'threads':>7} {'time (s)':>10} {'nodes':>12} {'deferrals':>10} {'speedup':>8}")
+    for row in rows:
+        print(
+            f"  {row['threads']:>7} {row['time_s']:>10.2f} {row['nodes']:>12} "
+            f"{row['smp_deferrals']:>10} {row['speedup']:>7.2f}x"
+        )
+    return {"suite": suite.name, "depth": limit.value, "scaling": rows}
+
+
 def main(argv: Optional[List[str]] = None) -> int:
     parser = argparse.ArgumentParser(description=__doc__)
     parser.add_argument("--engine", type=Path, default=Path("./sirio"), help="Path to the engine binary")
@@ -258,6 +296,12 @@ def main(argv: Optional[List[str]] = None) -> int:
     parser.add_argument("--limit-type", choices=["depth", "nodes", "movetime"], help="Override limit type")
     parser.add_argument("--limit-value", type=int, help="Override limit value")
     parser.add_argument("--positions", type=int, default=None, help="Limit number of positions per suite")
+    parser.add_argument(
+        "--smp-scaling",
+        type=str,
+        default=None,
+        help="Comma-separated thread counts (e.g. 1,2,4,8): report time-to-depth speedup instead",
+    )
     args = parser.parse_args(argv)
 
     suite_names = args.suites if args.suites else list(SUITE_FILES.keys())
@@ -270,6 +314,12 @@ def main(argv: Optional[List[str]] = None) -> int:
             limit_override = None
             if args.limit_type and args.limit_value is not None:
                 limit_override = SuiteLimit(args.limit_type, args.limit_value)
+            if args.smp_scaling:
+                thread_counts = [int(value) for value in args.smp_scaling.split(",") if value.strip()]
+                all_results.append(
+                    run_smp_scaling(engine, suite, thread_counts, limit_override, args.positions)
+                )
+                continue
             result = run_suite(engine, suite, args.threads, limit_override, args.positions)
             print(
                 f"Completed {suite.name}: nodes={result.total_nodes} time={result.total_time_s:.2f}s "
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "sirio/search_params.hpp"
+#include "sirio/transposition_table.hpp"
+
+namespace sirio {
+
+// Fixed-size on-disk record of the persistent analysis store. Unlike the transposition table,
+// entries keep the full 64-bit zobrist key so files from different sessions and machines can be
+// merged without aliasing.
+struct AnalysisRecord {
+    std::uint64_t key = 0;
+    std::uint32_t packed_move = 0;
+    std::int32_t score = 0;
+    std::int16_t depth = 0;
+    std::uint8_t type = 0;
+    std::uint8_t reserved8 = 0;
+    std::uint32_t reserved32 = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<AnalysisRecord>, "AnalysisRecord must be trivially copyable");
+static_assert(sizeof(AnalysisRecord) == 24, "AnalysisRecord layout is part of the file format");
+
+struct AnalysisStoreStats {
+    std::size_t sorted_records = 0;
+    std::size_t appended_records = 0;
+    std::size_t pending_records = 0;
+    std::uint64_t probes = 0;
+    std::uint64_t hits = 0;
+};
+
+// Persistent analysis store: a memory-mapped file with a key-sorted prefix followed by an
+// unsorted tail of appended records. Search records deep exact PV entries while the store is
+// enabled; `append_pending` writes only those new records, and `compact` folds the tail back into
+// the sorted prefix keeping the deepest record per key.
+class AnalysisStore {
+public:
+    AnalysisStore() = default;
+    ~AnalysisStore();
+
+    AnalysisStore(const AnalysisStore &) = delete;
+    AnalysisStore &operator=(const AnalysisStore &) = delete;
+
+    // Maps `path`. A missing file is treated as an empty store.
+    bool open(const std::string &path, std::string *error = nullptr);
+    // Appends the records collected since the last append and remaps the file. The tail is
+    // compacted automatically once it outgrows the sorted prefix.
+    bool append_pending(const std::string &path, std::string *error = nullptr);
+    bool compact(const std::string &path, std::string *error = nullptr);
+    // Drops the mapping and the pending records. The file on disk is left untouched.
+    void clear();
+
+    void record(std::uint64_t key, const TTEntry &entry);
+    std::optional<TTEntry> probe(std::uint64_t key) const;
+
+    void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void set_min_depth(int depth) { min_depth_.store(depth, std::memory_order_relaxed); }
+    int min_depth() const { return min_depth_.load(std::memory_order_relaxed); }
+
+    AnalysisStoreStats stats() const;
+
+private:
+    void unmap_locked();
+    const AnalysisRecord *sorted_begin() const;
+    const AnalysisRecord *sorted_end() const;
+
+    mutable std::shared_mutex mapping_mutex_;
+    const unsigned char *mapped_data_ = nullptr;
+    std::size_t mapped_size_ = 0;
+    std::vector<unsigned char> fallback_buffer_;
+    std::size_t sorted_count_ = 0;
+    std::unordered_map<std::uint64_t, AnalysisRecord> tail_;
+
+    mutable std::mutex pending_mutex_;
+    std::unordered_map<std::uint64_t, AnalysisRecord> pending_;
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<int> min_depth_{search_params::analysis_store_min_depth};
+    mutable std::atomic<std::uint64_t> probes_{0};
+    mutable std::atomic<std::uint64_t> hits_{0};
+};
+
+AnalysisStore &shared_analysis_store();
+
+// Merges several store files into `output` (sorted, one record per key, deepest wins; on equal
+// depth later inputs win). `output` may also be one of the inputs.
+bool merge_analysis_store_files(const std::vector<std::string> &inputs, const std::string &output,
+                                std::string *error = nullptr);
+
+}  // namespace sirio
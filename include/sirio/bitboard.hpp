@@ -11,13 +11,13 @@ constexpr Bitboard one_bit(int square) {
     return Bitboard{1} << square;
 }
 
-inline int pop_lsb(Bitboard &bb) {
+constexpr int pop_lsb(Bitboard &bb) {
     const int index = std::countr_zero(bb);
     bb &= (bb - 1);
     return index;
 }
 
-inline int bit_scan_forward(Bitboard bb) {
+constexpr int bit_scan_forward(Bitboard bb) {
     return std::countr_zero(bb);
 }
 
@@ -84,7 +84,7 @@ inline Bitboard king_attacks(int square) {
     return attacks;
 }
 
-inline Bitboard ray_attacks(int square, int file_step, int rank_step, Bitboard occupancy) {
+constexpr Bitboard ray_attacks(int square, int file_step, int rank_step, Bitboard occupancy) {
     Bitboard attacks = 0;
     int file = file_of(square);
     int rank = rank_of(square);
@@ -111,6 +111,15 @@ inline Bitboard queen_attacks(int square, Bitboard occupancy) {
     return bishop_attacks(square, occupancy) | rook_attacks(square, occupancy);
 }
 
+// Squares strictly between two aligned squares (empty when not on a shared rank, file or diagonal).
+Bitboard squares_between(int from, int to);
+
+// Full rank, file or diagonal through two aligned squares (empty when not aligned).
+Bitboard line_through(int first, int second);
+
+// Builds the rook and bishop attack tables (about 2.3 MB, too large to evaluate as constexpr
+// within default compiler limits). Lookups build them on first use; the UCI loop calls this on its
+// startup thread so the first search does not pay for it.
 void initialize_sliding_attack_tables();
 
 }  // namespace sirio
@@ -22,6 +22,19 @@ struct Move;
 
 Color opposite(Color color);
 
+// Outcome of Board::parse_fen and Board::parse_epd: the first field found malformed.
+enum class FenError {
+    None,
+    MissingFields,
+    InvalidPlacement,
+    InvalidSideToMove,
+    InvalidCastling,
+    InvalidEnPassant,
+    InvalidCounters
+};
+
+std::string_view fen_error_message(FenError error);
+
 struct CastlingRights {
     bool white_kingside = false;
     bool white_queenside = false;
@@ -36,6 +49,13 @@ struct GameState {
     int fullmove_number = 1;
     int en_passant_square = -1;
     std::uint64_t zobrist_hash = 0;
+    // Enemy pieces attacking the king of side_to_move.
+    Bitboard checkers = 0;
+    // Pieces of either colour that are the only blocker between a king and an enemy slider,
+    // indexed by the colour of that king.
+    std::array<Bitboard, 2> king_blockers{};
+    // Squares from which each piece type of side_to_move would attack the enemy king.
+    std::array<Bitboard, static_cast<std::size_t>(PieceType::Count)> check_squares{};
 };
 
 struct GameHistory {
@@ -91,8 +111,22 @@ public:
     Board();
     explicit Board(std::string_view fen);
 
+    // Longest FEN write_fen can produce, terminator included.
+    static constexpr std::size_t max_fen_length = 128;
+
+    // Throws std::invalid_argument on malformed input.
     void set_from_fen(std::string_view fen);
+    // Non-throwing variant for bulk tools. Fields are split in place and the counters read with
+    // std::from_chars, so nothing is allocated once the piece lists and the history have
+    // capacity. On error the board is left empty. Tokens after the sixth field are ignored.
+    [[nodiscard]] FenError parse_fen(std::string_view fen);
+    // EPD: the four position fields followed by optional operations ("bm e4; id \"x\";"), which
+    // are returned through `operations`. The counters are set to 0 and 1.
+    [[nodiscard]] FenError parse_epd(std::string_view epd, std::string_view *operations = nullptr);
     [[nodiscard]] std::string to_fen() const;
+    // Writes the FEN and a terminating NUL into `buffer`. Returns the length without the
+    // terminator, or 0 when `size` is too small; max_fen_length always suffices.
+    std::size_t write_fen(char *buffer, std::size_t size) const noexcept;
 
     [[nodiscard]] Bitboard pieces(Color color, PieceType type) const;
     [[nodiscard]] Bitboard occupancy(Color color) const;
@@ -106,6 +140,18 @@ public:
     [[nodiscard]] std::optional<std::pair<Color, PieceType>> piece_at(int square) const;
     [[nodiscard]] int king_square(Color color) const;
     [[nodiscard]] bool in_check(Color color) const;
+    [[nodiscard]] Bitboard checkers() const { return state_.checkers; }
+    [[nodiscard]] Bitboard king_blockers(Color color) const;
+    [[nodiscard]] Bitboard pinned_pieces(Color color) const;
+    // Legality of a pseudo-legal move for side_to_move, answered from the cached checkers and
+    // king blockers without making the move.
+    [[nodiscard]] bool is_legal(const Move &move) const;
+    // Whether a pseudo-legal move checks the enemy king, from the cached check squares and
+    // discovered-check candidates without making the move.
+    [[nodiscard]] bool gives_check(const Move &move) const;
+    [[nodiscard]] Bitboard check_squares(PieceType type) const {
+        return state_.check_squares[static_cast<std::size_t>(type)];
+    }
     [[nodiscard]] Board apply_null_move() const;
     [[nodiscard]] Board apply_move(const Move &move) const;
     void make_move(const Move &move, UndoState &undo);
@@ -118,6 +164,7 @@ public:
     [[nodiscard]] const GameHistory &history() const { return history_; }
 
     [[nodiscard]] bool is_square_attacked(int square, Color by) const;
+    [[nodiscard]] Bitboard attackers_to(int square, Bitboard occupancy) const;
 
 private:
     static constexpr std::size_t piece_type_count = static_cast<std::size_t>(PieceType::Count);
@@ -136,10 +183,14 @@ private:
     void add_to_piece_list(Color color, PieceType type, int square);
     void remove_from_piece_list(Color color, PieceType type, int square);
     void clear();
-    static PieceType piece_type_from_char(char piece);
-    static char piece_to_char(Color color, PieceType type);
+    [[nodiscard]] FenError parse_position_fields(std::string_view placement,
+                                                 std::string_view active_color,
+                                                 std::string_view castling,
+                                                 std::string_view en_passant);
+    void update_check_state();
+    [[nodiscard]] Bitboard compute_checkers() const;
+    [[nodiscard]] Bitboard compute_king_blockers(Color color) const;
     static int square_from_string(std::string_view square);
-    static std::string square_to_string(int square);
 };
 
 }  // namespace sirio
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace sirio::cpu {
+
+// Instruction-set levels the SIMD kernels are compiled for. Every level is built into the same
+// binary; the best one the processor supports is picked at startup from CPUID.
+enum class SimdLevel : int { Scalar = 0, Sse41 = 1, Avx2 = 2, Avx512 = 3 };
+
+struct Features {
+    bool sse41 = false;
+    bool popcnt = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool bmi2 = false;
+    // PEXT is microcoded (hundreds of cycles) on AMD processors before Zen 3.
+    bool fast_pext = false;
+    bool avx512 = false;
+    bool avx512_vnni = false;
+};
+
+// Raw CPUID results, including the operating system's support for the wider register state.
+const Features &detected_features();
+// Highest level supported by both the processor and this build.
+SimdLevel detected_simd_level();
+SimdLevel active_simd_level();
+// Caps the active level; requests above detected_simd_level() are clamped. Returns the new level.
+SimdLevel set_simd_level(SimdLevel requested);
+
+std::optional<SimdLevel> parse_simd_level(std::string_view text);
+std::string_view simd_level_name(SimdLevel level);
+// "AVX2 (sse4.1 popcnt avx2 fma bmi2 pext)": the active level and the detected features.
+std::string describe_simd();
+
+using DotWeightsFn = double (*)(const double *weights, const int *values, std::size_t count);
+// accumulator[i] += weights[i] * scale
+using AccumulateRowFn = void (*)(std::int32_t *accumulator, const std::int16_t *weights,
+                                 std::size_t count, std::int32_t scale);
+// sum of max(accumulator[i], 0) * weights[i]
+using ReluDotFn = std::int64_t (*)(const std::int32_t *accumulator, const std::int16_t *weights,
+                                   std::size_t count);
+
+struct Kernels {
+    SimdLevel level = SimdLevel::Scalar;
+    DotWeightsFn dot_weights = nullptr;
+    AccumulateRowFn accumulate_row = nullptr;
+    ReluDotFn relu_dot = nullptr;
+};
+
+// Kernel table for the active level. accumulate_row and relu_dot return the same integers at every
+// level; dot_weights sums in a different order (and with FMA from AVX2 up), so its last bits can
+// differ between levels unless every partial sum is exact.
+const Kernels &kernels();
+
+}  // namespace sirio::cpu
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "sirio/board.hpp"
+#include "sirio/evaluation.hpp"
+#include "sirio/search.hpp"
+#include "sirio/transposition_table.hpp"
+
+namespace sirio {
+
+// An independent search engine: it owns a transposition table, an evaluation prototype, a
+// thread budget (its slice of the process-wide search worker pool) and its stop state, so several
+// engines can search concurrently in one process. Syzygy tables and NNUE network files remain
+// process-wide read-only resources, as do the time-management settings.
+//
+// The free functions (search_best_move, set_search_threads, request_stop_search, ...) act on
+// default_engine(), which uses shared_transposition_table() and default_evaluation_prototype().
+class Engine {
+public:
+    // Called from the primary search thread each time the shared best result improves.
+    using InfoCallback = std::function<void(const SearchResult &)>;
+
+    explicit Engine(std::size_t hash_size_mb = 16, int threads = 1);
+    ~Engine();
+
+    Engine(const Engine &) = delete;
+    Engine &operator=(const Engine &) = delete;
+
+    SearchResult search(const Board &board, const SearchLimits &limits);
+    // A stop that arrives before a search has installed its stop state is held until that search
+    // starts; clear_pending_stop() drops such a stop when no search is on its way.
+    void request_stop();
+    void clear_pending_stop();
+
+    void set_threads(int threads);
+    int threads() const;
+    // Gives each Lazy SMP helper its own LMR table, null-move R, root move order and iteration
+    // skip schedule. Enabled by default; applies from the next search.
+    void set_smp_diversity(bool enabled);
+    bool smp_diversity() const;
+    void set_hash_size(std::size_t size_mb);
+    void clear_hash();
+
+    // The callback and the UCI `info` output are captured when a search starts. Embedders that
+    // consume structured results disable the text output.
+    void set_info_callback(InfoCallback callback);
+    void set_uci_output(bool enabled);
+
+    GlobalTranspositionTable &transposition_table();
+    EvaluationPrototype &evaluation();
+
+    struct State;
+
+private:
+    struct DefaultInstanceTag {};
+    explicit Engine(DefaultInstanceTag);
+    friend Engine &default_engine();
+
+    std::unique_ptr<GlobalTranspositionTable> owned_tt_;
+    std::unique_ptr<EvaluationPrototype> owned_evaluation_;
+    GlobalTranspositionTable *tt_ = nullptr;
+    EvaluationPrototype *evaluation_ = nullptr;
+    std::unique_ptr<State> state_;
+};
+
+Engine &default_engine();
+
+}  // namespace sirio
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -41,6 +42,38 @@ std::unique_ptr<EvaluationBackend> make_nnue_evaluation(
 
 std::size_t classical_evaluation_pawn_cache_misses();
 
+// Backend prototype that search threads clone into their thread-local evaluation state. Each
+// Engine owns one; threads evaluate with the prototype bound by ScopedEvaluationPrototype, or
+// with default_evaluation_prototype() when none is bound.
+class EvaluationPrototype {
+public:
+    EvaluationPrototype();
+    ~EvaluationPrototype();
+    EvaluationPrototype(const EvaluationPrototype &) = delete;
+    EvaluationPrototype &operator=(const EvaluationPrototype &) = delete;
+
+    void set_backend(std::unique_ptr<EvaluationBackend> backend);
+    std::unique_ptr<EvaluationBackend> clone_backend(std::uint64_t *generation);
+    std::uint64_t generation() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+EvaluationPrototype &default_evaluation_prototype();
+
+class ScopedEvaluationPrototype {
+public:
+    explicit ScopedEvaluationPrototype(EvaluationPrototype &prototype);
+    ~ScopedEvaluationPrototype();
+    ScopedEvaluationPrototype(const ScopedEvaluationPrototype &) = delete;
+    ScopedEvaluationPrototype &operator=(const ScopedEvaluationPrototype &) = delete;
+
+private:
+    EvaluationPrototype *previous_;
+};
+
 void set_evaluation_backend(std::unique_ptr<EvaluationBackend> backend);
 void use_classical_evaluation();
 EvaluationBackend &active_evaluation_backend();
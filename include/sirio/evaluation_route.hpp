@@ -56,8 +56,10 @@ public:
     ExperimentalSirioNNUE2Runtime() = default;
     explicit ExperimentalSirioNNUE2Runtime(const ExperimentalEvaluationConfig &config);
 
+    // Without a network path the embedded network, if the build carries one, is used instead.
     bool load_from_config(const ExperimentalEvaluationConfig &config);
     bool load_from_file(const std::string &network_path);
+    bool load_embedded();
 
     [[nodiscard]] bool is_active() const;
     [[nodiscard]] bool is_loaded() const;
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sirio/board.hpp"
+
+namespace sirio {
+
+// Linearised view of the classical evaluation, used by the Texel tuner (tune/tune.cpp). The
+// weights of sirio/evaluation_weights.hpp are flattened into middlegame/endgame pairs, group by
+// group in classical_weight_groups() order. Outside the specialised endgames the evaluation is
+//
+//   scale * sum_i (mg_i * coeff_mg_i * phase + eg_i * coeff_eg_i * (24 - phase)) / 24
+//
+// plus the terms that are not tuned (king-distance heuristics of bare endgames and rounding).
+// Material and piece-square coefficients count white pieces minus black pieces; a term weight
+// such as `mobility_mg_weight` has the term's raw white-minus-black score / 100 as coefficient.
+
+struct ClassicalWeightGroup {
+    const char *mg_name;
+    const char *eg_name;
+    // 0 for a scalar constant, otherwise the length of the two arrays.
+    std::size_t size;
+};
+
+struct ClassicalWeight {
+    int mg = 0;
+    int eg = 0;
+};
+
+struct ClassicalTraceTerm {
+    std::uint16_t index = 0;
+    float mg = 0.0F;
+    float eg = 0.0F;
+};
+
+struct ClassicalEvaluationTrace {
+    // Non-zero coefficients only, by ascending weight index.
+    std::vector<ClassicalTraceTerm> terms;
+    // Clamped game phase, 24 with every piece on the board.
+    int phase = 0;
+    // 0.5 with opposite-coloured bishops, 1 otherwise.
+    float scale = 1.0F;
+    // The classical evaluation of the position, from white's point of view.
+    int evaluation = 0;
+};
+
+const std::vector<ClassicalWeightGroup> &classical_weight_groups();
+// The compiled-in weights, flattened.
+std::vector<ClassicalWeight> classical_weights();
+
+// Returns false when a specialised endgame evaluator scores the position, which the linear model
+// cannot describe.
+bool trace_classical_evaluation(const Board &board, ClassicalEvaluationTrace &trace);
+
+// The linear part of the evaluation under `weights`, in centipawns.
+double evaluate_classical_trace(const ClassicalEvaluationTrace &trace,
+                                const std::vector<ClassicalWeight> &weights);
+
+}  // namespace sirio
@@ -0,0 +1,142 @@
+// Generated by sirio_tune; see docs/evaluation.md. Edits by hand are overwritten on the next run.
+#pragma once
+
+#include <array>
+
+namespace sirio::evaluation_weights {
+
+inline constexpr std::array<int, 6> piece_values_mg = {100, 325, 340, 510, 980, 0};
+inline constexpr std::array<int, 6> piece_values_eg = {100, 310, 320, 520, 1000, 0};
+
+inline constexpr std::array<int, 64> pawn_table_mg = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+     15,  18,  20,  20,  20,  20,  18,  15,
+     12,  16,  20,  25,  25,  20,  16,  12,
+      8,  12,  18,  30,  30,  18,  12,   8,
+      4,   8,  16,  28,  28,  16,   8,   4,
+      2,   6,  12,  20,  20,  12,   6,   2,
+      0,   0,   4,   8,   8,   4,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0};
+
+inline constexpr std::array<int, 64> pawn_table_eg = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+     15,  18,  20,  20,  20,  20,  18,  15,
+     12,  16,  20,  25,  25,  20,  16,  12,
+      8,  12,  18,  30,  30,  18,  12,   8,
+      4,   8,  16,  28,  28,  16,   8,   4,
+      2,   6,  12,  20,  20,  12,   6,   2,
+      0,   0,   4,   8,   8,   4,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0};
+
+inline constexpr std::array<int, 64> knight_table_mg = {
+    -30, -20, -15, -15, -15, -15, -20, -30,
+    -20,  -5,   0,   5,   5,   0,  -5, -20,
+    -15,   0,  10,  18,  18,  10,   0, -15,
+    -15,   5,  18,  24,  24,  18,   5, -15,
+    -15,   5,  18,  24,  24,  18,   5, -15,
+    -15,   0,  12,  18,  18,  12,   0, -15,
+    -20,  -5,   0,   6,   6,   0,  -5, -20,
+    -30, -20, -15, -15, -15, -15, -20, -30};
+
+inline constexpr std::array<int, 64> knight_table_eg = {
+    -30, -20, -15, -15, -15, -15, -20, -30,
+    -20,  -5,   0,   5,   5,   0,  -5, -20,
+    -15,   0,  10,  18,  18,  10,   0, -15,
+    -15,   5,  18,  24,  24,  18,   5, -15,
+    -15,   5,  18,  24,  24,  18,   5, -15,
+    -15,   0,  12,  18,  18,  12,   0, -15,
+    -20,  -5,   0,   6,   6,   0,  -5, -20,
+    -30, -20, -15, -15, -15, -15, -20, -30};
+
+inline constexpr std::array<int, 64> bishop_table_mg = {
+    -20, -10, -10, -10, -10, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,  10,  10,   5,   0, -10,
+    -10,   5,   5,  10,  10,   5,   5, -10,
+    -10,   0,  10,  10,  10,  10,   0, -10,
+    -10,  10,  10,  10,  10,  10,  10, -10,
+    -10,   5,   0,   0,   0,   0,   5, -10,
+    -20, -10, -10, -10, -10, -10, -10, -20};
+
+inline constexpr std::array<int, 64> bishop_table_eg = {
+    -20, -10, -10, -10, -10, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,  10,  10,   5,   0, -10,
+    -10,   5,   5,  10,  10,   5,   5, -10,
+    -10,   0,  10,  10,  10,  10,   0, -10,
+    -10,  10,  10,  10,  10,  10,  10, -10,
+    -10,   5,   0,   0,   0,   0,   5, -10,
+    -20, -10, -10, -10, -10, -10, -10, -20};
+
+inline constexpr std::array<int, 64> rook_table_mg = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+      5,  10,  10,  10,  10,  10,  10,   5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+      0,   0,   0,   5,   5,   0,   0,   0};
+
+inline constexpr std::array<int, 64> rook_table_eg = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+      5,  10,  10,  10,  10,  10,  10,   5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+      0,   0,   0,   5,   5,   0,   0,   0};
+
+inline constexpr std::array<int, 64> queen_table_mg = {
+    -20, -10, -10,  -5,  -5, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,   5,   5,   5,   0, -10,
+     -5,   0,   5,   5,   5,   5,   0,  -5,
+      0,   0,   5,   5,   5,   5,   0,  -5,
+    -10,   5,   5,   5,   5,   5,   0, -10,
+    -10,   0,   5,   0,   0,   0,   0, -10,
+    -20, -10, -10,  -5,  -5, -10, -10, -20};
+
+inline constexpr std::array<int, 64> queen_table_eg = {
+    -20, -10, -10,  -5,  -5, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,   5,   5,   5,   0, -10,
+     -5,   0,   5,   5,   5,   5,   0,  -5,
+      0,   0,   5,   5,   5,   5,   0,  -5,
+    -10,   5,   5,   5,   5,   5,   0, -10,
+    -10,   0,   5,   0,   0,   0,   0, -10,
+    -20, -10, -10,  -5,  -5, -10, -10, -20};
+
+inline constexpr std::array<int, 64> king_table_mg = {
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -20, -30, -30, -40, -40, -30, -30, -20,
+    -10, -20, -20, -20, -20, -20, -20, -10,
+     20,  20,   0,   0,   0,   0,  20,  20,
+     20,  30,  10,   0,   0,  10,  30,  20};
+
+inline constexpr std::array<int, 64> king_table_eg = {
+    -50, -40, -30, -20, -20, -30, -40, -50,
+    -30, -20, -10,   0,   0, -10, -20, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -30,   0,   0,   0,   0, -30, -30,
+    -50, -40, -30, -20, -20, -30, -40, -50};
+
+inline constexpr int bishop_pair_bonus_mg = 45;
+inline constexpr int bishop_pair_bonus_eg = 35;
+inline constexpr int pawn_structure_mg_weight = 80;
+inline constexpr int pawn_structure_eg_weight = 110;
+inline constexpr int king_safety_mg_weight = 125;
+inline constexpr int king_safety_eg_weight = 60;
+inline constexpr int mobility_mg_weight = 90;
+inline constexpr int mobility_eg_weight = 100;
+inline constexpr int minor_piece_mg_weight = 95;
+inline constexpr int minor_piece_eg_weight = 105;
+
+}  // namespace sirio::evaluation_weights
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <span>
 
@@ -94,6 +95,27 @@ struct ReverseFutilityRuntimeCounters {
 struct MoveCountPruningRuntimeCounters {
     int continue_applied = 0;
 };
+struct NullMovePruningRuntimeCounters {
+    int cutoff_applied = 0;
+    int verification_applied = 0;
+    int verification_failed_applied = 0;
+    int tt_skip_applied = 0;
+};
+struct MateDistanceRuntimeCounters {
+    int prune_applied = 0;
+};
+struct ReSearchRuntimeCounters {
+    int zero_window_applied = 0;
+    int lmr_research_applied = 0;
+    int pvs_research_applied = 0;
+    std::uint64_t lmr_research_nodes = 0;
+    std::uint64_t pvs_research_nodes = 0;
+    int lmr_reduction_applied = 0;
+    std::uint64_t lmr_reduction_plies = 0;
+};
+struct SmpRuntimeCounters {
+    int deferral_applied = 0;
+};
 struct ProbCutRuntimeCounters {
     int candidate_source_none_applied = 0;
     int candidate_source_explicit_flags_applied = 0;
@@ -188,6 +210,24 @@ public:
     }
     void reset_capture_noisy_runtime_update_counters();
     void record_capture_noisy_runtime_update_applied();
+    [[nodiscard]] const ReverseFutilityRuntimeCounters &reverse_futility_runtime_counters() const {
+        return reverse_futility_runtime_counters_;
+    }
+    [[nodiscard]] const MoveCountPruningRuntimeCounters &move_count_pruning_runtime_counters() const {
+        return move_count_pruning_runtime_counters_;
+    }
+    [[nodiscard]] const NullMovePruningRuntimeCounters &null_move_pruning_runtime_counters() const {
+        return null_move_pruning_runtime_counters_;
+    }
+    [[nodiscard]] const MateDistanceRuntimeCounters &mate_distance_runtime_counters() const {
+        return mate_distance_runtime_counters_;
+    }
+    [[nodiscard]] const ReSearchRuntimeCounters &research_runtime_counters() const {
+        return research_runtime_counters_;
+    }
+    [[nodiscard]] const SmpRuntimeCounters &smp_runtime_counters() const {
+        return smp_runtime_counters_;
+    }
     [[nodiscard]] int continuation_quiet_beta_cutoff_update_count_for_tests() const;
     [[nodiscard]] int continuation_quiet_beta_cutoff_malus_count_for_tests() const;
     [[nodiscard]] int continuation_quiet_beta_cutoff_skip_count_for_tests() const;
@@ -206,6 +246,28 @@ public:
     [[nodiscard]] int move_count_pruning_continue_count_for_tests() const;
     void record_move_count_pruning_continue();
     void reset_move_count_pruning_runtime_observability_for_tests();
+    [[nodiscard]] int null_move_cutoff_count_for_tests() const;
+    void record_null_move_cutoff();
+    [[nodiscard]] int null_move_verification_count_for_tests() const;
+    void record_null_move_verification();
+    [[nodiscard]] int null_move_verification_failed_count_for_tests() const;
+    void record_null_move_verification_failed();
+    [[nodiscard]] int null_move_tt_skip_count_for_tests() const;
+    void record_null_move_tt_skip();
+    void reset_null_move_pruning_runtime_observability_for_tests();
+    [[nodiscard]] int mate_distance_prune_count_for_tests() const;
+    void record_mate_distance_prune();
+    void reset_mate_distance_runtime_observability_for_tests();
+    [[nodiscard]] int zero_window_search_count_for_tests() const;
+    void record_zero_window_search();
+    [[nodiscard]] int lmr_research_count_for_tests() const;
+    void record_lmr_research(std::uint64_t nodes);
+    void record_lmr_reduction(int plies);
+    [[nodiscard]] int pvs_research_count_for_tests() const;
+    void record_pvs_research(std::uint64_t nodes);
+    void reset_research_runtime_observability_for_tests();
+    [[nodiscard]] int smp_deferral_count_for_tests() const;
+    void record_smp_deferral();
     [[nodiscard]] int probcut_probe_count_for_tests() const;
     void record_probcut_probe();
     [[nodiscard]] int probcut_candidate_source_none_count_for_tests() const;
@@ -246,6 +308,10 @@ private:
     CorrectionRuntimeUpdateCounters correction_runtime_update_counters_{};
     ReverseFutilityRuntimeCounters reverse_futility_runtime_counters_{};
     MoveCountPruningRuntimeCounters move_count_pruning_runtime_counters_{};
+    NullMovePruningRuntimeCounters null_move_pruning_runtime_counters_{};
+    MateDistanceRuntimeCounters mate_distance_runtime_counters_{};
+    ReSearchRuntimeCounters research_runtime_counters_{};
+    SmpRuntimeCounters smp_runtime_counters_{};
     ProbCutRuntimeCounters probcut_runtime_counters_{};
 };
 
@@ -0,0 +1,135 @@
+#ifndef SIRIO_LIBSIRIO_H
+#define SIRIO_LIBSIRIO_H
+
+/*
+ * C ABI of the engine, built as the `libsirio` shared library. Every call reports a
+ * sirio_status; results are plain structs (no UCI text), so GUIs, training pipelines and
+ * bindings in other languages can embed the engine without driving the UCI protocol.
+ *
+ * A sirio_engine owns its own transposition table, evaluation and thread budget. Calls on one
+ * engine must not overlap, except sirio_engine_stop, which may be called from any thread while
+ * sirio_engine_search runs. Syzygy tables are process-wide.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && !defined(SIRIO_STATIC)
+#if defined(SIRIO_BUILDING_LIBRARY)
+#define SIRIO_API __declspec(dllexport)
+#else
+#define SIRIO_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__)
+#define SIRIO_API __attribute__((visibility("default")))
+#else
+#define SIRIO_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIRIO_API_VERSION 1
+#define SIRIO_MAX_PV_LENGTH 64
+#define SIRIO_NULL_MOVE 0u
+#define SIRIO_EVAL_INVALID INT32_MIN
+
+typedef enum sirio_status {
+    SIRIO_OK = 0,
+    SIRIO_ERROR_INVALID_ARGUMENT = 1,
+    SIRIO_ERROR_INVALID_FEN = 2,
+    SIRIO_ERROR_ILLEGAL_MOVE = 3,
+    SIRIO_ERROR_UNKNOWN_OPTION = 4,
+    SIRIO_ERROR_INVALID_VALUE = 5,
+    SIRIO_ERROR_LOAD_FAILED = 6,
+    SIRIO_ERROR_INTERNAL = 7
+} sirio_status;
+
+typedef struct sirio_engine sirio_engine;
+
+/*
+ * Moves are encoded as from | to << 6 | promotion << 12, with squares numbered a1 = 0 ... h8 = 63
+ * and promotion 0 = none, 1 = knight, 2 = bishop, 3 = rook, 4 = queen. SIRIO_NULL_MOVE marks the
+ * absence of a move.
+ */
+typedef uint16_t sirio_move;
+
+/* Zero-initialise and set the fields to use; all zero means an infinite search (stop it with
+ * sirio_engine_stop). Clock fields without a time or increment for the side to move are
+ * rejected with SIRIO_ERROR_INVALID_ARGUMENT. */
+typedef struct sirio_search_limits {
+    int32_t depth;
+    int32_t move_time_ms;
+    uint64_t nodes;
+    int32_t white_time_ms;
+    int32_t black_time_ms;
+    int32_t white_increment_ms;
+    int32_t black_increment_ms;
+    int32_t moves_to_go;
+} sirio_search_limits;
+
+typedef struct sirio_search_info {
+    sirio_move best_move;
+    /* Centipawns from the side to move's point of view; when is_mate is set, `score` holds the
+     * signed number of moves to mate instead. */
+    int32_t score;
+    int32_t is_mate;
+    int32_t depth;
+    int32_t seldepth;
+    uint64_t nodes;
+    uint64_t nodes_per_second;
+    int32_t time_ms;
+    int32_t timed_out;
+    uint32_t pv_length;
+    sirio_move pv[SIRIO_MAX_PV_LENGTH];
+} sirio_search_info;
+
+/* Receives every improvement of the best line while the search runs. The pointer is only valid
+ * during the call. */
+typedef void (*sirio_info_callback)(const sirio_search_info *info, void *user_data);
+
+SIRIO_API uint32_t sirio_api_version(void);
+
+/* Returns NULL if the engine cannot be created. */
+SIRIO_API sirio_engine *sirio_engine_create(uint32_t hash_mb, int32_t threads);
+SIRIO_API void sirio_engine_destroy(sirio_engine *engine);
+
+/* Message describing the last failed call on `engine`; empty after a successful call. */
+SIRIO_API const char *sirio_engine_last_error(const sirio_engine *engine);
+
+/*
+ * Recognised options: "Hash" (MB), "Threads", "Clear Hash" (value ignored), "EvalFile" (path to
+ * a network; empty or "classical" selects the classical evaluation) and "SyzygyPath".
+ */
+SIRIO_API sirio_status sirio_engine_set_option(sirio_engine *engine, const char *name,
+                                               const char *value);
+
+/* `fen` may be NULL for the start position. `moves` are UCI strings applied in order. On error
+ * the previous position is kept. */
+SIRIO_API sirio_status sirio_engine_set_position(sirio_engine *engine, const char *fen,
+                                                 const char *const *moves, size_t move_count);
+
+/* Blocks until the search ends. `callback` and `result` may be NULL. */
+SIRIO_API sirio_status sirio_engine_search(sirio_engine *engine, const sirio_search_limits *limits,
+                                           sirio_info_callback callback, void *user_data,
+                                           sirio_search_info *result);
+/* Stops the running search; a stop sent while no search runs is ignored. */
+SIRIO_API void sirio_engine_stop(sirio_engine *engine);
+
+/*
+ * Static evaluation of `count` positions with the engine's evaluation, in centipawns from the
+ * side to move's point of view. Positions that fail to parse get SIRIO_EVAL_INVALID and make
+ * the call return SIRIO_ERROR_INVALID_FEN; the other scores are still written.
+ */
+SIRIO_API sirio_status sirio_engine_evaluate(sirio_engine *engine, const char *const *fens,
+                                             size_t count, int32_t *scores);
+
+/* Writes the UCI spelling of `move` ("e2e4", "e7e8q") into `buffer`, which needs 6 bytes. */
+SIRIO_API sirio_status sirio_move_to_uci(sirio_move move, char *buffer, size_t buffer_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIRIO_LIBSIRIO_H */
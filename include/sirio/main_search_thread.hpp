@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "sirio/board.hpp"
+#include "sirio/engine.hpp"
+#include "sirio/search.hpp"
+
+namespace sirio {
+
+struct MainSearchLatency {
+    // From start() to the primary thread's first root iteration.
+    std::uint64_t go_to_first_node_us = 0;
+    // From request_stop() to the completion callback returning; 0 if the search ended on its own.
+    std::uint64_t stop_to_result_us = 0;
+};
+
+// Long-lived thread that runs an engine's searches. It sleeps on a condition variable between
+// searches and receives the position and limits by move, so `go` costs a hand-off instead of a
+// thread creation and join. The thread is started by the first search.
+class MainSearchThread {
+public:
+    using Completion =
+        std::function<void(const Board &, const SearchLimits &, const SearchResult &)>;
+
+    explicit MainSearchThread(Engine &engine);
+    ~MainSearchThread();
+
+    MainSearchThread(const MainSearchThread &) = delete;
+    MainSearchThread &operator=(const MainSearchThread &) = delete;
+
+    // Waits for the previous search to finish before handing over the new one.
+    void start(Board board, SearchLimits limits, Completion on_complete);
+    // Stops the running search, if any; does not wait.
+    void request_stop();
+    // Blocks until the current search, including its completion callback, has finished.
+    void wait();
+    bool searching() const;
+
+    MainSearchLatency last_latency() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        Board board;
+        SearchLimits limits;
+        Completion on_complete;
+        Clock::time_point go_time;
+    };
+
+    void run();
+
+    Engine &engine_;
+    mutable std::mutex mutex_;
+    std::condition_variable job_cv_;
+    std::condition_variable idle_cv_;
+    std::optional<Job> job_;
+    bool busy_ = false;
+    bool in_search_ = false;
+    bool quit_ = false;
+    std::optional<Clock::time_point> stop_time_;
+    MainSearchLatency latency_;
+    std::thread thread_;
+};
+
+}  // namespace sirio
@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "sirio/board.hpp"
 
@@ -25,6 +26,11 @@ std::string move_to_uci(const Move &move);
 Move move_from_uci(const Board &board, const std::string &uci);
 bool validate_move(const Board &board, const Move &move, Board *next_board = nullptr);
 
+// Resolves a SAN token ("Nbd7", "exd6", "e8=Q+", "O-O", annotations such as "!?" allowed) to
+// the legal move it denotes. Candidates are found from attack tables on the destination square
+// rather than by generating every move. Returns nullopt for malformed, illegal or ambiguous SAN.
+std::optional<Move> move_from_san(const Board &board, std::string_view san);
+
 // Applies a move expressed in UCI format to the given board.
 // Returns true if the token was parsed and applied successfully. This helper
 // understands the special "0000" token used by the UCI protocol to denote a
@@ -7,11 +7,21 @@
 
 namespace sirio {
 
+// Move categories of the specialised generator. Captures and Quiets partition All: promotions,
+// including quiet promotion pushes, count as captures. Evasions requires the side to move to be
+// in check and yields king moves plus captures of and interpositions against a single checker.
+// QuietChecks yields the non-capturing, non-promoting moves that give check (castling excluded).
+enum class GenType { Captures, Quiets, Evasions, QuietChecks, All };
+
+// Appends the pseudo-legal moves of one category for the side to move. The colour is resolved
+// once per call; every shift and mask below it is a compile-time constant.
+template <GenType Type>
+void generate_moves(const Board &board, std::vector<Move> &moves);
+
 std::vector<Move> generate_pseudo_legal_moves(const Board &board);
 std::vector<Move> generate_pseudo_legal_tactical_moves(const Board &board);
-std::vector<Move> generate_pseudo_legal_quiet_checks(Board &board);
+std::vector<Move> generate_pseudo_legal_quiet_checks(const Board &board);
 std::vector<Move> generate_legal_moves(Board &board);
 std::vector<Move> generate_legal_moves(const Board &board);
 
 }  // namespace sirio
-
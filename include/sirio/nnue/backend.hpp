@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <compare>
 #include <memory>
@@ -125,7 +126,16 @@ struct Nnue2NetworkParameters {
     std::vector<std::int16_t> hidden_bias;
     std::vector<std::int16_t> output_weights;
     std::int32_t output_bias = 0;
-
+    // Tensors that live in memory the network does not own (the embedded network). When set they
+    // are used instead of the vectors above, which then stay empty.
+    std::span<const std::int16_t> borrowed_input_weights;
+    std::span<const std::int16_t> borrowed_hidden_bias;
+    std::span<const std::int16_t> borrowed_output_weights;
+
+    [[nodiscard]] std::span<const std::int16_t> input_weights_view() const;
+    [[nodiscard]] std::span<const std::int16_t> hidden_bias_view() const;
+    [[nodiscard]] std::span<const std::int16_t> output_weights_view() const;
+    [[nodiscard]] bool is_borrowed() const { return !borrowed_input_weights.empty(); }
     [[nodiscard]] bool is_initialized() const;
     void clear();
 };
@@ -234,6 +244,17 @@ private:
 [[nodiscard]] Nnue2BinaryHeader make_default_nnue2_header();
 [[nodiscard]] bool load_nnue2_network_file(const std::string &path, Nnue2NetworkParameters &out_network,
                                            std::string &error_message);
+// Validates a SirioNNUE2 image held in memory and points the network's tensors into it without
+// copying. `bytes` must outlive the network and keep the tensors 2-byte aligned.
+[[nodiscard]] bool map_nnue2_network_memory(std::span<const std::byte> bytes,
+                                            Nnue2NetworkParameters &out_network,
+                                            std::string &error_message);
+// Bytes of the network compiled in with the SIRIO_EMBEDDED_NETWORK build option; empty when the
+// binary carries none.
+[[nodiscard]] std::span<const std::byte> embedded_network_image();
+// The embedded network, mapped in place on first use. Returns nullptr (and the reason) when no
+// network is embedded or the image fails validation.
+[[nodiscard]] const Nnue2NetworkParameters *embedded_network(std::string *error_message = nullptr);
 [[nodiscard]] bool decode_nnue2_minimal_layout(const Nnue2NetworkParameters &network,
                                                Nnue2MinimalDecodedLayout &out_layout,
                                                std::string &error_message);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "sirio/board.hpp"
+#include "sirio/move.hpp"
+
+namespace sirio::pgn {
+
+enum class GameResult { WhiteWins, BlackWins, Draw, Unknown };
+
+struct Game {
+    // Tag pairs in file order. The views point into the parsed text (the mapping of the PgnFile
+    // that produced it) and stay valid while that text does. Values are the raw text between the
+    // quotes, escapes included.
+    std::vector<std::pair<std::string_view, std::string_view>> tags;
+    // Main line; variations, comments and NAGs are skipped.
+    std::vector<Move> moves;
+    // From the Result tag, or from the termination token when the tag is missing.
+    GameResult result = GameResult::Unknown;
+    // Byte offset of the game's first tag in the text.
+    std::size_t offset = 0;
+    // First SAN token that did not resolve to a legal move, or the FEN tag when it did not parse.
+    // The moves before it are kept; empty when the whole main line resolved.
+    std::string_view error;
+
+    [[nodiscard]] std::string_view tag(std::string_view name) const;
+};
+
+struct Visitor {
+    // Every main-line position before `move` is played. The game's tags and result are already
+    // known; `game.moves` holds the moves that led here. Called concurrently from the workers,
+    // with `thread` in [0, threads), so callers can keep one accumulator per worker.
+    std::function<void(const Game &game, const Board &board, const Move &move, unsigned thread)>
+        on_position;
+    // Each game once its movetext ends.
+    std::function<void(const Game &game, unsigned thread)> on_game;
+};
+
+struct ReadStats {
+    std::uint64_t games = 0;
+    std::uint64_t moves = 0;
+    // Games with an unresolved move or an invalid FEN tag.
+    std::uint64_t errors = 0;
+    std::uint64_t bytes = 0;
+    unsigned threads = 0;
+};
+
+// Read-only view of a PGN file: memory-mapped where available, read into memory otherwise.
+class PgnFile {
+public:
+    PgnFile() = default;
+    ~PgnFile();
+    PgnFile(const PgnFile &) = delete;
+    PgnFile &operator=(const PgnFile &) = delete;
+
+    bool open(const std::string &path, std::string *error = nullptr);
+    void close();
+    [[nodiscard]] std::string_view text() const { return {data_, size_}; }
+
+private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<char> buffer_;
+};
+
+// Parses every game in `text` on `threads` workers (0: one per hardware thread). The text is cut
+// into chunks at lines starting with "[Event " and the workers take chunks from a shared
+// counter, so games arrive out of file order. Exceptions thrown by the visitor are rethrown
+// here once every worker has stopped.
+ReadStats read_games(std::string_view text, const Visitor &visitor, unsigned threads = 0);
+
+}  // namespace sirio::pgn
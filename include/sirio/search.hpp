@@ -21,6 +21,10 @@ struct SearchLimits {
     int moves_to_go = 0;
     std::uint64_t max_nodes = 0;
     bool infinite = false;
+    // Number of principal variations reported; the best one still decides the move.
+    int multi_pv = 1;
+    // When not empty, only these root moves are searched (UCI `go searchmoves`).
+    std::vector<Move> search_moves;
 };
 
 struct SearchEventRecord {
@@ -33,9 +37,38 @@ struct SearchEventRecord {
 struct SearchInstrumentationSnapshot {
     std::uint64_t main_nodes = 0;
     std::uint64_t quiescence_nodes = 0;
+    std::uint64_t reverse_futility_cutoffs = 0;
+    std::uint64_t move_count_prunes = 0;
+    std::uint64_t null_move_cutoffs = 0;
+    std::uint64_t null_move_verifications = 0;
+    std::uint64_t null_move_verification_failures = 0;
+    std::uint64_t null_move_tt_skips = 0;
+    std::uint64_t mate_distance_prunes = 0;
+    std::uint64_t zero_window_searches = 0;
+    // Late moves searched reduced and the plies taken off them: the average reduction is
+    // lmr_reduction_plies / lmr_reductions and the re-search rate lmr_researches / lmr_reductions.
+    std::uint64_t lmr_reductions = 0;
+    std::uint64_t lmr_reduction_plies = 0;
+    std::uint64_t lmr_researches = 0;
+    std::uint64_t lmr_research_nodes = 0;
+    std::uint64_t pvs_researches = 0;
+    std::uint64_t pvs_research_nodes = 0;
+    // Later moves put off because another thread was already searching the child position.
+    std::uint64_t smp_deferrals = 0;
+    // Microseconds from entering the search to the primary thread's first root iteration.
+    std::uint64_t first_node_us = 0;
     std::vector<SearchEventRecord> timeline;
 };
 
+// One MultiPV line: a root move, its score and the variation starting with it.
+struct SearchLine {
+    Move move;
+    int score = 0;
+    // Deepest ply reached below this root move.
+    int seldepth = 0;
+    std::vector<Move> principal_variation;
+};
+
 struct SearchResult {
     Move best_move;
     int score = 0;
@@ -49,6 +82,8 @@ struct SearchResult {
     std::uint64_t knps_before = 0;
     std::uint64_t knps_after = 0;
     std::vector<Move> principal_variation;
+    // Best first; only filled when SearchLimits::multi_pv is above one.
+    std::vector<SearchLine> lines;
     SearchInstrumentationSnapshot instrumentation;
 };
 
@@ -59,7 +94,10 @@ std::string principal_variation_to_uci(const Board &board, const std::vector<Mov
 
 void set_search_threads(int threads);
 int get_search_threads();
+void set_search_smp_diversity(bool enabled);
 int recommended_search_threads();
+// Helper threads currently alive in the process-wide search worker pool.
+int search_thread_pool_size();
 
 void request_stop_search();
 
@@ -20,12 +20,54 @@ inline constexpr std::array<int, static_cast<std::size_t>(PieceType::Count)> see
 
 inline constexpr int max_lmr_depth = 64;
 inline constexpr int max_lmr_moves = 64;
+// History-aware LMR, applied on top of the log-log base table: a quiet move is reduced by one ply
+// less per lmr_history_divisor of history score (more when the history is negative), one ply more
+// when the position is not improving, at an expected cut node or when the TT move is a capture,
+// and one ply less at PV nodes.
+inline constexpr int lmr_history_divisor = 8192;
+inline constexpr int lmr_not_improving_reduction = 1;
+inline constexpr int lmr_cut_node_reduction = 1;
+inline constexpr int lmr_tt_capture_reduction = 1;
+inline constexpr int lmr_pv_node_reduction = 1;
 
 inline constexpr std::uint64_t node_flush_interval = 512;
 inline constexpr std::chrono::microseconds info_output_lock_timeout{500};
 inline constexpr std::uint64_t time_check_interval = 2048;
 
 inline constexpr int max_search_threads = 1024;
+inline constexpr int max_multi_pv = 256;
+// Once the iterations are this deep, the share of root nodes spent below the best move scales the
+// soft time limit by node_fraction_time_base - node_fraction_time_slope * share: a best move that
+// takes nearly all the effort is settled, one that takes little of it is still contested.
+inline constexpr int node_fraction_time_min_depth = 8;
+inline constexpr double node_fraction_time_base = 1.6;
+inline constexpr double node_fraction_time_slope = 1.0;
+inline constexpr double node_fraction_time_min_scale = 0.5;
+inline constexpr double node_fraction_time_max_scale = 1.5;
+
+[[nodiscard]] inline constexpr double node_fraction_time_scale(double best_move_share) {
+    const double scale = node_fraction_time_base - node_fraction_time_slope * best_move_share;
+    if (scale < node_fraction_time_min_scale) {
+        return node_fraction_time_min_scale;
+    }
+    return scale > node_fraction_time_max_scale ? node_fraction_time_max_scale : scale;
+}
+// ABDADA-style work sharing between Lazy SMP threads: nodes with at least this much depth left
+// are advertised in the shared "currently searching" table, and a thread defers a later move
+// whose child another thread is already searching to the end of its move loop.
+inline constexpr int smp_searching_min_depth = 3;
+inline constexpr std::size_t smp_searching_table_size = 8192;
+inline constexpr std::size_t smp_max_deferred_moves = 32;
+// Lazy SMP diversity profiles. Helper i reduces late moves with divisor
+// smp_lmr_divisors[i % size] (the primary thread uses the first), shifts its null-move R by
+// smp_null_move_r_deltas[(i / 2) % size], and odd helpers rotate their root move order. Helpers
+// skip iterations in blocks of skip_size depths offset by skip_phase, indexed by (i - 1) % 20.
+inline constexpr std::array<double, 3> smp_lmr_divisors{1.95, 1.75, 2.20};
+inline constexpr std::array<int, 3> smp_null_move_r_deltas{0, 1, -1};
+inline constexpr std::array<int, 20> smp_skip_size{1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                                   3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+inline constexpr std::array<int, 20> smp_skip_phase{0, 1, 0, 1, 2, 3, 0, 1, 2, 3,
+                                                    4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
 
 inline constexpr int history_bonus_limit = 8192;
 inline constexpr int history_max = 16384;
@@ -41,11 +83,18 @@ inline constexpr int continuation_history_quiet_beta_cutoff_bonus = 16;
 inline constexpr int continuation_history_quiet_beta_cutoff_malus = -8;
 
 inline constexpr int futility_margin_depth1 = 150;
+// Quiescence futility: a capture whose material gain cannot lift the stand-pat score to within
+// this margin of alpha is skipped. Delta pruning skips the whole node when even winning a queen
+// would not.
+inline constexpr int quiescence_futility_margin = 200;
+inline constexpr int quiescence_delta_margin = 200;
 
 inline constexpr bool selectivity_reverse_futility_enabled = true;
 inline constexpr bool selectivity_move_count_pruning_enabled = true;
 inline constexpr bool selectivity_probcut_enabled = false;
 inline constexpr bool selectivity_singular_extensions_enabled = false;
+inline constexpr bool selectivity_null_move_pruning_enabled = true;
+inline constexpr bool selectivity_quiescence_checks_enabled = false;
 inline constexpr int reverse_futility_depth_limit = 0;
 inline constexpr int reverse_futility_margin_base = 0;
 inline constexpr int reverse_futility_margin_per_depth = 0;
@@ -57,6 +106,14 @@ inline constexpr int move_count_pruning_improving_offset = 0;
 inline constexpr int probcut_depth_limit = 5;
 inline constexpr int probcut_margin = 150;
 inline constexpr int probcut_reduction = 2;
+inline constexpr int null_move_depth_limit = 3;
+inline constexpr int null_move_base_reduction = 3;
+inline constexpr int null_move_depth_divisor = 4;
+inline constexpr int null_move_eval_margin = 200;
+inline constexpr int null_move_max_eval_reduction = 3;
+inline constexpr int null_move_verification_depth = 12;
+inline constexpr int analysis_store_min_depth = 10;
+inline constexpr int analysis_store_seed_max_ply = 2;
 
 
 struct ProbCutCandidateContext {
@@ -198,6 +255,15 @@ struct ProbCutReducedSearchRequest {
     return selectivity_singular_extensions_enabled;
 }
 
+[[nodiscard]] inline constexpr bool selectivity_null_move_pruning_is_enabled() {
+    return selectivity_null_move_pruning_enabled;
+}
+
+// Quiet checking moves at the first quiescence ply.
+[[nodiscard]] inline constexpr bool selectivity_quiescence_checks_are_enabled() {
+    return selectivity_quiescence_checks_enabled;
+}
+
 [[nodiscard]] inline constexpr int probcut_beta_threshold(int beta) {
     return beta + probcut_margin;
 }
@@ -284,4 +350,71 @@ struct ProbCutReducedSearchRequest {
     return static_eval >= probcut_beta_threshold(beta);
 }
 
+[[nodiscard]] inline constexpr int late_move_reduction_adjustment(int history, bool improving,
+                                                                 bool cut_node,
+                                                                 bool tt_move_is_capture,
+                                                                 bool is_pv_node) {
+    int adjustment = -history / lmr_history_divisor;
+    if (!improving) {
+        adjustment += lmr_not_improving_reduction;
+    }
+    if (cut_node) {
+        adjustment += lmr_cut_node_reduction;
+    }
+    if (tt_move_is_capture) {
+        adjustment += lmr_tt_capture_reduction;
+    }
+    if (is_pv_node) {
+        adjustment -= lmr_pv_node_reduction;
+    }
+    return adjustment;
+}
+
+[[nodiscard]] inline constexpr int null_move_reduction(int depth, int static_eval, int beta) {
+    const int depth_term = depth > 0 ? depth / null_move_depth_divisor : 0;
+    int eval_term = static_eval > beta ? (static_eval - beta) / null_move_eval_margin : 0;
+    if (eval_term > null_move_max_eval_reduction) {
+        eval_term = null_move_max_eval_reduction;
+    }
+    return null_move_base_reduction + depth_term + eval_term;
+}
+
+[[nodiscard]] inline constexpr bool should_apply_null_move_pruning(
+    int depth, int static_eval, int beta, bool in_check, bool is_pv_node, bool is_root_node,
+    bool has_non_pawn_material, bool tt_predicts_fail_low) {
+    if (!selectivity_null_move_pruning_is_enabled()) {
+        return false;
+    }
+    if (in_check || is_pv_node || is_root_node) {
+        return false;
+    }
+    if (depth < null_move_depth_limit || !has_non_pawn_material) {
+        return false;
+    }
+    if (tt_predicts_fail_low) {
+        return false;
+    }
+    return static_eval >= beta;
+}
+
+[[nodiscard]] inline constexpr bool null_move_requires_verification(int depth) {
+    return depth >= null_move_verification_depth;
+}
+
+[[nodiscard]] inline constexpr bool is_mate_score(int score) {
+    return score >= mate_threshold || score <= -mate_threshold;
+}
+
+// Best and worst scores still reachable at `ply`: mating on the next move or being mated now.
+[[nodiscard]] inline constexpr int mate_in(int ply) { return mate_score - ply; }
+[[nodiscard]] inline constexpr int mated_in(int ply) { return -mate_score + ply; }
+
+[[nodiscard]] inline constexpr int mate_distance_alpha(int alpha, int ply) {
+    return alpha > mated_in(ply) ? alpha : mated_in(ply);
+}
+
+[[nodiscard]] inline constexpr int mate_distance_beta(int beta, int ply) {
+    return beta < mate_in(ply + 1) ? beta : mate_in(ply + 1);
+}
+
 } // namespace sirio::search_params
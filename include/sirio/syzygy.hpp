@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "sirio/board.hpp"
 #include "sirio/move.hpp"
@@ -23,6 +27,34 @@ void set_tablebase_path(const std::string &path);
 [[nodiscard]] std::optional<ProbeResult> probe_wdl(const Board &board);
 [[nodiscard]] std::optional<ProbeResult> probe_root(const Board &board);
 
+enum class PreloadMode { None, WdlUpTo, All };
+
+struct PreloadPolicy {
+    PreloadMode mode = PreloadMode::None;
+    // Largest table, in pieces, included by PreloadMode::WdlUpTo.
+    int max_pieces = 0;
+};
+
+struct PreloadReport {
+    std::size_t files = 0;
+    std::uint64_t mapped_bytes = 0;
+    std::uint64_t resident_bytes = 0;
+    std::uint64_t locked_bytes = 0;
+};
+
+// Parses the SyzygyPreload values: "none", "wdl3" ... "wdl7" (WDL tables of at most that many
+// pieces) or "all" (every WDL and DTZ table).
+[[nodiscard]] std::optional<PreloadPolicy> parse_preload_policy(std::string_view text);
+
+// Maps the tables selected by `policy` under `path`, asks the kernel to read them ahead and locks
+// them in memory where RLIMIT_MEMLOCK allows, so that the first probes of a search hit the page
+// cache instead of the disk. Blocks while the files are read (callers run it on a background
+// thread) and stops early once `cancel` is set. The mappings stay until the next call or
+// release_preloaded_tables().
+PreloadReport preload_tables(const std::string &path, const PreloadPolicy &policy,
+                             const std::atomic<bool> *cancel = nullptr);
+void release_preloaded_tables();
+
 void set_probe_depth_limit(int depth);
 [[nodiscard]] int probe_depth_limit();
 void set_probe_piece_limit(int pieces);
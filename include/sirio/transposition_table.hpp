@@ -115,7 +115,20 @@ struct TTEntry {
 
 class GlobalTranspositionTable {
 public:
+    GlobalTranspositionTable() = default;
+    ~GlobalTranspositionTable();
+    GlobalTranspositionTable(const GlobalTranspositionTable &) = delete;
+    GlobalTranspositionTable &operator=(const GlobalTranspositionTable &) = delete;
+
     std::uint8_t prepare_for_search();
+    // Whether a search of `search_generation` may use an entry stored in `entry_generation`: a
+    // private table only trusts its own generation, a shared one also the few generations its
+    // sibling processes may still be searching with.
+    bool trusts_generation(std::uint8_t entry_generation, std::uint8_t search_generation) const;
+    // Tables owned by an Engine manage their own size and clearing; until either is called the
+    // table follows the process-wide set_transposition_table_size()/SharedHashName settings.
+    void resize(std::size_t size_mb);
+    void clear();
     void store(std::uint64_t key, const TTEntry &entry, std::uint8_t generation);
     std::optional<TTEntry> probe(std::uint64_t key) const;
     void prefetch(std::uint64_t key) const;
@@ -123,7 +136,14 @@ public:
     bool load(const std::string &path, std::string *error);
 
     static constexpr std::size_t cluster_capacity() { return kClusterSize; }
+    static std::uint32_t pack_move(const Move &move);
+    static Move unpack_move(std::uint32_t packed_move);
     std::size_t bucket_count_for_tests() const;
+    std::size_t allocated_bytes() const;
+    // True when the clusters live in the named POSIX shared-memory segment selected with
+    // set_transposition_table_shared_name(); otherwise the table is private to this process.
+    bool attached_to_shared_memory() const;
+    std::string shared_memory_error() const;
 
 private:
     static constexpr int kClusterSize = 4;
@@ -151,44 +171,54 @@ private:
                   "PackedTTEntry must be trivially copyable");
     static_assert(sizeof(PackedTTEntry) <= 16, "PackedTTEntry must remain compact");
 
-    struct alignas(64) Cluster {
-        std::array<std::atomic<PackedTTEntry>, kClusterSize> entries;
-
-        Cluster() {
-            for (auto &entry : entries) {
-                entry.store(PackedTTEntry{}, std::memory_order_relaxed);
-            }
+    // One entry as two lock-free 64-bit words. A 16-byte std::atomic is not lock-free on common
+    // toolchains and would go through libatomic's lock table, which is private to each process and
+    // so does not protect a shared-memory segment. The first word is stored XORed with the second:
+    // a probe that reads the halves of two different stores recovers a scrambled key16 and misses
+    // instead of returning a torn entry.
+    struct EntrySlot {
+        std::atomic<std::uint64_t> check{0};
+        std::atomic<std::uint64_t> data{0};
+
+        PackedTTEntry load() const {
+            const std::uint64_t high = data.load(std::memory_order_relaxed);
+            const std::uint64_t low = check.load(std::memory_order_relaxed) ^ high;
+            PackedTTEntry entry;
+            entry.key16 = static_cast<std::uint16_t>(low);
+            entry.depth8 = static_cast<std::uint8_t>(low >> 16);
+            entry.gen_and_type = static_cast<std::uint8_t>(low >> 24);
+            entry.packed_move = static_cast<std::uint32_t>(low >> 32);
+            entry.score = static_cast<std::int32_t>(static_cast<std::uint32_t>(high));
+            entry.static_eval = static_cast<std::int32_t>(static_cast<std::uint32_t>(high >> 32));
+            return entry;
         }
 
-        Cluster(const Cluster &other) {
-            for (std::size_t i = 0; i < entries.size(); ++i) {
-                entries[i].store(other.entries[i].load(std::memory_order_relaxed),
-                                 std::memory_order_relaxed);
-            }
+        void store(const PackedTTEntry &entry) {
+            const std::uint64_t low = static_cast<std::uint64_t>(entry.key16) |
+                                      (static_cast<std::uint64_t>(entry.depth8) << 16) |
+                                      (static_cast<std::uint64_t>(entry.gen_and_type) << 24) |
+                                      (static_cast<std::uint64_t>(entry.packed_move) << 32);
+            const std::uint64_t high =
+                static_cast<std::uint64_t>(static_cast<std::uint32_t>(entry.score)) |
+                (static_cast<std::uint64_t>(static_cast<std::uint32_t>(entry.static_eval)) << 32);
+            data.store(high, std::memory_order_relaxed);
+            check.store(low ^ high, std::memory_order_relaxed);
         }
+    };
 
-        Cluster &operator=(const Cluster &other) {
-            if (this != &other) {
-                for (std::size_t i = 0; i < entries.size(); ++i) {
-                    entries[i].store(other.entries[i].load(std::memory_order_relaxed),
-                                     std::memory_order_relaxed);
-                }
-            }
-            return *this;
-        }
+    static_assert(sizeof(EntrySlot) == 16, "EntrySlot must keep four entries per cache line");
 
-        Cluster(Cluster &&other) noexcept {
-            for (std::size_t i = 0; i < entries.size(); ++i) {
-                entries[i].store(other.entries[i].load(std::memory_order_relaxed),
-                                 std::memory_order_relaxed);
-            }
-        }
+    struct alignas(64) Cluster {
+        std::array<EntrySlot, kClusterSize> entries;
 
-        Cluster &operator=(Cluster &&other) noexcept {
+        Cluster() = default;
+
+        Cluster(const Cluster &other) { *this = other; }
+
+        Cluster &operator=(const Cluster &other) {
             if (this != &other) {
                 for (std::size_t i = 0; i < entries.size(); ++i) {
-                    entries[i].store(other.entries[i].load(std::memory_order_relaxed),
-                                     std::memory_order_relaxed);
+                    entries[i].store(other.entries[i].load());
                 }
             }
             return *this;
@@ -199,6 +229,10 @@ private:
 
     void ensure_settings_locked();
     void rebuild_locked(std::size_t size_mb);
+    bool attach_shared_locked(const std::string &name, std::size_t bucket_count);
+    void detach_shared_locked();
+    bool attached_to_current_segment_locked() const;
+    void clear_shared_locked();
     std::size_t cluster_index(std::uint64_t key) const;
     std::size_t select_entry_index(const Cluster &cluster, std::uint16_t key16);
     std::optional<PackedTTEntry> find_entry(const Cluster &cluster, std::uint16_t key16) const;
@@ -207,17 +241,29 @@ private:
     static std::uint8_t unpack_generation(std::uint8_t gen_and_type);
     static std::uint8_t pack_depth(int depth);
     static int unpack_depth(std::uint8_t depth8);
-    static std::uint32_t pack_move(const Move &move);
-    static Move unpack_move(std::uint32_t packed_move);
     static int replacement_score(const PackedTTEntry &entry, std::uint8_t current_generation);
+    // Generation of the `searches`-th search started on a shared segment.
+    static std::uint8_t shared_generation(std::uint32_t searches);
 
     mutable std::shared_mutex global_mutex_;
     static constexpr std::size_t kClusterAlignment = kTranspositionTableLargePageAlignment;
     std::vector<Cluster, AlignedAllocator<Cluster, kClusterAlignment>> clusters_;
+    // View used by probes and stores: either clusters_ or the shared-memory segment.
+    Cluster *table_ = nullptr;
+    std::size_t table_size_ = 0;
+    void *shared_mapping_ = nullptr;
+    std::size_t shared_mapping_bytes_ = 0;
+    std::string shared_segment_name_;
+    std::string shared_error_;
     std::uint8_t generation_counter_ = 1;
     std::uint8_t generation_tag_ = kGenerationDelta;
+    static constexpr int kSharedGenerationWindow = 4;
+    std::atomic<int> generation_window_{1};
     std::size_t configured_size_mb_ = 0;
     std::uint64_t epoch_marker_ = 0;
+    bool instance_managed_ = false;
+    std::size_t own_size_mb_ = 0;
+    std::uint64_t own_epoch_ = 1;
 };
 
 GlobalTranspositionTable &shared_transposition_table();
@@ -225,6 +271,11 @@ GlobalTranspositionTable &shared_transposition_table();
 void set_transposition_table_size(std::size_t size_mb);
 std::size_t get_transposition_table_size();
 void clear_transposition_tables();
+// Opt-in cross-process table: a non-empty name places the clusters in the `shm_open` segment of
+// that name (created with the current Hash size, or attached with the size of an existing one).
+// An empty name returns to a private table. Takes effect on the next prepare_for_search().
+void set_transposition_table_shared_name(const std::string &name);
+std::string get_transposition_table_shared_name();
 bool save_transposition_table(const std::string &path, std::string *error = nullptr);
 bool load_transposition_table(const std::string &path, std::string *error = nullptr);
 
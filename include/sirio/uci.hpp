@@ -4,7 +4,8 @@ namespace sirio {
 namespace uci {
 
 void initialize();
-int run();
+// Runs the UCI loop on stdin/stdout. `--startup-trace` prints startup phase timings to stderr.
+int run(int argc = 0, char* argv[] = nullptr);
 
 }  // namespace uci
 }  // namespace sirio
@@ -0,0 +1,427 @@
+#include "sirio/analysis_store.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#    define SIRIO_ANALYSIS_STORE_MMAP 1
+#endif
+
+namespace sirio {
+namespace {
+
+constexpr char kStoreMagic[4] = {'S', 'R', 'A', 'S'};
+constexpr std::uint32_t kStoreVersion = 1;
+// The tail is folded back into the sorted prefix once it is larger than the prefix and than
+// this floor, so short sessions stay cheap appends.
+constexpr std::size_t kMinCompactionTail = 4096;
+
+struct StoreHeader {
+    char magic[4] = {kStoreMagic[0], kStoreMagic[1], kStoreMagic[2], kStoreMagic[3]};
+    std::uint32_t version = kStoreVersion;
+    std::uint64_t sorted_count = 0;
+    std::uint32_t record_size = sizeof(AnalysisRecord);
+    std::uint32_t reserved = 0;
+};
+
+static_assert(sizeof(StoreHeader) == 24, "StoreHeader layout is part of the file format");
+
+void set_error(std::string *error, std::string message) {
+    if (error != nullptr) {
+        *error = std::move(message);
+    }
+}
+
+bool valid_header(const StoreHeader &header, std::size_t record_count) {
+    return std::string_view(header.magic, sizeof(header.magic)) ==
+               std::string_view(kStoreMagic, sizeof(kStoreMagic)) &&
+           header.version == kStoreVersion && header.record_size == sizeof(AnalysisRecord) &&
+           header.sorted_count <= record_count;
+}
+
+// A crash during an append can leave a partial record at the end; only whole records count.
+std::size_t whole_record_count(std::size_t file_size) {
+    if (file_size < sizeof(StoreHeader)) {
+        return 0;
+    }
+    return (file_size - sizeof(StoreHeader)) / sizeof(AnalysisRecord);
+}
+
+bool replaces(const AnalysisRecord &incoming, const AnalysisRecord &current) {
+    return incoming.depth >= current.depth;
+}
+
+AnalysisRecord make_record(std::uint64_t key, const TTEntry &entry) {
+    AnalysisRecord record;
+    record.key = key;
+    record.packed_move = GlobalTranspositionTable::pack_move(entry.best_move);
+    record.score = entry.score;
+    record.depth = static_cast<std::int16_t>(entry.depth);
+    record.type = static_cast<std::uint8_t>(entry.type);
+    return record;
+}
+
+TTEntry make_entry(const AnalysisRecord &record) {
+    TTEntry entry;
+    entry.best_move = GlobalTranspositionTable::unpack_move(record.packed_move);
+    entry.depth = record.depth;
+    entry.score = record.score;
+    entry.type = static_cast<TTNodeType>(record.type);
+    return entry;
+}
+
+bool read_store_file(const std::string &path, std::vector<AnalysisRecord> &records, std::string *error) {
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        return true;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        set_error(error, "No se pudo abrir el almacén de análisis: " + path);
+        return false;
+    }
+    const std::size_t file_size = static_cast<std::size_t>(std::filesystem::file_size(path, ec));
+    if (ec) {
+        set_error(error, "No se pudo leer el almacén de análisis: " + path);
+        return false;
+    }
+    StoreHeader header;
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    const std::size_t count = whole_record_count(file_size);
+    if (!in.good() || !valid_header(header, count)) {
+        set_error(error, "Formato de almacén de análisis inválido: " + path);
+        return false;
+    }
+    const std::size_t offset = records.size();
+    records.resize(offset + count);
+    in.read(reinterpret_cast<char *>(records.data() + offset),
+            static_cast<std::streamsize>(count * sizeof(AnalysisRecord)));
+    if (!in.good()) {
+        records.resize(offset);
+        set_error(error, "Almacén de análisis truncado: " + path);
+        return false;
+    }
+    return true;
+}
+
+// Sorts by key and keeps one record per key: the deepest, and on equal depth the one that came
+// later in `records` (stable sort preserves file and input order).
+void sort_and_deduplicate(std::vector<AnalysisRecord> &records) {
+    std::stable_sort(records.begin(), records.end(),
+                     [](const AnalysisRecord &lhs, const AnalysisRecord &rhs) { return lhs.key < rhs.key; });
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (out > 0 && records[out - 1].key == records[i].key) {
+            if (replaces(records[i], records[out - 1])) {
+                records[out - 1] = records[i];
+            }
+            continue;
+        }
+        records[out++] = records[i];
+    }
+    records.resize(out);
+}
+
+bool write_sorted_store(const std::string &path, const std::vector<AnalysisRecord> &records,
+                        std::string *error) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            set_error(error, "No se pudo guardar el almacén de análisis: " + path);
+            return false;
+        }
+        StoreHeader header;
+        header.sorted_count = records.size();
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(records.data()),
+                  static_cast<std::streamsize>(records.size() * sizeof(AnalysisRecord)));
+        if (!out.good()) {
+            set_error(error, "Error al escribir el almacén de análisis");
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        set_error(error, "No se pudo reemplazar el almacén de análisis: " + path);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+AnalysisStore::~AnalysisStore() {
+    std::unique_lock lock(mapping_mutex_);
+    unmap_locked();
+}
+
+void AnalysisStore::unmap_locked() {
+#if defined(SIRIO_ANALYSIS_STORE_MMAP)
+    if (mapped_data_ != nullptr && fallback_buffer_.empty()) {
+        ::munmap(const_cast<unsigned char *>(mapped_data_), mapped_size_);
+    }
+#endif
+    mapped_data_ = nullptr;
+    mapped_size_ = 0;
+    fallback_buffer_.clear();
+    fallback_buffer_.shrink_to_fit();
+    sorted_count_ = 0;
+    tail_.clear();
+}
+
+const AnalysisRecord *AnalysisStore::sorted_begin() const {
+    if (mapped_data_ == nullptr) {
+        return nullptr;
+    }
+    return reinterpret_cast<const AnalysisRecord *>(mapped_data_ + sizeof(StoreHeader));
+}
+
+const AnalysisRecord *AnalysisStore::sorted_end() const {
+    const AnalysisRecord *begin = sorted_begin();
+    return begin == nullptr ? nullptr : begin + sorted_count_;
+}
+
+bool AnalysisStore::open(const std::string &path, std::string *error) {
+    std::unique_lock lock(mapping_mutex_);
+    unmap_locked();
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        return true;
+    }
+    const std::size_t file_size = static_cast<std::size_t>(std::filesystem::file_size(path, ec));
+    if (ec || file_size < sizeof(StoreHeader)) {
+        set_error(error, "Formato de almacén de análisis inválido: " + path);
+        return false;
+    }
+
+#if defined(SIRIO_ANALYSIS_STORE_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        set_error(error, "No se pudo abrir el almacén de análisis: " + path);
+        return false;
+    }
+    void *address = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        set_error(error, "No se pudo mapear el almacén de análisis: " + path);
+        return false;
+    }
+    mapped_data_ = static_cast<const unsigned char *>(address);
+#else
+    std::ifstream in(path, std::ios::binary);
+    fallback_buffer_.resize(file_size);
+    if (!in || !in.read(reinterpret_cast<char *>(fallback_buffer_.data()),
+                        static_cast<std::streamsize>(file_size))) {
+        fallback_buffer_.clear();
+        set_error(error, "No se pudo abrir el almacén de análisis: " + path);
+        return false;
+    }
+    mapped_data_ = fallback_buffer_.data();
+#endif
+    mapped_size_ = file_size;
+
+    StoreHeader header;
+    std::memcpy(&header, mapped_data_, sizeof(header));
+    const std::size_t count = whole_record_count(file_size);
+    if (!valid_header(header, count)) {
+        unmap_locked();
+        set_error(error, "Formato de almacén de análisis inválido: " + path);
+        return false;
+    }
+    sorted_count_ = static_cast<std::size_t>(header.sorted_count);
+
+    // Appended records are few by construction; index them so probes stay O(1) on the tail.
+    const AnalysisRecord *records = sorted_begin();
+    for (std::size_t i = sorted_count_; i < count; ++i) {
+        AnalysisRecord record;
+        std::memcpy(&record, records + i, sizeof(record));
+        auto [it, inserted] = tail_.try_emplace(record.key, record);
+        if (!inserted && replaces(record, it->second)) {
+            it->second = record;
+        }
+    }
+    return true;
+}
+
+bool AnalysisStore::append_pending(const std::string &path, std::string *error) {
+    std::vector<AnalysisRecord> fresh;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        fresh.reserve(pending_.size());
+        for (const auto &[key, record] : pending_) {
+            fresh.push_back(record);
+        }
+    }
+    if (fresh.empty()) {
+        return true;
+    }
+    std::sort(fresh.begin(), fresh.end(),
+              [](const AnalysisRecord &lhs, const AnalysisRecord &rhs) { return lhs.key < rhs.key; });
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        if (!write_sorted_store(path, fresh, error)) {
+            return false;
+        }
+    } else {
+        const std::size_t file_size = static_cast<std::size_t>(std::filesystem::file_size(path, ec));
+        StoreHeader header;
+        {
+            std::ifstream in(path, std::ios::binary);
+            in.read(reinterpret_cast<char *>(&header), sizeof(header));
+            if (ec || !in.good() || !valid_header(header, whole_record_count(file_size))) {
+                set_error(error, "Formato de almacén de análisis inválido: " + path);
+                return false;
+            }
+        }
+        const std::size_t whole_size =
+            sizeof(StoreHeader) + whole_record_count(file_size) * sizeof(AnalysisRecord);
+        if (whole_size != file_size) {
+            std::filesystem::resize_file(path, whole_size, ec);
+        }
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.write(reinterpret_cast<const char *>(fresh.data()),
+                  static_cast<std::streamsize>(fresh.size() * sizeof(AnalysisRecord)));
+        if (ec || !out.good()) {
+            set_error(error, "Error al escribir el almacén de análisis");
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        for (const auto &record : fresh) {
+            auto it = pending_.find(record.key);
+            if (it != pending_.end() && it->second.depth == record.depth &&
+                it->second.packed_move == record.packed_move && it->second.score == record.score) {
+                pending_.erase(it);
+            }
+        }
+    }
+
+    if (!open(path, error)) {
+        return false;
+    }
+    std::size_t sorted_count = 0;
+    std::size_t tail_count = 0;
+    {
+        std::shared_lock lock(mapping_mutex_);
+        sorted_count = sorted_count_;
+        tail_count = tail_.size();
+    }
+    if (tail_count > std::max(sorted_count, kMinCompactionTail)) {
+        return compact(path, error);
+    }
+    return true;
+}
+
+bool AnalysisStore::compact(const std::string &path, std::string *error) {
+    std::vector<AnalysisRecord> records;
+    if (!read_store_file(path, records, error)) {
+        return false;
+    }
+    sort_and_deduplicate(records);
+    {
+        std::unique_lock lock(mapping_mutex_);
+        unmap_locked();
+    }
+    if (!write_sorted_store(path, records, error)) {
+        return false;
+    }
+    return open(path, error);
+}
+
+void AnalysisStore::clear() {
+    {
+        std::unique_lock lock(mapping_mutex_);
+        unmap_locked();
+    }
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_.clear();
+    probes_.store(0, std::memory_order_relaxed);
+    hits_.store(0, std::memory_order_relaxed);
+}
+
+void AnalysisStore::record(std::uint64_t key, const TTEntry &entry) {
+    if (entry.type != TTNodeType::Exact || entry.depth < min_depth()) {
+        return;
+    }
+    const AnalysisRecord record = make_record(key, entry);
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    auto [it, inserted] = pending_.try_emplace(key, record);
+    if (!inserted && replaces(record, it->second)) {
+        it->second = record;
+    }
+}
+
+std::optional<TTEntry> AnalysisStore::probe(std::uint64_t key) const {
+    probes_.fetch_add(1, std::memory_order_relaxed);
+    std::shared_lock lock(mapping_mutex_);
+    std::optional<AnalysisRecord> found;
+    const AnalysisRecord *begin = sorted_begin();
+    const AnalysisRecord *end = sorted_end();
+    if (begin != end) {
+        const AnalysisRecord *it = std::lower_bound(
+            begin, end, key, [](const AnalysisRecord &record, std::uint64_t value) { return record.key < value; });
+        if (it != end && it->key == key) {
+            found = *it;
+        }
+    }
+    if (auto tail_it = tail_.find(key); tail_it != tail_.end()) {
+        if (!found.has_value() || replaces(tail_it->second, *found)) {
+            found = tail_it->second;
+        }
+    }
+    if (!found.has_value()) {
+        return std::nullopt;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return make_entry(*found);
+}
+
+AnalysisStoreStats AnalysisStore::stats() const {
+    AnalysisStoreStats stats;
+    {
+        std::shared_lock lock(mapping_mutex_);
+        stats.sorted_records = sorted_count_;
+        stats.appended_records = tail_.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        stats.pending_records = pending_.size();
+    }
+    stats.probes = probes_.load(std::memory_order_relaxed);
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+AnalysisStore &shared_analysis_store() {
+    static AnalysisStore store;
+    return store;
+}
+
+bool merge_analysis_store_files(const std::vector<std::string> &inputs, const std::string &output,
+                                std::string *error) {
+    std::vector<AnalysisRecord> records;
+    for (const auto &input : inputs) {
+        if (!read_store_file(input, records, error)) {
+            return false;
+        }
+    }
+    sort_and_deduplicate(records);
+    return write_sorted_store(output, records, error);
+}
+
+}  // namespace sirio
@@ -1,8 +1,24 @@
 #include "sirio/bitboard.hpp"
 
 #include <array>
+#include <cstdint>
 #include <mutex>
 
+#include "sirio/cpu_features.hpp"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(SIRIO_DISABLE_AVX2)
+#include <immintrin.h>
+#define SIRIO_SLIDER_PEXT 1
+#if defined(__BMI2__)
+// The whole build targets BMI2, so PEXT needs neither a runtime check nor a separate function.
+#define SIRIO_SLIDER_PEXT_ALWAYS 1
+#elif defined(__GNUC__) || defined(__clang__)
+#define SIRIO_SLIDER_PEXT_TARGET __attribute__((target("bmi2")))
+#else
+#define SIRIO_SLIDER_PEXT_TARGET
+#endif
+#endif
+
 namespace sirio {
 
 namespace {
@@ -15,29 +31,17 @@ using RookAttackTable = std::array<std::array<Bitboard, 1 << kMaxRookRelevantBit
 
 std::once_flag sliding_table_init_flag;
 
-std::array<Bitboard, 64> bishop_masks{};
-std::array<Bitboard, 64> rook_masks{};
-
-std::array<std::array<int, kMaxBishopRelevantBits>, 64> bishop_relevant_squares{};
-std::array<std::array<int, kMaxRookRelevantBits>, 64> rook_relevant_squares{};
-
-std::array<int, 64> bishop_relevant_count{};
-std::array<int, 64> rook_relevant_count{};
-
-BishopAttackTable bishop_attacks_table{};
-RookAttackTable rook_attacks_table{};
-
-Bitboard bishop_attacks_on_the_fly(int square, Bitboard occupancy) {
+constexpr Bitboard bishop_attacks_on_the_fly(int square, Bitboard occupancy) {
     return ray_attacks(square, 1, 1, occupancy) | ray_attacks(square, -1, 1, occupancy) |
            ray_attacks(square, 1, -1, occupancy) | ray_attacks(square, -1, -1, occupancy);
 }
 
-Bitboard rook_attacks_on_the_fly(int square, Bitboard occupancy) {
+constexpr Bitboard rook_attacks_on_the_fly(int square, Bitboard occupancy) {
     return ray_attacks(square, 1, 0, occupancy) | ray_attacks(square, -1, 0, occupancy) |
            ray_attacks(square, 0, 1, occupancy) | ray_attacks(square, 0, -1, occupancy);
 }
 
-Bitboard bishop_mask(int square) {
+constexpr Bitboard bishop_mask(int square) {
     Bitboard mask = 0;
     int file = file_of(square);
     int rank = rank_of(square);
@@ -57,7 +61,7 @@ Bitboard bishop_mask(int square) {
     return mask;
 }
 
-Bitboard rook_mask(int square) {
+constexpr Bitboard rook_mask(int square) {
     Bitboard mask = 0;
     int file = file_of(square);
     int rank = rank_of(square);
@@ -77,89 +81,133 @@ Bitboard rook_mask(int square) {
     return mask;
 }
 
-Bitboard subset_to_bitboard(int subset_index, const std::array<int, kMaxBishopRelevantBits> &squares,
-                            int count) {
-    Bitboard occupancy = 0;
-    for (int i = 0; i < count; ++i) {
-        if (subset_index & (1 << i)) {
-            occupancy |= one_bit(squares[static_cast<std::size_t>(i)]);
+template <int MaxBits>
+struct RelevantSquares {
+    std::array<Bitboard, 64> masks{};
+    std::array<std::array<int, MaxBits>, 64> squares{};
+    std::array<int, 64> count{};
+};
+
+template <int MaxBits, typename MaskFn>
+constexpr RelevantSquares<MaxBits> make_relevant_squares(MaskFn mask_of) {
+    RelevantSquares<MaxBits> result{};
+    for (int square = 0; square < 64; ++square) {
+        Bitboard mask = mask_of(square);
+        result.masks[static_cast<std::size_t>(square)] = mask;
+        int count = 0;
+        while (mask) {
+            result.squares[static_cast<std::size_t>(square)][static_cast<std::size_t>(count++)] =
+                pop_lsb(mask);
         }
+        result.count[static_cast<std::size_t>(square)] = count;
     }
-    return occupancy;
+    return result;
 }
 
-Bitboard subset_to_bitboard(int subset_index, const std::array<int, kMaxRookRelevantBits> &squares,
-                            int count) {
-    Bitboard occupancy = 0;
-    for (int i = 0; i < count; ++i) {
-        if (subset_index & (1 << i)) {
-            occupancy |= one_bit(squares[static_cast<std::size_t>(i)]);
+constexpr auto bishop_relevant =
+    make_relevant_squares<kMaxBishopRelevantBits>([](int square) { return bishop_mask(square); });
+constexpr auto rook_relevant =
+    make_relevant_squares<kMaxRookRelevantBits>([](int square) { return rook_mask(square); });
+
+struct LineTables {
+    std::array<std::array<Bitboard, 64>, 64> between{};
+    std::array<std::array<Bitboard, 64>, 64> line{};
+};
+
+constexpr LineTables make_line_tables() {
+    LineTables tables{};
+    for (int first = 0; first < 64; ++first) {
+        const Bitboard first_mask = one_bit(first);
+        for (int second = 0; second < 64; ++second) {
+            if (first == second) {
+                continue;
+            }
+            const Bitboard second_mask = one_bit(second);
+            auto &between = tables.between[static_cast<std::size_t>(first)][static_cast<std::size_t>(second)];
+            auto &line = tables.line[static_cast<std::size_t>(first)][static_cast<std::size_t>(second)];
+            if (rook_attacks_on_the_fly(first, 0) & second_mask) {
+                between = rook_attacks_on_the_fly(first, second_mask) & rook_attacks_on_the_fly(second, first_mask);
+                line = (rook_attacks_on_the_fly(first, 0) & rook_attacks_on_the_fly(second, 0)) | first_mask |
+                       second_mask;
+            } else if (bishop_attacks_on_the_fly(first, 0) & second_mask) {
+                between =
+                    bishop_attacks_on_the_fly(first, second_mask) & bishop_attacks_on_the_fly(second, first_mask);
+                line = (bishop_attacks_on_the_fly(first, 0) & bishop_attacks_on_the_fly(second, 0)) | first_mask |
+                       second_mask;
+            }
         }
     }
-    return occupancy;
+    return tables;
 }
 
-std::uint32_t occupancy_to_index(Bitboard occupancy, const std::array<int, kMaxBishopRelevantBits> &squares,
-                                 int count) {
+constexpr LineTables line_tables = make_line_tables();
+
+BishopAttackTable bishop_attacks_table{};
+RookAttackTable rook_attacks_table{};
+
+// PEXT and the software loop both number the mask's squares from least to most significant, so
+// they index the same table entry. The choice is made once, when the tables are built.
+bool slider_uses_pext = false;
+
+template <int MaxBits>
+inline std::uint32_t software_slider_index(const RelevantSquares<MaxBits> &relevant, std::size_t square,
+                                           Bitboard occupancy) {
+    const auto &squares = relevant.squares[square];
+    const int count = relevant.count[square];
     std::uint32_t index = 0;
     for (int i = 0; i < count; ++i) {
-        int square = squares[static_cast<std::size_t>(i)];
-        if (occupancy & one_bit(square)) {
-            index |= static_cast<std::uint32_t>(1u << i);
-        }
+        index |= static_cast<std::uint32_t>((occupancy >> squares[static_cast<std::size_t>(i)]) & 1U) << i;
     }
     return index;
 }
 
-std::uint32_t occupancy_to_index(Bitboard occupancy, const std::array<int, kMaxRookRelevantBits> &squares,
-                                 int count) {
-    std::uint32_t index = 0;
+#if defined(SIRIO_SLIDER_PEXT) && !defined(SIRIO_SLIDER_PEXT_ALWAYS)
+SIRIO_SLIDER_PEXT_TARGET Bitboard bishop_attacks_pext(std::size_t square, Bitboard occupancy) {
+    return bishop_attacks_table[square][_pext_u64(occupancy, bishop_relevant.masks[square])];
+}
+
+SIRIO_SLIDER_PEXT_TARGET Bitboard rook_attacks_pext(std::size_t square, Bitboard occupancy) {
+    return rook_attacks_table[square][_pext_u64(occupancy, rook_relevant.masks[square])];
+}
+#endif
+
+template <std::size_t N>
+Bitboard subset_to_bitboard(int subset_index, const std::array<int, N> &squares, int count) {
+    Bitboard occupancy = 0;
     for (int i = 0; i < count; ++i) {
-        int square = squares[static_cast<std::size_t>(i)];
-        if (occupancy & one_bit(square)) {
-            index |= static_cast<std::uint32_t>(1u << i);
+        if (subset_index & (1 << i)) {
+            occupancy |= one_bit(squares[static_cast<std::size_t>(i)]);
         }
     }
-    return index;
+    return occupancy;
 }
 
 void initialize_tables() {
     for (int square = 0; square < 64; ++square) {
-        Bitboard mask = bishop_mask(square);
-        bishop_masks[static_cast<std::size_t>(square)] = mask;
-        Bitboard bits = mask;
-        int count = 0;
-        while (bits) {
-            int idx = pop_lsb(bits);
-            bishop_relevant_squares[static_cast<std::size_t>(square)][count++] = idx;
-        }
-        bishop_relevant_count[static_cast<std::size_t>(square)] = count;
+        const auto index_square = static_cast<std::size_t>(square);
+        int count = bishop_relevant.count[index_square];
         int subset_count = 1 << count;
         for (int index = 0; index < subset_count; ++index) {
-            Bitboard occ = subset_to_bitboard(index, bishop_relevant_squares[static_cast<std::size_t>(square)], count);
-            bishop_attacks_table[static_cast<std::size_t>(square)][index] =
+            Bitboard occ = subset_to_bitboard(index, bishop_relevant.squares[index_square], count);
+            bishop_attacks_table[index_square][static_cast<std::size_t>(index)] =
                 bishop_attacks_on_the_fly(square, occ);
         }
 
-        mask = rook_mask(square);
-        rook_masks[static_cast<std::size_t>(square)] = mask;
-        bits = mask;
-        count = 0;
-        while (bits) {
-            int idx = pop_lsb(bits);
-            rook_relevant_squares[static_cast<std::size_t>(square)][count++] = idx;
-        }
-        rook_relevant_count[static_cast<std::size_t>(square)] = count;
+        count = rook_relevant.count[index_square];
         subset_count = 1 << count;
         for (int index = 0; index < subset_count; ++index) {
-            Bitboard occ = subset_to_bitboard(index, rook_relevant_squares[static_cast<std::size_t>(square)], count);
-            rook_attacks_table[static_cast<std::size_t>(square)][index] = rook_attacks_on_the_fly(square, occ);
+            Bitboard occ = subset_to_bitboard(index, rook_relevant.squares[index_square], count);
+            rook_attacks_table[index_square][static_cast<std::size_t>(index)] =
+                rook_attacks_on_the_fly(square, occ);
         }
     }
 }
 
 void ensure_tables() {
-    std::call_once(sliding_table_init_flag, initialize_tables);
+    std::call_once(sliding_table_init_flag, [] {
+        initialize_tables();
+        slider_uses_pext = cpu::detected_features().fast_pext;
+    });
 }
 
 }  // namespace
@@ -170,18 +218,40 @@ void initialize_sliding_attack_tables() {
 
 Bitboard bishop_attacks(int square, Bitboard occupancy) {
     ensure_tables();
-    Bitboard occ = occupancy & bishop_masks[static_cast<std::size_t>(square)];
-    int count = bishop_relevant_count[static_cast<std::size_t>(square)];
-    std::uint32_t index = occupancy_to_index(occ, bishop_relevant_squares[static_cast<std::size_t>(square)], count);
-    return bishop_attacks_table[static_cast<std::size_t>(square)][index];
+    const auto index_square = static_cast<std::size_t>(square);
+#if defined(SIRIO_SLIDER_PEXT_ALWAYS)
+    return bishop_attacks_table[index_square][_pext_u64(occupancy, bishop_relevant.masks[index_square])];
+#else
+#if defined(SIRIO_SLIDER_PEXT)
+    if (slider_uses_pext) {
+        return bishop_attacks_pext(index_square, occupancy);
+    }
+#endif
+    return bishop_attacks_table[index_square][software_slider_index(bishop_relevant, index_square, occupancy)];
+#endif
 }
 
 Bitboard rook_attacks(int square, Bitboard occupancy) {
     ensure_tables();
-    Bitboard occ = occupancy & rook_masks[static_cast<std::size_t>(square)];
-    int count = rook_relevant_count[static_cast<std::size_t>(square)];
-    std::uint32_t index = occupancy_to_index(occ, rook_relevant_squares[static_cast<std::size_t>(square)], count);
-    return rook_attacks_table[static_cast<std::size_t>(square)][index];
+    const auto index_square = static_cast<std::size_t>(square);
+#if defined(SIRIO_SLIDER_PEXT_ALWAYS)
+    return rook_attacks_table[index_square][_pext_u64(occupancy, rook_relevant.masks[index_square])];
+#else
+#if defined(SIRIO_SLIDER_PEXT)
+    if (slider_uses_pext) {
+        return rook_attacks_pext(index_square, occupancy);
+    }
+#endif
+    return rook_attacks_table[index_square][software_slider_index(rook_relevant, index_square, occupancy)];
+#endif
+}
+
+Bitboard squares_between(int from, int to) {
+    return line_tables.between[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)];
+}
+
+Bitboard line_through(int first, int second) {
+    return line_tables.line[static_cast<std::size_t>(first)][static_cast<std::size_t>(second)];
 }
 
 }  // namespace sirio
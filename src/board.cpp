@@ -3,12 +3,13 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <charconv>
 #include <cstdlib>
 #include <optional>
-#include <random>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 
 #include "sirio/move.hpp"
 #include "sirio/evaluation.hpp"
@@ -30,25 +31,71 @@ struct ZobristTables {
     std::uint64_t side_to_move = 0;
 };
 
-const ZobristTables &zobrist_tables() {
-    static const ZobristTables tables = [] {
-        ZobristTables result{};
-        std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
-        for (auto &value : result.pieces) {
-            value = rng();
+// MT19937-64 evaluated at compile time. It reproduces std::mt19937_64 seeded with the same value,
+// so hashes stay identical to the ones stored in persisted tables, books and analysis files.
+class ConstexprMersenneTwister64 {
+public:
+    explicit constexpr ConstexprMersenneTwister64(std::uint64_t seed) {
+        state_[0] = seed;
+        for (std::size_t i = 1; i < kStateSize; ++i) {
+            state_[i] = 6364136223846793005ULL * (state_[i - 1] ^ (state_[i - 1] >> 62)) + i;
         }
-        for (auto &value : result.castling) {
-            value = rng();
+    }
+
+    constexpr std::uint64_t operator()() {
+        if (index_ >= kStateSize) {
+            twist();
         }
-        for (auto &value : result.en_passant) {
-            value = rng();
+        std::uint64_t value = state_[index_++];
+        value ^= (value >> 29) & 0x5555555555555555ULL;
+        value ^= (value << 17) & 0x71D67FFFEDA60000ULL;
+        value ^= (value << 37) & 0xFFF7EEE000000000ULL;
+        value ^= value >> 43;
+        return value;
+    }
+
+private:
+    static constexpr std::size_t kStateSize = 312;
+    static constexpr std::size_t kShift = 156;
+    static constexpr std::uint64_t kUpperMask = 0xFFFFFFFF80000000ULL;
+    static constexpr std::uint64_t kLowerMask = 0x000000007FFFFFFFULL;
+
+    constexpr void twist() {
+        for (std::size_t i = 0; i < kStateSize; ++i) {
+            std::uint64_t bits = (state_[i] & kUpperMask) | (state_[(i + 1) % kStateSize] & kLowerMask);
+            std::uint64_t next = state_[(i + kShift) % kStateSize] ^ (bits >> 1);
+            if (bits & 1ULL) {
+                next ^= 0xB5026F5AA96619E9ULL;
+            }
+            state_[i] = next;
         }
-        result.side_to_move = rng();
-        return result;
-    }();
-    return tables;
+        index_ = 0;
+    }
+
+    std::array<std::uint64_t, kStateSize> state_{};
+    std::size_t index_ = kStateSize;
+};
+
+constexpr ZobristTables make_zobrist_tables() {
+    ZobristTables result{};
+    ConstexprMersenneTwister64 rng(0x9E3779B97F4A7C15ULL);
+    for (auto &value : result.pieces) {
+        value = rng();
+    }
+    for (auto &value : result.castling) {
+        value = rng();
+    }
+    for (auto &value : result.en_passant) {
+        value = rng();
+    }
+    result.side_to_move = rng();
+    return result;
 }
 
+constexpr ZobristTables kZobristTables = make_zobrist_tables();
+
+constexpr const ZobristTables &zobrist_tables() { return kZobristTables; }
+
 std::uint64_t piece_hash(Color color, PieceType type, int square) {
     const auto &tables = zobrist_tables();
     const std::size_t color_index = color == Color::White ? 0U : 1U;
@@ -112,6 +159,41 @@ bool en_passant_capture_possible(const Board &board, int ep_square, Color captur
 
     return false;
 }
+// Piece letters in FEN order: white pawn to king, then black.
+constexpr std::string_view kFenPieceSymbols = "PNBRQKpnbrqk";
+
+// Index into kFenPieceSymbols by character, -1 for anything else.
+constexpr std::array<std::int8_t, 256> kFenPieceIndex = [] {
+    std::array<std::int8_t, 256> table{};
+    table.fill(-1);
+    for (std::size_t index = 0; index < kFenPieceSymbols.size(); ++index) {
+        table[static_cast<unsigned char>(kFenPieceSymbols[index])] = static_cast<std::int8_t>(index);
+    }
+    return table;
+}();
+
+bool is_fen_space(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// Splits the next whitespace-separated field off the front of `text`; empty when none is left.
+std::string_view next_fen_field(std::string_view &text) {
+    std::size_t start = 0;
+    while (start < text.size() && is_fen_space(text[start])) {
+        ++start;
+    }
+    std::size_t end = start;
+    while (end < text.size() && !is_fen_space(text[end])) {
+        ++end;
+    }
+    const std::string_view field = text.substr(start, end - start);
+    text.remove_prefix(end);
+    return field;
+}
+
+bool parse_fen_counter(std::string_view text, int &value) {
+    const char *end = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    return ec == std::errc{} && ptr == end;
+}
 }  // namespace
 
 Color opposite(Color color) {
@@ -238,6 +320,9 @@ int Board::king_square(Color color) const {
 }
 
 bool Board::in_check(Color color) const {
+    if (color == state_.side_to_move) {
+        return state_.checkers != 0;
+    }
     const int king_sq = king_square(color);
     if (king_sq < 0) {
         return false;
@@ -245,43 +330,171 @@ bool Board::in_check(Color color) const {
     return is_square_attacked(king_sq, opposite(color));
 }
 
-PieceType Board::piece_type_from_char(char piece) {
-    switch (piece) {
-        case 'p':
-            return PieceType::Pawn;
-        case 'n':
-            return PieceType::Knight;
-        case 'b':
-            return PieceType::Bishop;
-        case 'r':
-            return PieceType::Rook;
-        case 'q':
-            return PieceType::Queen;
-        case 'k':
-            return PieceType::King;
-        default:
-            throw std::invalid_argument("Unknown piece type");
-    }
-}
-
-char Board::piece_to_char(Color color, PieceType type) {
-    switch (type) {
-        case PieceType::Pawn:
-            return color == Color::White ? 'P' : 'p';
-        case PieceType::Knight:
-            return color == Color::White ? 'N' : 'n';
-        case PieceType::Bishop:
-            return color == Color::White ? 'B' : 'b';
-        case PieceType::Rook:
-            return color == Color::White ? 'R' : 'r';
-        case PieceType::Queen:
-            return color == Color::White ? 'Q' : 'q';
-        case PieceType::King:
-            return color == Color::White ? 'K' : 'k';
-        case PieceType::Count:
-            break;
-    }
-    throw std::logic_error("Invalid piece type for conversion");
+Bitboard Board::king_blockers(Color color) const {
+    return state_.king_blockers[color == Color::White ? 0 : 1];
+}
+
+Bitboard Board::pinned_pieces(Color color) const { return king_blockers(color) & occupancy(color); }
+
+Bitboard Board::compute_checkers() const {
+    const Color us = state_.side_to_move;
+    const int king_sq = king_square(us);
+    if (king_sq < 0) {
+        return 0;
+    }
+    return attackers_to(king_sq, occupancy_) & occupancy(opposite(us));
+}
+
+Bitboard Board::compute_king_blockers(Color color) const {
+    const int king_sq = king_square(color);
+    if (king_sq < 0) {
+        return 0;
+    }
+    const Color them = opposite(color);
+    const Bitboard queens = pieces(them, PieceType::Queen);
+    Bitboard snipers = (rook_attacks(king_sq, 0) & (pieces(them, PieceType::Rook) | queens)) |
+                       (bishop_attacks(king_sq, 0) & (pieces(them, PieceType::Bishop) | queens));
+    Bitboard blockers = 0;
+    while (snipers) {
+        const int sniper = pop_lsb(snipers);
+        const Bitboard between = squares_between(king_sq, sniper) & occupancy_;
+        if (between != 0 && (between & (between - 1)) == 0) {
+            blockers |= between;
+        }
+    }
+    return blockers;
+}
+
+void Board::update_check_state() {
+    state_.checkers = compute_checkers();
+    state_.king_blockers[0] = compute_king_blockers(Color::White);
+    state_.king_blockers[1] = compute_king_blockers(Color::Black);
+
+    state_.check_squares.fill(0);
+    const Color us = state_.side_to_move;
+    const int enemy_king = king_square(opposite(us));
+    if (enemy_king < 0) {
+        return;
+    }
+    const Bitboard king_mask = one_bit(enemy_king);
+    auto &squares = state_.check_squares;
+    squares[static_cast<std::size_t>(PieceType::Pawn)] =
+        us == Color::White ? pawn_attacks_black(king_mask) : pawn_attacks_white(king_mask);
+    squares[static_cast<std::size_t>(PieceType::Knight)] = knight_attacks(enemy_king);
+    squares[static_cast<std::size_t>(PieceType::Bishop)] = bishop_attacks(enemy_king, occupancy_);
+    squares[static_cast<std::size_t>(PieceType::Rook)] = rook_attacks(enemy_king, occupancy_);
+    squares[static_cast<std::size_t>(PieceType::Queen)] =
+        squares[static_cast<std::size_t>(PieceType::Bishop)] | squares[static_cast<std::size_t>(PieceType::Rook)];
+}
+
+bool Board::gives_check(const Move &move) const {
+    const Color us = state_.side_to_move;
+    const Color them = opposite(us);
+    const int enemy_king = king_square(them);
+    if (enemy_king < 0) {
+        return false;
+    }
+    const Bitboard from_mask = one_bit(move.from);
+    const Bitboard to_mask = one_bit(move.to);
+
+    if (check_squares(move.piece) & to_mask) {
+        return true;
+    }
+
+    if ((king_blockers(them) & from_mask) && (line_through(enemy_king, move.from) & to_mask) == 0) {
+        return true;
+    }
+
+    if (move.promotion.has_value()) {
+        const Bitboard occupied = occupancy_ ^ from_mask;
+        switch (*move.promotion) {
+            case PieceType::Knight:
+                return (knight_attacks(move.to) & one_bit(enemy_king)) != 0;
+            case PieceType::Bishop:
+                return (bishop_attacks(move.to, occupied) & one_bit(enemy_king)) != 0;
+            case PieceType::Rook:
+                return (rook_attacks(move.to, occupied) & one_bit(enemy_king)) != 0;
+            case PieceType::Queen:
+                return (queen_attacks(move.to, occupied) & one_bit(enemy_king)) != 0;
+            default:
+                return false;
+        }
+    }
+
+    if (move.is_en_passant) {
+        const int capture_square = us == Color::White ? move.to - 8 : move.to + 8;
+        const Bitboard occupied = (occupancy_ ^ from_mask ^ one_bit(capture_square)) | to_mask;
+        const Bitboard queens = pieces(us, PieceType::Queen);
+        return (rook_attacks(enemy_king, occupied) & (pieces(us, PieceType::Rook) | queens)) != 0 ||
+               (bishop_attacks(enemy_king, occupied) & (pieces(us, PieceType::Bishop) | queens)) != 0;
+    }
+
+    if (move.is_castling) {
+        const bool kingside = move.to > move.from;
+        const int rook_from = kingside ? move.from + 3 : move.from - 4;
+        const int rook_to = kingside ? move.from + 1 : move.from - 1;
+        const Bitboard occupied = (occupancy_ ^ from_mask ^ one_bit(rook_from)) | to_mask | one_bit(rook_to);
+        return (rook_attacks(rook_to, occupied) & one_bit(enemy_king)) != 0;
+    }
+
+    return false;
+}
+
+bool Board::is_legal(const Move &move) const {
+    const Color us = state_.side_to_move;
+    const Color them = opposite(us);
+    const int king_sq = king_square(us);
+    if (king_sq < 0) {
+        return true;
+    }
+    const Bitboard from_mask = one_bit(move.from);
+    const Bitboard to_mask = one_bit(move.to);
+
+    if (move.piece == PieceType::King) {
+        if (move.is_castling) {
+            if (state_.checkers != 0) {
+                return false;
+            }
+            const int step = move.to > move.from ? 1 : -1;
+            for (int square = move.from + step; square != move.to + step; square += step) {
+                if (is_square_attacked(square, them)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return (attackers_to(move.to, occupancy_ ^ from_mask) & occupancy(them)) == 0;
+    }
+
+    if (move.is_en_passant) {
+        const int capture_square = us == Color::White ? move.to - 8 : move.to + 8;
+        const Bitboard capture_mask = one_bit(capture_square);
+        const Bitboard occupied = (occupancy_ ^ from_mask ^ capture_mask) | to_mask;
+        const Bitboard queens = pieces(them, PieceType::Queen);
+        if (rook_attacks(king_sq, occupied) & (pieces(them, PieceType::Rook) | queens)) {
+            return false;
+        }
+        if (bishop_attacks(king_sq, occupied) & (pieces(them, PieceType::Bishop) | queens)) {
+            return false;
+        }
+        return (state_.checkers & ~capture_mask &
+                (pieces(them, PieceType::Knight) | pieces(them, PieceType::Pawn))) == 0;
+    }
+
+    if (state_.checkers != 0) {
+        if ((state_.checkers & (state_.checkers - 1)) != 0) {
+            return false;
+        }
+        const int checker = bit_scan_forward(state_.checkers);
+        if ((to_mask & (squares_between(king_sq, checker) | state_.checkers)) == 0) {
+            return false;
+        }
+    }
+
+    if (pinned_pieces(us) & from_mask) {
+        return (line_through(king_sq, move.from) & to_mask) != 0;
+    }
+    return true;
 }
 
 int Board::square_from_string(std::string_view square) {
@@ -303,68 +516,128 @@ int Board::square_from_string(std::string_view square) {
     return rank_index * 8 + file_index;
 }
 
-std::string Board::square_to_string(int square) {
-    if (square < 0 || square >= 64) {
-        return "-";
-    }
-    std::string result(2, ' ');
-    result[0] = static_cast<char>('a' + file_of(square));
-    result[1] = static_cast<char>('1' + rank_of(square));
-    return result;
-}
-
 const Board::PieceList &Board::piece_list(Color color, PieceType type) const {
     return piece_list_ref(color, type);
 }
 
+std::string_view fen_error_message(FenError error) {
+    switch (error) {
+        case FenError::None:
+            return "No error";
+        case FenError::MissingFields:
+            return "FEN string is missing required fields";
+        case FenError::InvalidPlacement:
+            return "Invalid piece placement in FEN";
+        case FenError::InvalidSideToMove:
+            return "Invalid active color in FEN";
+        case FenError::InvalidCastling:
+            return "Invalid castling rights in FEN";
+        case FenError::InvalidEnPassant:
+            return "Invalid en passant square in FEN";
+        case FenError::InvalidCounters:
+            return "Invalid move counters in FEN";
+    }
+    return "Unknown FEN error";
+}
+
 void Board::set_from_fen(std::string_view fen) {
+    if (const FenError error = parse_fen(fen); error != FenError::None) {
+        throw std::invalid_argument(std::string{fen_error_message(error)});
+    }
+}
+
+FenError Board::parse_fen(std::string_view fen) {
     clear();
-    std::string fen_text{fen};
-    std::istringstream stream{fen_text};
+    const std::string_view placement = next_fen_field(fen);
+    const std::string_view active_color = next_fen_field(fen);
+    const std::string_view castling = next_fen_field(fen);
+    const std::string_view en_passant = next_fen_field(fen);
+    const std::string_view halfmove = next_fen_field(fen);
+    const std::string_view fullmove = next_fen_field(fen);
+    if (fullmove.empty()) {
+        return FenError::MissingFields;
+    }
+
+    FenError error = parse_position_fields(placement, active_color, castling, en_passant);
+    if (error == FenError::None &&
+        (!parse_fen_counter(halfmove, state_.halfmove_clock) ||
+         !parse_fen_counter(fullmove, state_.fullmove_number) || state_.halfmove_clock < 0 ||
+         state_.fullmove_number <= 0)) {
+        error = FenError::InvalidCounters;
+    }
+    if (error != FenError::None) {
+        clear();
+        return error;
+    }
 
-    std::string placement;
-    std::string active_color;
-    std::string castling_rights_text;
-    std::string en_passant_text;
-    std::string halfmove_text;
-    std::string fullmove_text;
+    update_check_state();
+    history_.push(state_);
+    notify_position_initialization(*this);
+    return FenError::None;
+}
+
+FenError Board::parse_epd(std::string_view epd, std::string_view *operations) {
+    clear();
+    const std::string_view placement = next_fen_field(epd);
+    const std::string_view active_color = next_fen_field(epd);
+    const std::string_view castling = next_fen_field(epd);
+    const std::string_view en_passant = next_fen_field(epd);
+    if (en_passant.empty()) {
+        return FenError::MissingFields;
+    }
 
-    if (!(stream >> placement >> active_color >> castling_rights_text >> en_passant_text >> halfmove_text >> fullmove_text)) {
-        throw std::invalid_argument("FEN string is missing required fields");
+    if (const FenError error = parse_position_fields(placement, active_color, castling, en_passant);
+        error != FenError::None) {
+        clear();
+        return error;
+    }
+    if (operations != nullptr) {
+        while (!epd.empty() && is_fen_space(epd.front())) {
+            epd.remove_prefix(1);
+        }
+        while (!epd.empty() && is_fen_space(epd.back())) {
+            epd.remove_suffix(1);
+        }
+        *operations = epd;
     }
 
+    update_check_state();
+    history_.push(state_);
+    notify_position_initialization(*this);
+    return FenError::None;
+}
+
+FenError Board::parse_position_fields(std::string_view placement, std::string_view active_color,
+                                      std::string_view castling, std::string_view en_passant) {
     int rank = 7;
     int file = 0;
     for (char symbol : placement) {
         if (symbol == '/') {
-            if (file != 8) {
-                throw std::invalid_argument("Invalid FEN rank length");
+            if (file != 8 || rank == 0) {
+                return FenError::InvalidPlacement;
             }
             --rank;
             file = 0;
             continue;
         }
 
-        if (std::isdigit(static_cast<unsigned char>(symbol))) {
+        if (symbol >= '1' && symbol <= '8') {
             file += symbol - '0';
             if (file > 8) {
-                throw std::invalid_argument("Too many squares in FEN rank");
+                return FenError::InvalidPlacement;
             }
             continue;
         }
 
-        if (!std::isalpha(static_cast<unsigned char>(symbol))) {
-            throw std::invalid_argument("Unexpected character in FEN placement");
-        }
-
-        if (rank < 0 || file >= 8) {
-            throw std::invalid_argument("FEN placement contains too many squares");
+        const int index = kFenPieceIndex[static_cast<unsigned char>(symbol)];
+        if (index < 0 || file >= 8) {
+            return FenError::InvalidPlacement;
         }
 
-        Color color = std::isupper(static_cast<unsigned char>(symbol)) ? Color::White : Color::Black;
-        PieceType type = piece_type_from_char(static_cast<char>(std::tolower(static_cast<unsigned char>(symbol))));
-        int square = rank * 8 + file;
-        Bitboard mask = one_bit(square);
+        const Color color = index < 6 ? Color::White : Color::Black;
+        const auto type = static_cast<PieceType>(index % 6);
+        const int square = rank * 8 + file;
+        const Bitboard mask = one_bit(square);
         pieces_ref(color, type) |= mask;
         add_to_piece_list(color, type, square);
         occupancy_ |= mask;
@@ -373,7 +646,7 @@ void Board::set_from_fen(std::string_view fen) {
     }
 
     if (rank != 0 || file != 8) {
-        throw std::invalid_argument("FEN placement does not describe all squares");
+        return FenError::InvalidPlacement;
     }
 
     if (active_color == "w") {
@@ -382,125 +655,128 @@ void Board::set_from_fen(std::string_view fen) {
         state_.side_to_move = Color::Black;
         state_.zobrist_hash ^= side_to_move_hash();
     } else {
-        throw std::invalid_argument("Invalid active color in FEN");
+        return FenError::InvalidSideToMove;
     }
 
-    if (castling_rights_text == "-") {
-        state_.castling = {};
-    } else {
-        for (char c : castling_rights_text) {
+    if (castling != "-") {
+        for (char c : castling) {
+            bool *right = nullptr;
+            Color color = Color::White;
+            bool kingside = true;
             switch (c) {
                 case 'K':
-                    if (!state_.castling.white_kingside) {
-                        state_.castling.white_kingside = true;
-                        state_.zobrist_hash ^= castling_hash(Color::White, true);
-                    }
+                    right = &state_.castling.white_kingside;
                     break;
                 case 'Q':
-                    if (!state_.castling.white_queenside) {
-                        state_.castling.white_queenside = true;
-                        state_.zobrist_hash ^= castling_hash(Color::White, false);
-                    }
+                    right = &state_.castling.white_queenside;
+                    kingside = false;
                     break;
                 case 'k':
-                    if (!state_.castling.black_kingside) {
-                        state_.castling.black_kingside = true;
-                        state_.zobrist_hash ^= castling_hash(Color::Black, true);
-                    }
+                    right = &state_.castling.black_kingside;
+                    color = Color::Black;
                     break;
                 case 'q':
-                    if (!state_.castling.black_queenside) {
-                        state_.castling.black_queenside = true;
-                        state_.zobrist_hash ^= castling_hash(Color::Black, false);
-                    }
+                    right = &state_.castling.black_queenside;
+                    color = Color::Black;
+                    kingside = false;
                     break;
                 default:
-                    throw std::invalid_argument("Invalid castling rights in FEN");
+                    return FenError::InvalidCastling;
+            }
+            if (!*right) {
+                *right = true;
+                state_.zobrist_hash ^= castling_hash(color, kingside);
             }
         }
     }
 
-    if (en_passant_text == "-") {
-        state_.en_passant_square = -1;
-    } else {
-        state_.en_passant_square = square_from_string(en_passant_text);
-        if (state_.en_passant_square < 0) {
-            throw std::invalid_argument("Invalid en passant square in FEN");
+    state_.en_passant_square = -1;
+    if (en_passant != "-") {
+        const int square = square_from_string(en_passant);
+        if (square < 0) {
+            return FenError::InvalidEnPassant;
         }
-
-        const bool can_capture =
-            en_passant_capture_possible(*this, state_.en_passant_square, state_.side_to_move);
-        if (can_capture) {
-            state_.zobrist_hash ^= en_passant_hash(file_of(state_.en_passant_square));
-        } else {
-            state_.en_passant_square = -1;
+        // A square no pawn can capture on is dropped, so it neither hashes nor round-trips.
+        if (en_passant_capture_possible(*this, square, state_.side_to_move)) {
+            state_.en_passant_square = square;
+            state_.zobrist_hash ^= en_passant_hash(file_of(square));
         }
     }
+    return FenError::None;
+}
 
-    try {
-        state_.halfmove_clock = std::stoi(halfmove_text);
-        state_.fullmove_number = std::stoi(fullmove_text);
-    } catch (const std::exception &) {
-        throw std::invalid_argument("Invalid move counters in FEN");
-    }
+std::string Board::to_fen() const {
+    char buffer[max_fen_length];
+    const std::size_t length = write_fen(buffer, sizeof(buffer));
+    return std::string{buffer, length};
+}
 
-    if (state_.halfmove_clock < 0 || state_.fullmove_number <= 0) {
-        throw std::invalid_argument("FEN counters have invalid values");
+std::size_t Board::write_fen(char *buffer, std::size_t size) const noexcept {
+    std::array<char, 64> mailbox{};
+    for (std::size_t index = 0; index < kFenPieceSymbols.size(); ++index) {
+        Bitboard bb = pieces_ref(index < 6 ? Color::White : Color::Black,
+                                 static_cast<PieceType>(index % 6));
+        while (bb) {
+            mailbox[static_cast<std::size_t>(pop_lsb(bb))] = kFenPieceSymbols[index];
+        }
     }
 
-    history_.push(state_);
-    notify_position_initialization(*this);
-}
-
-std::string Board::to_fen() const {
-    std::string result;
+    std::array<char, max_fen_length> text{};
+    std::size_t length = 0;
+    auto put = [&](char c) { text[length++] = c; };
     for (int rank = 7; rank >= 0; --rank) {
         int empty_count = 0;
         for (int file = 0; file < 8; ++file) {
-            int square = rank * 8 + file;
-            auto piece = piece_at(square);
-            if (!piece) {
+            const char symbol = mailbox[static_cast<std::size_t>(rank * 8 + file)];
+            if (symbol == 0) {
                 ++empty_count;
                 continue;
             }
             if (empty_count > 0) {
-                result += static_cast<char>('0' + empty_count);
+                put(static_cast<char>('0' + empty_count));
                 empty_count = 0;
             }
-            result += piece_to_char(piece->first, piece->second);
+            put(symbol);
         }
         if (empty_count > 0) {
-            result += static_cast<char>('0' + empty_count);
+            put(static_cast<char>('0' + empty_count));
         }
         if (rank > 0) {
-            result += '/';
+            put('/');
         }
     }
 
-    result += state_.side_to_move == Color::White ? " w " : " b ";
-
-    std::string castling;
-    if (state_.castling.white_kingside) castling += 'K';
-    if (state_.castling.white_queenside) castling += 'Q';
-    if (state_.castling.black_kingside) castling += 'k';
-    if (state_.castling.black_queenside) castling += 'q';
-    if (castling.empty()) {
-        castling = "-";
+    put(' ');
+    put(state_.side_to_move == Color::White ? 'w' : 'b');
+    put(' ');
+    const std::size_t castling_start = length;
+    if (state_.castling.white_kingside) put('K');
+    if (state_.castling.white_queenside) put('Q');
+    if (state_.castling.black_kingside) put('k');
+    if (state_.castling.black_queenside) put('q');
+    if (length == castling_start) {
+        put('-');
     }
-    result += castling;
-    result += ' ';
-    const bool ep_available = state_.en_passant_square >= 0 &&
-                              en_passant_capture_possible(*this, state_.en_passant_square,
-                                                           state_.side_to_move);
-    if (ep_available) {
-        result += square_to_string(state_.en_passant_square);
+    put(' ');
+    if (state_.en_passant_square >= 0 &&
+        en_passant_capture_possible(*this, state_.en_passant_square, state_.side_to_move)) {
+        put(static_cast<char>('a' + file_of(state_.en_passant_square)));
+        put(static_cast<char>('1' + rank_of(state_.en_passant_square)));
     } else {
-        result += "-";
+        put('-');
+    }
+    for (const int counter : {state_.halfmove_clock, state_.fullmove_number}) {
+        put(' ');
+        const auto result = std::to_chars(text.data() + length, text.data() + text.size(), counter);
+        length = static_cast<std::size_t>(result.ptr - text.data());
     }
-    result += ' ' + std::to_string(state_.halfmove_clock);
-    result += ' ' + std::to_string(state_.fullmove_number);
 
-    return result;
+    if (length + 1 > size) {
+        return 0;
+    }
+    std::copy(text.data(), text.data() + length, buffer);
+    buffer[length] = '\0';
+    return length;
 }
 
 bool Board::is_square_attacked(int square, Color by) const {
@@ -543,6 +819,27 @@ bool Board::is_square_attacked(int square, Color by) const {
     return false;
 }
 
+Bitboard Board::attackers_to(int square, Bitboard occupancy) const {
+    const std::size_t pawn = static_cast<std::size_t>(PieceType::Pawn);
+    const std::size_t knight = static_cast<std::size_t>(PieceType::Knight);
+    const std::size_t bishop = static_cast<std::size_t>(PieceType::Bishop);
+    const std::size_t rook = static_cast<std::size_t>(PieceType::Rook);
+    const std::size_t queen = static_cast<std::size_t>(PieceType::Queen);
+    const std::size_t king = static_cast<std::size_t>(PieceType::King);
+    const Bitboard mask = one_bit(square);
+
+    Bitboard attackers = 0;
+    attackers |= pawn_attacks_black(mask) & white_[pawn];
+    attackers |= pawn_attacks_white(mask) & black_[pawn];
+    attackers |= knight_attacks(square) & (white_[knight] | black_[knight]);
+    attackers |= king_attacks(square) & (white_[king] | black_[king]);
+    attackers |= bishop_attacks(square, occupancy) &
+                 (white_[bishop] | black_[bishop] | white_[queen] | black_[queen]);
+    attackers |= rook_attacks(square, occupancy) &
+                 (white_[rook] | black_[rook] | white_[queen] | black_[queen]);
+    return attackers & occupancy;
+}
+
 Board Board::apply_null_move() const {
     Board result = *this;
     const Color us = state_.side_to_move;
@@ -567,6 +864,7 @@ Board Board::apply_null_move() const {
         ++result.state_.fullmove_number;
     }
 
+    result.update_check_state();
     result.history_.push(result.state_);
     notify_move_applied(us, std::nullopt, result);
     return result;
@@ -754,6 +1052,7 @@ void Board::make_move(const Move &move, UndoState &undo) {
         ++state_.fullmove_number;
     }
 
+    update_check_state();
     history_.push(state_);
 }
 
@@ -824,6 +1123,7 @@ void Board::make_null_move(NullUndoState &undo) {
         ++state_.fullmove_number;
     }
 
+    update_check_state();
     history_.push(state_);
 }
 
@@ -0,0 +1,459 @@
+#include "sirio/cpu_features.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIRIO_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#endif
+
+// The ISA-specific kernels are compiled with per-function target attributes, so the rest of the
+// library keeps the baseline instruction set and the binary runs on any x86-64 processor.
+#if defined(__GNUC__) || defined(__clang__)
+#define SIRIO_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIRIO_TARGET(isa)
+#endif
+
+#if defined(SIRIO_X86) && !defined(SIRIO_DISABLE_AVX2)
+#define SIRIO_DISPATCH_AVX2 1
+#endif
+#if defined(SIRIO_X86) && !defined(SIRIO_DISABLE_AVX512)
+#define SIRIO_DISPATCH_AVX512 1
+#endif
+
+namespace sirio::cpu {
+
+namespace {
+
+// ---------------------------------------------------------------------------------------------
+// Scalar kernels: the reference every other level must reproduce.
+
+double dot_weights_scalar(const double *weights, const int *values, std::size_t count) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += weights[i] * static_cast<double>(values[i]);
+    }
+    return sum;
+}
+
+void accumulate_row_scalar(std::int32_t *accumulator, const std::int16_t *weights, std::size_t count,
+                           std::int32_t scale) {
+    for (std::size_t i = 0; i < count; ++i) {
+        accumulator[i] += static_cast<std::int32_t>(weights[i]) * scale;
+    }
+}
+
+std::int64_t relu_dot_scalar(const std::int32_t *accumulator, const std::int16_t *weights,
+                             std::size_t count) {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += static_cast<std::int64_t>(std::max<std::int32_t>(0, accumulator[i])) * weights[i];
+    }
+    return sum;
+}
+
+#if defined(SIRIO_X86)
+// ---------------------------------------------------------------------------------------------
+// SSE4.1
+
+SIRIO_TARGET("sse4.1")
+double dot_weights_sse41(const double *weights, const int *values, std::size_t count) {
+    __m128d accum = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128i pair = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(values + i));
+        accum = _mm_add_pd(accum, _mm_mul_pd(_mm_loadu_pd(weights + i), _mm_cvtepi32_pd(pair)));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, accum);
+    double sum = lanes[0] + lanes[1];
+    for (; i < count; ++i) {
+        sum += weights[i] * static_cast<double>(values[i]);
+    }
+    return sum;
+}
+
+SIRIO_TARGET("sse4.1")
+void accumulate_row_sse41(std::int32_t *accumulator, const std::int16_t *weights, std::size_t count,
+                          std::int32_t scale) {
+    const __m128i factor = _mm_set1_epi32(scale);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i w = _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(weights + i)));
+        auto *dst = reinterpret_cast<__m128i *>(accumulator + i);
+        _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), _mm_mullo_epi32(w, factor)));
+    }
+    accumulate_row_scalar(accumulator + i, weights + i, count - i, scale);
+}
+
+SIRIO_TARGET("sse4.1")
+std::int64_t relu_dot_sse41(const std::int32_t *accumulator, const std::int16_t *weights,
+                            std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i acc =
+            _mm_max_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(accumulator + i)), zero);
+        const __m128i w = _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(weights + i)));
+        // _mm_mul_epi32 multiplies the even lanes into 64-bit products; shift for the odd ones.
+        sum = _mm_add_epi64(sum, _mm_mul_epi32(acc, w));
+        sum = _mm_add_epi64(sum, _mm_mul_epi32(_mm_srli_epi64(acc, 32), _mm_srli_epi64(w, 32)));
+    }
+    alignas(16) std::int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sum);
+    return lanes[0] + lanes[1] + relu_dot_scalar(accumulator + i, weights + i, count - i);
+}
+#endif
+
+#if defined(SIRIO_DISPATCH_AVX2)
+// ---------------------------------------------------------------------------------------------
+// AVX2 + FMA, BMI2 for the slider index
+
+SIRIO_TARGET("avx2,fma")
+double dot_weights_avx2(const double *weights, const int *values, std::size_t count) {
+    __m256d accum = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d converted =
+            _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i)));
+        accum = _mm256_fmadd_pd(_mm256_loadu_pd(weights + i), converted, accum);
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, accum);
+    double sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < count; ++i) {
+        sum += weights[i] * static_cast<double>(values[i]);
+    }
+    return sum;
+}
+
+SIRIO_TARGET("avx2")
+void accumulate_row_avx2(std::int32_t *accumulator, const std::int16_t *weights, std::size_t count,
+                         std::int32_t scale) {
+    const __m256i factor = _mm256_set1_epi32(scale);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i w =
+            _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + i)));
+        auto *dst = reinterpret_cast<__m256i *>(accumulator + i);
+        _mm256_storeu_si256(dst, _mm256_add_epi32(_mm256_loadu_si256(dst), _mm256_mullo_epi32(w, factor)));
+    }
+    accumulate_row_scalar(accumulator + i, weights + i, count - i, scale);
+}
+
+SIRIO_TARGET("avx2")
+std::int64_t relu_dot_avx2(const std::int32_t *accumulator, const std::int16_t *weights,
+                           std::size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sum = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i acc = _mm256_max_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(accumulator + i)), zero);
+        const __m256i w =
+            _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + i)));
+        sum = _mm256_add_epi64(sum, _mm256_mul_epi32(acc, w));
+        sum = _mm256_add_epi64(sum, _mm256_mul_epi32(_mm256_srli_epi64(acc, 32), _mm256_srli_epi64(w, 32)));
+    }
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           relu_dot_scalar(accumulator + i, weights + i, count - i);
+}
+
+#endif
+
+#if defined(SIRIO_DISPATCH_AVX512)
+// ---------------------------------------------------------------------------------------------
+// AVX-512 (foundation subset)
+
+// GCC 12 flags the _mm512_undefined_* placeholders inside the intrinsics headers when they are
+// inlined into target-attributed functions.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+SIRIO_TARGET("avx512f")
+double dot_weights_avx512(const double *weights, const int *values, std::size_t count) {
+    __m512d accum = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d converted =
+            _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i)));
+        accum = _mm512_fmadd_pd(_mm512_loadu_pd(weights + i), converted, accum);
+    }
+    double sum = _mm512_reduce_add_pd(accum);
+    for (; i < count; ++i) {
+        sum += weights[i] * static_cast<double>(values[i]);
+    }
+    return sum;
+}
+
+SIRIO_TARGET("avx512f")
+void accumulate_row_avx512(std::int32_t *accumulator, const std::int16_t *weights, std::size_t count,
+                           std::int32_t scale) {
+    const __m512i factor = _mm512_set1_epi32(scale);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512i w =
+            _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + i)));
+        void *dst = accumulator + i;
+        _mm512_storeu_si512(dst, _mm512_add_epi32(_mm512_loadu_si512(dst), _mm512_mullo_epi32(w, factor)));
+    }
+    accumulate_row_scalar(accumulator + i, weights + i, count - i, scale);
+}
+
+SIRIO_TARGET("avx512f")
+std::int64_t relu_dot_avx512(const std::int32_t *accumulator, const std::int16_t *weights,
+                             std::size_t count) {
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i sum = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512i acc = _mm512_max_epi32(_mm512_loadu_si512(accumulator + i), zero);
+        const __m512i w =
+            _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + i)));
+        sum = _mm512_add_epi64(sum, _mm512_mul_epi32(acc, w));
+        sum = _mm512_add_epi64(sum, _mm512_mul_epi32(_mm512_srli_epi64(acc, 32), _mm512_srli_epi64(w, 32)));
+    }
+    return _mm512_reduce_add_epi64(sum) + relu_dot_scalar(accumulator + i, weights + i, count - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+// ---------------------------------------------------------------------------------------------
+// Detection
+
+#if defined(SIRIO_X86)
+struct CpuidRegisters {
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+};
+
+CpuidRegisters cpuid(unsigned leaf, unsigned subleaf) {
+    CpuidRegisters regs;
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    regs = {static_cast<unsigned>(values[0]), static_cast<unsigned>(values[1]),
+            static_cast<unsigned>(values[2]), static_cast<unsigned>(values[3])};
+#else
+    __cpuid_count(leaf, subleaf, regs.eax, regs.ebx, regs.ecx, regs.edx);
+#endif
+    return regs;
+}
+
+// XCR0: which register files the operating system saves on a context switch.
+std::uint64_t enabled_xsave_state() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax = 0;
+    unsigned edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+bool has_bit(unsigned value, int bit) { return (value >> bit) & 1U; }
+#endif
+
+Features detect_features() {
+    Features features;
+#if defined(SIRIO_X86)
+    const CpuidRegisters vendor = cpuid(0, 0);
+    const unsigned max_leaf = vendor.eax;
+    if (max_leaf < 1) {
+        return features;
+    }
+    const CpuidRegisters leaf1 = cpuid(1, 0);
+    features.sse41 = has_bit(leaf1.ecx, 19);
+    features.popcnt = has_bit(leaf1.ecx, 23);
+    const bool osxsave = has_bit(leaf1.ecx, 27);
+    const std::uint64_t xcr0 = osxsave ? enabled_xsave_state() : 0;
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;
+    const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+    const bool avx = has_bit(leaf1.ecx, 28) && ymm_state;
+    features.fma = avx && has_bit(leaf1.ecx, 12);
+
+    if (max_leaf >= 7) {
+        const CpuidRegisters leaf7 = cpuid(7, 0);
+        features.avx2 = avx && has_bit(leaf7.ebx, 5);
+        features.bmi2 = has_bit(leaf7.ebx, 8);
+        features.avx512 = zmm_state && has_bit(leaf7.ebx, 16);
+        features.avx512_vnni = features.avx512 && has_bit(leaf7.ecx, 11);
+    }
+
+    // "AuthenticAMD" spread over ebx, edx, ecx.
+    const bool amd = vendor.ebx == 0x68747541 && vendor.edx == 0x69746e65 && vendor.ecx == 0x444d4163;
+    unsigned family = (leaf1.eax >> 8) & 0xF;
+    if (family == 0xF) {
+        family += (leaf1.eax >> 20) & 0xFF;
+    }
+    features.fast_pext = features.bmi2 && !(amd && family < 0x19);
+#endif
+    return features;
+}
+
+constexpr Kernels kScalarKernels{SimdLevel::Scalar, dot_weights_scalar, accumulate_row_scalar,
+                                 relu_dot_scalar};
+#if defined(SIRIO_X86)
+constexpr Kernels kSse41Kernels{SimdLevel::Sse41, dot_weights_sse41, accumulate_row_sse41,
+                                relu_dot_sse41};
+#endif
+#if defined(SIRIO_DISPATCH_AVX2)
+constexpr Kernels kAvx2Kernels{SimdLevel::Avx2, dot_weights_avx2, accumulate_row_avx2, relu_dot_avx2};
+#endif
+#if defined(SIRIO_DISPATCH_AVX512)
+constexpr Kernels kAvx512Kernels{SimdLevel::Avx512, dot_weights_avx512, accumulate_row_avx512,
+                                 relu_dot_avx512};
+#endif
+
+const Kernels *select_kernels(SimdLevel level) {
+    switch (level) {
+#if defined(SIRIO_DISPATCH_AVX512)
+    case SimdLevel::Avx512:
+        return &kAvx512Kernels;
+#endif
+#if defined(SIRIO_DISPATCH_AVX2)
+    case SimdLevel::Avx2:
+        return &kAvx2Kernels;
+#endif
+#if defined(SIRIO_X86)
+    case SimdLevel::Sse41:
+        return &kSse41Kernels;
+#endif
+    default:
+        return &kScalarKernels;
+    }
+}
+
+SimdLevel best_level(const Features &features) {
+#if defined(SIRIO_DISPATCH_AVX512)
+    if (features.avx512 && features.avx2 && features.fma) {
+        return SimdLevel::Avx512;
+    }
+#endif
+#if defined(SIRIO_DISPATCH_AVX2)
+    if (features.avx2 && features.fma) {
+        return SimdLevel::Avx2;
+    }
+#endif
+#if defined(SIRIO_X86)
+    if (features.sse41) {
+        return SimdLevel::Sse41;
+    }
+#endif
+    (void)features;
+    return SimdLevel::Scalar;
+}
+
+std::atomic<const Kernels *> g_active_kernels{&kScalarKernels};
+// Dynamic initialisation picks the best kernels before main(); until then the scalar table is used.
+[[maybe_unused]] const bool g_kernels_selected = [] {
+    g_active_kernels.store(select_kernels(detected_simd_level()), std::memory_order_relaxed);
+    return true;
+}();
+
+}  // namespace
+
+const Features &detected_features() {
+    static const Features features = detect_features();
+    return features;
+}
+
+SimdLevel detected_simd_level() {
+    static const SimdLevel level = best_level(detected_features());
+    return level;
+}
+
+SimdLevel active_simd_level() { return kernels().level; }
+
+SimdLevel set_simd_level(SimdLevel requested) {
+    const SimdLevel level = std::min(requested, detected_simd_level());
+    g_active_kernels.store(select_kernels(level), std::memory_order_relaxed);
+    return level;
+}
+
+std::optional<SimdLevel> parse_simd_level(std::string_view text) {
+    std::string value;
+    for (char c : text) {
+        if (c != '-' && c != '.' && c != '_') {
+            value.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+        }
+    }
+    if (value == "auto" || value == "best") {
+        return detected_simd_level();
+    }
+    if (value == "scalar" || value == "none") {
+        return SimdLevel::Scalar;
+    }
+    if (value == "sse41") {
+        return SimdLevel::Sse41;
+    }
+    if (value == "avx2") {
+        return SimdLevel::Avx2;
+    }
+    if (value == "avx512") {
+        return SimdLevel::Avx512;
+    }
+    return std::nullopt;
+}
+
+std::string_view simd_level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Sse41:
+        return "SSE4.1";
+    case SimdLevel::Avx2:
+        return "AVX2";
+    case SimdLevel::Avx512:
+        return "AVX-512";
+    case SimdLevel::Scalar:
+        break;
+    }
+    return "scalar";
+}
+
+std::string describe_simd() {
+    const Features &features = detected_features();
+    std::string text{simd_level_name(active_simd_level())};
+    std::string flags;
+    const auto add = [&](bool present, const char *name) {
+        if (present) {
+            flags += flags.empty() ? "" : " ";
+            flags += name;
+        }
+    };
+    add(features.sse41, "sse4.1");
+    add(features.popcnt, "popcnt");
+    add(features.avx2, "avx2");
+    add(features.fma, "fma");
+    add(features.bmi2, "bmi2");
+    add(features.fast_pext, "pext");
+    add(features.avx512, "avx512");
+    add(features.avx512_vnni, "vnni");
+    if (!flags.empty()) {
+        text += " (" + flags + ")";
+    }
+    return text;
+}
+
+const Kernels &kernels() { return *g_active_kernels.load(std::memory_order_relaxed); }
+
+}  // namespace sirio::cpu
@@ -89,6 +89,10 @@ void WorkQueueWatchdog::update_queue_size(std::size_t size) {
 void WorkQueueWatchdog::shutdown() {
     bool expected = true;
     if (running_.compare_exchange_strong(expected, false)) {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+        }
+        wake_cv_.notify_all();
         if (monitor_thread_.joinable()) {
             monitor_thread_.join();
         }
@@ -98,7 +102,10 @@ void WorkQueueWatchdog::shutdown() {
 void WorkQueueWatchdog::monitor_loop() {
     while (running_.load(std::memory_order_relaxed)) {
         evaluate_registrations();
-        std::this_thread::sleep_for(kMonitorInterval);
+        // Interruptible so that shutdown at process exit does not wait out a full interval.
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait_for(lock, kMonitorInterval,
+                          [this]() { return !running_.load(std::memory_order_relaxed); });
     }
     evaluate_registrations();
 }
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -53,6 +54,8 @@ private:
 
     std::atomic<bool> running_;
     std::atomic<std::size_t> queue_size_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
     std::mutex registrations_mutex_;
     std::vector<std::weak_ptr<WorkQueueRegistration>> registrations_;
     std::thread monitor_thread_;
@@ -1,6 +1,7 @@
 #include "sirio/evaluation.hpp"
 
 #include "sirio/evaluation_route.hpp"
+#include "sirio/evaluation_trace.hpp"
 
 #include <algorithm>
 #include <array>
@@ -16,15 +17,14 @@
 
 #include "sirio/bitboard.hpp"
 #include "sirio/endgame.hpp"
+#include "sirio/evaluation_weights.hpp"
 #include "sirio/nnue/backend.hpp"
 
 namespace sirio {
 
 namespace {
 
-int evaluate_pawn_structure(const Board &board, Color color,
-                            const std::array<int, 8> &friendly_counts,
-                            const std::array<int, 8> &enemy_counts);
+int evaluate_pawn_structure(const Board &board, Color color);
 
 class ClassicalEvaluation : public EvaluationBackend {
 public:
@@ -70,6 +70,7 @@ public:
         }
     }
     int evaluate(const Board &board) override;
+    bool trace(const Board &board, ClassicalEvaluationTrace &trace);
 
     [[nodiscard]] std::unique_ptr<EvaluationBackend> clone() const override {
         return std::make_unique<ClassicalEvaluation>(*this);
@@ -103,100 +104,25 @@ private:
     std::size_t pawn_cache_misses_ = 0;
 };
 
-constexpr std::array<int, 6> piece_values_mg = {100, 325, 340, 510, 980, 0};
-constexpr std::array<int, 6> piece_values_eg = {100, 310, 320, 520, 1000, 0};
+// Material, piece-square tables and term weights come from the header that sirio_tune writes.
+using namespace evaluation_weights;
+
 constexpr std::array<int, 6> piece_phase_values = {0, 1, 1, 2, 4, 0};
 constexpr int max_game_phase = 24;
-constexpr int bishop_pair_bonus_mg = 45;
-constexpr int bishop_pair_bonus_eg = 35;
 constexpr int endgame_material_threshold = 1300;
 constexpr int king_distance_scale = 12;
 constexpr int king_corner_scale = 6;
 constexpr int king_opposition_bonus = 20;
 
-constexpr std::array<int, 64> pawn_table = {
-    0,  0,  0,  0,  0,  0,  0,  0,
-    15, 18, 20, 20, 20, 20, 18, 15,
-    12, 16, 20, 25, 25, 20, 16, 12,
-    8,  12, 18, 30, 30, 18, 12, 8,
-    4,  8,  16, 28, 28, 16, 8,  4,
-    2,  6,  12, 20, 20, 12, 6,  2,
-    0,  0,  4,  8,  8,  4,  0,  0,
-    0,  0,  0,  0,  0,  0,  0,  0};
-
-constexpr std::array<int, 64> knight_table = {
-    -30, -20, -15, -15, -15, -15, -20, -30,
-    -20,  -5,   0,   5,   5,   0,  -5, -20,
-    -15,   0,  10,  18,  18,  10,   0, -15,
-    -15,   5,  18,  24,  24,  18,   5, -15,
-    -15,   5,  18,  24,  24,  18,   5, -15,
-    -15,   0,  12,  18,  18,  12,   0, -15,
-    -20,  -5,   0,   6,   6,   0,  -5, -20,
-    -30, -20, -15, -15, -15, -15, -20, -30};
-
-constexpr std::array<int, 64> bishop_table = {
-    -20, -10, -10, -10, -10, -10, -10, -20,
-    -10, 0,   0,   0,   0,   0,   0,   -10,
-    -10, 0,   5,   10,  10,  5,   0,   -10,
-    -10, 5,   5,   10,  10,  5,   5,   -10,
-    -10, 0,   10,  10,  10,  10,  0,   -10,
-    -10, 10,  10,  10,  10,  10,  10,  -10,
-    -10, 5,   0,   0,   0,   0,   5,   -10,
-    -20, -10, -10, -10, -10, -10, -10, -20};
-
-constexpr std::array<int, 64> rook_table = {
-    0, 0, 0, 0, 0, 0, 0, 0,
-    5, 10, 10, 10, 10, 10, 10, 5,
-    -5, 0, 0, 0, 0, 0, 0, -5,
-    -5, 0, 0, 0, 0, 0, 0, -5,
-    -5, 0, 0, 0, 0, 0, 0, -5,
-    -5, 0, 0, 0, 0, 0, 0, -5,
-    -5, 0, 0, 0, 0, 0, 0, -5,
-    0, 0, 0, 5, 5, 0, 0, 0};
-
-constexpr std::array<int, 64> queen_table = {
-    -20, -10, -10, -5, -5, -10, -10, -20,
-    -10, 0,   0,   0,  0,  0,  0,  -10,
-    -10, 0,   5,   5,  5,  5,  0,  -10,
-    -5,  0,   5,   5,  5,  5,  0,  -5,
-    0,   0,   5,   5,  5,  5,  0,  -5,
-    -10, 5,   5,   5,  5,  5,  0,  -10,
-    -10, 0,   5,   0,  0,  0,  0,  -10,
-    -20, -10, -10, -5, -5, -10, -10, -20};
-
-constexpr std::array<int, 64> king_table = {
-    -30, -40, -40, -50, -50, -40, -40, -30,
-    -30, -40, -40, -50, -50, -40, -40, -30,
-    -30, -40, -40, -50, -50, -40, -40, -30,
-    -30, -40, -40, -50, -50, -40, -40, -30,
-    -20, -30, -30, -40, -40, -30, -30, -20,
-    -10, -20, -20, -20, -20, -20, -20, -10,
-    20,  20,  0,   0,   0,   0,   20,  20,
-    20,  30,  10,  0,   0,   10,  30,  20};
-
-constexpr std::array<int, 64> king_table_endgame = {
-    -50, -40, -30, -20, -20, -30, -40, -50,
-    -30, -20, -10, 0,   0,   -10, -20, -30,
-    -30, -10, 20,  30,  30,  20,  -10, -30,
-    -30, -10, 30,  40,  40,  30,  -10, -30,
-    -30, -10, 30,  40,  40,  30,  -10, -30,
-    -30, -10, 20,  30,  30,  20,  -10, -30,
-    -30, -30, 0,   0,   0,   0,   -30, -30,
-    -50, -40, -30, -20, -20, -30, -40, -50};
-
 const std::array<const std::array<int, 64> *, 6> piece_square_tables_mg = {
-    &pawn_table, &knight_table, &bishop_table, &rook_table, &queen_table, &king_table};
+    &pawn_table_mg, &knight_table_mg, &bishop_table_mg,
+    &rook_table_mg, &queen_table_mg,  &king_table_mg};
 
 const std::array<const std::array<int, 64> *, 6> piece_square_tables_eg = {
-    &pawn_table, &knight_table, &bishop_table, &rook_table, &queen_table, &king_table_endgame};
+    &pawn_table_eg, &knight_table_eg, &bishop_table_eg,
+    &rook_table_eg, &queen_table_eg,  &king_table_eg};
 
 constexpr int weight_scale = 100;
-constexpr int pawn_structure_mg_weight = 80;
-constexpr int pawn_structure_eg_weight = 110;
-constexpr int king_safety_mg_weight = 125;
-constexpr int king_safety_eg_weight = 60;
-constexpr int mobility_mg_weight = 90;
-constexpr int mobility_eg_weight = 100;
 constexpr int rook_open_file_bonus_mg = 18;
 constexpr int rook_open_file_bonus_eg = 26;
 constexpr int rook_seventh_rank_bonus_mg = 14;
@@ -213,8 +139,6 @@ constexpr int queen_seventh_rank_bonus_mg = 12;
 constexpr int queen_seventh_rank_bonus_eg = 14;
 constexpr int queen_passed_pawn_bonus_mg = 14;
 constexpr int queen_passed_pawn_bonus_eg = 20;
-constexpr int minor_piece_mg_weight = 95;
-constexpr int minor_piece_eg_weight = 105;
 
 constexpr std::array<int, 8> king_attackers_table = {0, 8, 18, 32, 50, 72, 98, 128};
 
@@ -304,69 +228,91 @@ struct MobilityScore {
     }
 };
 
+// Whole-board pawn set operations. Every pawn structure term below is a fixed sequence of shifts,
+// fills and popcounts, independent of how many pawns are on the board.
+constexpr Bitboard shift_east(Bitboard bb) { return (bb & not_file_h_mask) << 1; }
+constexpr Bitboard shift_west(Bitboard bb) { return (bb & not_file_a_mask) >> 1; }
+constexpr Bitboard adjacent_files(Bitboard bb) { return shift_east(bb) | shift_west(bb); }
+
+constexpr Bitboard fill_north(Bitboard bb) {
+    bb |= bb << 8;
+    bb |= bb << 16;
+    bb |= bb << 32;
+    return bb;
+}
+
+constexpr Bitboard fill_south(Bitboard bb) {
+    bb |= bb >> 8;
+    bb |= bb >> 16;
+    bb |= bb >> 32;
+    return bb;
+}
+
+constexpr Bitboard file_fill(Bitboard bb) { return fill_north(bb) | fill_south(bb); }
+
+template <Color Us>
+constexpr Bitboard shift_forward(Bitboard bb) {
+    return Us == Color::White ? bb << 8 : bb >> 8;
+}
+
+template <Color Us>
+constexpr Bitboard shift_backward(Bitboard bb) {
+    return Us == Color::White ? bb >> 8 : bb << 8;
+}
+
+// The squares themselves and every square ahead of (behind) them on their files.
+template <Color Us>
+constexpr Bitboard fill_forward(Bitboard bb) {
+    return Us == Color::White ? fill_north(bb) : fill_south(bb);
+}
+
+template <Color Us>
+constexpr Bitboard fill_backward(Bitboard bb) {
+    return Us == Color::White ? fill_south(bb) : fill_north(bb);
+}
+
+template <Color Us>
+Bitboard pawn_attacks_of(Bitboard pawns) {
+    return Us == Color::White ? pawn_attacks_white(pawns) : pawn_attacks_black(pawns);
+}
+
+// Sum of the relative ranks (0 = own back rank) of the squares in `bb`, from the three rank bits.
+template <Color Us>
+int relative_rank_sum(Bitboard bb) {
+    const int sum = std::popcount(bb & 0xFF00FF00FF00FF00ULL) +
+                    2 * std::popcount(bb & 0xFFFF0000FFFF0000ULL) +
+                    4 * std::popcount(bb & 0xFFFFFFFF00000000ULL);
+    return Us == Color::White ? sum : 7 * std::popcount(bb) - sum;
+}
+
+// Pawns with no enemy pawn ahead of them on their own or an adjacent file.
+template <Color Us>
+Bitboard passed_pawn_set(Bitboard pawns, Bitboard enemy_pawns) {
+    const Bitboard enemy_spans = enemy_pawns | adjacent_files(enemy_pawns);
+    return pawns & ~fill_backward<Us>(shift_backward<Us>(enemy_spans));
+}
+
 Bitboard squares_in_front(int square, Color color) {
-    Bitboard mask = 0;
-    int file = file_of(square);
-    int rank = rank_of(square);
-    if (color == Color::White) {
-        for (int r = rank + 1; r < 8; ++r) {
-            mask |= one_bit(r * 8 + file);
-        }
-    } else {
-        for (int r = rank - 1; r >= 0; --r) {
-            mask |= one_bit(r * 8 + file);
-        }
-    }
-    return mask;
+    const Bitboard pawn = one_bit(square);
+    return color == Color::White ? fill_forward<Color::White>(shift_forward<Color::White>(pawn))
+                                 : fill_forward<Color::Black>(shift_forward<Color::Black>(pawn));
 }
 
 Bitboard compute_passed_pawns(const Board &board, Color color) {
-    Bitboard pawns = board.pieces(color, PieceType::Pawn);
-    Bitboard enemy_pawns = board.pieces(opposite(color), PieceType::Pawn);
-    Bitboard passed = 0;
-    while (pawns) {
-        int sq = pop_lsb(pawns);
-        int file = file_of(sq);
-        int rank = rank_of(sq);
-        bool is_passed = true;
-        for (int adj = std::max(0, file - 1); adj <= std::min(7, file + 1); ++adj) {
-            if (!is_passed) {
-                break;
-            }
-            if ((enemy_pawns & file_masks[static_cast<std::size_t>(adj)]) == 0) {
-                continue;
-            }
-            if (color == Color::White) {
-                for (int r = rank + 1; r < 8; ++r) {
-                    if (enemy_pawns & one_bit(r * 8 + adj)) {
-                        is_passed = false;
-                        break;
-                    }
-                }
-            } else {
-                for (int r = rank - 1; r >= 0; --r) {
-                    if (enemy_pawns & one_bit(r * 8 + adj)) {
-                        is_passed = false;
-                        break;
-                    }
-                }
-            }
-        }
-        if (is_passed) {
-            passed |= one_bit(sq);
-        }
-    }
-    return passed;
+    const Bitboard pawns = board.pieces(color, PieceType::Pawn);
+    const Bitboard enemy_pawns = board.pieces(opposite(color), PieceType::Pawn);
+    return color == Color::White ? passed_pawn_set<Color::White>(pawns, enemy_pawns)
+                                 : passed_pawn_set<Color::Black>(pawns, enemy_pawns);
 }
 
 int mirror_square(int square) { return square ^ 56; }
 
 std::array<int, 8> pawn_file_counts(const Board &board, Color color) {
     std::array<int, 8> counts{};
-    Bitboard pawns = board.pieces(color, PieceType::Pawn);
-    while (pawns) {
-        int sq = pop_lsb(pawns);
-        ++counts[file_of(sq)];
+    const Bitboard pawns = board.pieces(color, PieceType::Pawn);
+    for (int file = 0; file < 8; ++file) {
+        counts[static_cast<std::size_t>(file)] =
+            std::popcount(pawns & file_masks[static_cast<std::size_t>(file)]);
     }
     return counts;
 }
@@ -403,10 +349,8 @@ const ClassicalEvaluation::PawnStructureData &ClassicalEvaluation::ensure_pawn_d
     data.black_pawns = black_pawns;
     data.white_counts = pawn_file_counts(board, Color::White);
     data.black_counts = pawn_file_counts(board, Color::Black);
-    data.white_score =
-        evaluate_pawn_structure(board, Color::White, data.white_counts, data.black_counts);
-    data.black_score =
-        evaluate_pawn_structure(board, Color::Black, data.black_counts, data.white_counts);
+    data.white_score = evaluate_pawn_structure(board, Color::White);
+    data.black_score = evaluate_pawn_structure(board, Color::Black);
 
     auto [new_it, inserted] = pawn_cache_.emplace(key, data);
     if (!inserted) {
@@ -425,191 +369,57 @@ const ClassicalEvaluation::PawnStructureData &ClassicalEvaluation::ensure_pawn_d
     return ensure_pawn_data(board, white_pawns, black_pawns, key);
 }
 
-int evaluate_pawn_structure(const Board &board, Color color,
-                            const std::array<int, 8> &friendly_counts,
-                            const std::array<int, 8> &enemy_counts) {
-    int score = 0;
-    for (int file = 0; file < 8; ++file) {
-        if (friendly_counts[file] > 1) {
-            score -= 12 * (friendly_counts[file] - 1);
-        }
-    }
+template <Color Us>
+int evaluate_pawn_structure_for(const Board &board) {
+    constexpr Color Them = Us == Color::White ? Color::Black : Color::White;
+    constexpr Bitboard last_rank = Us == Color::White ? rank_8_mask : rank_1_mask;
 
-    Bitboard friendly_pawns = board.pieces(color, PieceType::Pawn);
-    Bitboard pawns = friendly_pawns;
-    Bitboard enemy_pawns = board.pieces(opposite(color), PieceType::Pawn);
-    Bitboard enemy_pawn_attacks =
-        color == Color::White ? pawn_attacks_black(enemy_pawns) : pawn_attacks_white(enemy_pawns);
-    Bitboard occupancy = board.occupancy();
-    Bitboard bishops = board.pieces(color, PieceType::Bishop);
-    bool has_light_bishop = (bishops & light_square_mask) != 0;
-    bool has_dark_bishop = (bishops & dark_square_mask) != 0;
-
-    auto is_passed_pawn = [&](int pawn_sq) {
-        int pawn_file = file_of(pawn_sq);
-        int pawn_rank = rank_of(pawn_sq);
-        for (int adj = std::max(0, pawn_file - 1); adj <= std::min(7, pawn_file + 1); ++adj) {
-            Bitboard mask = 0;
-            if (color == Color::White) {
-                for (int r = pawn_rank + 1; r < 8; ++r) {
-                    mask |= one_bit(r * 8 + adj);
-                }
-            } else {
-                for (int r = pawn_rank - 1; r >= 0; --r) {
-                    mask |= one_bit(r * 8 + adj);
-                }
-            }
-            if (enemy_pawns & mask) {
-                return false;
-            }
-        }
-        return true;
-    };
-
-    while (pawns) {
-        int sq = pop_lsb(pawns);
-        int file = file_of(sq);
-        int rank = rank_of(sq);
-
-        bool isolated = true;
-        if (file > 0 && friendly_counts[file - 1] > 0) {
-            isolated = false;
-        }
-        if (file < 7 && friendly_counts[file + 1] > 0) {
-            isolated = false;
-        }
-        if (isolated) {
-            score -= 15;
-        }
-
-        Bitboard advance_mask = 0;
-        if (color == Color::White) {
-            for (int r = rank + 1; r < 8; ++r) {
-                advance_mask |= one_bit(r * 8 + file);
-            }
-        } else {
-            for (int r = rank - 1; r >= 0; --r) {
-                advance_mask |= one_bit(r * 8 + file);
-            }
-        }
-
-        Bitboard lateral_cover_mask = 0;
-        if (file > 0) {
-            if (color == Color::White) {
-                for (int r = rank; r < 8; ++r) {
-                    lateral_cover_mask |= one_bit(r * 8 + (file - 1));
-                }
-            } else {
-                for (int r = rank; r >= 0; --r) {
-                    lateral_cover_mask |= one_bit(r * 8 + (file - 1));
-                }
-            }
-        }
-        if (file < 7) {
-            if (color == Color::White) {
-                for (int r = rank; r < 8; ++r) {
-                    lateral_cover_mask |= one_bit(r * 8 + (file + 1));
-                }
-            } else {
-                for (int r = rank; r >= 0; --r) {
-                    lateral_cover_mask |= one_bit(r * 8 + (file + 1));
-                }
-            }
-        }
-
-        int forward_sq = -1;
-        Bitboard forward_bit = 0;
-        if (color == Color::White && rank < 7) {
-            forward_sq = sq + 8;
-            forward_bit = one_bit(forward_sq);
-        } else if (color == Color::Black && rank > 0) {
-            forward_sq = sq - 8;
-            forward_bit = one_bit(forward_sq);
-        }
-
-        bool enemy_controls_forward = (forward_bit != 0) && (enemy_pawn_attacks & forward_bit);
-        bool enemy_blocking_forward = false;
-        if ((forward_bit != 0) && (occupancy & forward_bit)) {
-            auto piece = board.piece_at(forward_sq);
-            enemy_blocking_forward = piece && piece->first != color;
-        }
+    const Bitboard pawns = board.pieces(Us, PieceType::Pawn);
+    const Bitboard enemy_pawns = board.pieces(Them, PieceType::Pawn);
+    const int pawn_count = std::popcount(pawns);
+    int score = 0;
 
-        int relative_rank = color == Color::White ? rank : (7 - rank);
-        bool has_lateral_support = (friendly_pawns & lateral_cover_mask) != 0;
-        if (!has_lateral_support && forward_bit != 0 && !(friendly_pawns & advance_mask) &&
-            (enemy_controls_forward || enemy_blocking_forward)) {
-            score -= backward_pawn_penalty + relative_rank * backward_pawn_rank_scale;
-        }
+    const Bitboard files = file_fill(pawns);
+    score -= 12 * (pawn_count - std::popcount(files & rank_1_mask));
 
-        bool passed = true;
-        for (int adj = std::max(0, file - 1); adj <= std::min(7, file + 1); ++adj) {
-            if (enemy_counts[adj] == 0) {
-                continue;
-            }
-            Bitboard mask = 0;
-            if (color == Color::White) {
-                for (int r = rank + 1; r < 8; ++r) {
-                    mask |= one_bit(r * 8 + adj);
-                }
-            } else {
-                for (int r = rank - 1; r >= 0; --r) {
-                    mask |= one_bit(r * 8 + adj);
-                }
-            }
-            if (enemy_pawns & mask) {
-                passed = false;
-                break;
-            }
-        }
+    const Bitboard isolated = pawns & ~adjacent_files(files);
+    score -= 15 * std::popcount(isolated);
 
-        if (passed) {
-            int base_bonus = 28 + relative_rank * 12;
-            bool connected_passed = false;
-            Bitboard connected_candidates = friendly_pawns & lateral_cover_mask;
-            Bitboard tmp_candidates = connected_candidates;
-            while (tmp_candidates) {
-                int other_sq = pop_lsb(tmp_candidates);
-                if (is_passed_pawn(other_sq)) {
-                    connected_passed = true;
-                    break;
-                }
-            }
+    // Backward: no friendly pawn level with or ahead of it on an adjacent file, none ahead on its
+    // own file, and the stop square is hit by an enemy pawn or holds an enemy piece.
+    const Bitboard supported = adjacent_files(fill_backward<Us>(pawns));
+    const Bitboard frontmost = pawns & ~fill_backward<Us>(shift_backward<Us>(pawns));
+    const Bitboard stop_denied =
+        shift_backward<Us>(pawn_attacks_of<Them>(enemy_pawns) | board.occupancy(Them));
+    const Bitboard backward = frontmost & ~supported & ~last_rank & stop_denied;
+    score -= backward_pawn_penalty * std::popcount(backward) +
+             backward_pawn_rank_scale * relative_rank_sum<Us>(backward);
 
-            score += base_bonus;
-            if (connected_passed) {
-                score += connected_passed_bonus + relative_rank * connected_passed_scale;
-            }
-        }
+    // Connected passers have a passed pawn level with or ahead of them on an adjacent file.
+    const Bitboard passed = passed_pawn_set<Us>(pawns, enemy_pawns);
+    score += 28 * std::popcount(passed) + 12 * relative_rank_sum<Us>(passed);
+    const Bitboard connected_passed = passed & adjacent_files(fill_backward<Us>(passed));
+    score += connected_passed_bonus * std::popcount(connected_passed) +
+             connected_passed_scale * relative_rank_sum<Us>(connected_passed);
 
-        if (relative_rank == 3 || relative_rank == 4) {
-            bool in_chain = false;
-            if (color == Color::White) {
-                if (file > 0 && rank > 0 && (friendly_pawns & one_bit(sq - 9))) {
-                    in_chain = true;
-                }
-                if (file < 7 && rank > 0 && (friendly_pawns & one_bit(sq - 7))) {
-                    in_chain = true;
-                }
-            } else {
-                if (file > 0 && rank < 7 && (friendly_pawns & one_bit(sq + 7))) {
-                    in_chain = true;
-                }
-                if (file < 7 && rank < 7 && (friendly_pawns & one_bit(sq + 9))) {
-                    in_chain = true;
-                }
-            }
-            if (in_chain) {
-                score += pawn_chain_bonus + relative_rank;
-            }
-        }
+    // Pawn chains: defended pawns on the fourth and fifth ranks (the same masks for both sides).
+    const Bitboard chain = pawns & pawn_attacks_of<Us>(pawns) & (rank_4_mask | rank_5_mask);
+    score += pawn_chain_bonus * std::popcount(chain) + relative_rank_sum<Us>(chain);
 
-        bool is_light_square = ((file + rank) & 1) != 0;
-        if ((is_light_square && has_light_bishop) || (!is_light_square && has_dark_bishop)) {
-            score -= bishop_color_pawn_penalty;
-        }
+    const Bitboard bishops = board.pieces(Us, PieceType::Bishop);
+    if (bishops & light_square_mask) {
+        score -= bishop_color_pawn_penalty * std::popcount(pawns & light_square_mask);
+    }
+    if (bishops & dark_square_mask) {
+        score -= bishop_color_pawn_penalty * std::popcount(pawns & dark_square_mask);
     }
 
-    return color == Color::White ? score : -score;
+    return Us == Color::White ? score : -score;
+}
+
+int evaluate_pawn_structure(const Board &board, Color color) {
+    return color == Color::White ? evaluate_pawn_structure_for<Color::White>(board)
+                                 : evaluate_pawn_structure_for<Color::Black>(board);
 }
 
 MobilityScore evaluate_mobility(const Board &board, Color color) {
@@ -1379,6 +1189,30 @@ constexpr std::array<int, 64> generate_corner_distance_table() {
 constexpr auto king_distance_table = generate_king_distance_table();
 constexpr auto king_corner_distance_table = generate_corner_distance_table();
 
+bool opposite_coloured_bishops(const Board &board) {
+    Bitboard white_bishops = board.pieces(Color::White, PieceType::Bishop);
+    Bitboard black_bishops = board.pieces(Color::Black, PieceType::Bishop);
+    if (std::popcount(white_bishops) != 1 || std::popcount(black_bishops) != 1) {
+        return false;
+    }
+    int white_sq = bit_scan_forward(white_bishops);
+    int black_sq = bit_scan_forward(black_bishops);
+    bool white_light = ((file_of(white_sq) + rank_of(white_sq)) & 1) != 0;
+    bool black_light = ((file_of(black_sq) + rank_of(black_sq)) & 1) != 0;
+    return white_light != black_light;
+}
+
+// Flattened weight layout of classical_weight_groups(): piece values, the six piece-square
+// tables, then the scalar weights.
+constexpr std::size_t trace_piece_values = 0;
+constexpr std::size_t trace_piece_square_tables = trace_piece_values + 6;
+constexpr std::size_t trace_bishop_pair = trace_piece_square_tables + 6 * 64;
+constexpr std::size_t trace_pawn_structure = trace_bishop_pair + 1;
+constexpr std::size_t trace_king_safety = trace_pawn_structure + 1;
+constexpr std::size_t trace_mobility = trace_king_safety + 1;
+constexpr std::size_t trace_minor_pieces = trace_mobility + 1;
+constexpr std::size_t trace_weight_count = trace_minor_pieces + 1;
+
 }  // namespace
 
 int ClassicalEvaluation::evaluate(const Board &board) {
@@ -1527,21 +1361,78 @@ int ClassicalEvaluation::evaluate(const Board &board) {
     }
     int score = max_game_phase != 0 ? combined / max_game_phase : 0;
 
-    Bitboard white_bishops = board.pieces(Color::White, PieceType::Bishop);
-    Bitboard black_bishops = board.pieces(Color::Black, PieceType::Bishop);
-    if (std::popcount(white_bishops) == 1 && std::popcount(black_bishops) == 1) {
-        int white_sq = bit_scan_forward(white_bishops);
-        int black_sq = bit_scan_forward(black_bishops);
-        bool white_light = ((file_of(white_sq) + rank_of(white_sq)) & 1) != 0;
-        bool black_light = ((file_of(black_sq) + rank_of(black_sq)) & 1) != 0;
-        if (white_light != black_light) {
-            score /= 2;
-        }
+    if (opposite_coloured_bishops(board)) {
+        score /= 2;
     }
 
     return score;
 }
 
+bool ClassicalEvaluation::trace(const Board &board, ClassicalEvaluationTrace &trace) {
+    if (evaluate_specialized_endgame(board).has_value()) {
+        return false;
+    }
+
+    std::array<ClassicalTraceTerm, trace_weight_count> coefficients{};
+    auto add = [&](std::size_t index, double mg, double eg) {
+        coefficients[index].mg += static_cast<float>(mg);
+        coefficients[index].eg += static_cast<float>(eg);
+    };
+
+    int game_phase = 0;
+    for (int color_index = 0; color_index < 2; ++color_index) {
+        Color color = color_index == 0 ? Color::White : Color::Black;
+        double sign = color == Color::White ? 1.0 : -1.0;
+        for (std::size_t piece_index = 0; piece_index < piece_values_mg.size(); ++piece_index) {
+            Bitboard pieces = board.pieces(color, static_cast<PieceType>(piece_index));
+            while (pieces) {
+                int square = pop_lsb(pieces);
+                int table_index = color == Color::White ? square : mirror_square(square);
+                add(trace_piece_values + piece_index, sign, sign);
+                add(trace_piece_square_tables + piece_index * 64 +
+                        static_cast<std::size_t>(table_index),
+                    sign, sign);
+                game_phase += piece_phase_values[piece_index];
+            }
+        }
+    }
+    double bishop_pairs = (board.has_bishop_pair(Color::White) ? 1.0 : 0.0) -
+                          (board.has_bishop_pair(Color::Black) ? 1.0 : 0.0);
+    add(trace_bishop_pair, bishop_pairs, bishop_pairs);
+
+    const PawnStructureData &pawn_data = ensure_pawn_data(board);
+    double pawn_structure = (pawn_data.white_score + pawn_data.black_score) /
+                            static_cast<double>(weight_scale);
+    add(trace_pawn_structure, pawn_structure, pawn_structure);
+    double king_safety =
+        (evaluate_king_safety(board, Color::White, pawn_data.white_counts) +
+         evaluate_king_safety(board, Color::Black, pawn_data.black_counts)) /
+        static_cast<double>(weight_scale);
+    add(trace_king_safety, king_safety, king_safety);
+    MobilityScore mobility_white = evaluate_mobility(board, Color::White);
+    MobilityScore mobility_black = evaluate_mobility(board, Color::Black);
+    add(trace_mobility,
+        (mobility_white.middlegame + mobility_black.middlegame) / static_cast<double>(weight_scale),
+        (mobility_white.endgame + mobility_black.endgame) / static_cast<double>(weight_scale));
+    double minor_pieces = (evaluate_minor_pieces(board, Color::White) +
+                           evaluate_minor_pieces(board, Color::Black)) /
+                          static_cast<double>(weight_scale);
+    add(trace_minor_pieces, minor_pieces, minor_pieces);
+
+    trace.terms.clear();
+    for (std::size_t index = 0; index < coefficients.size(); ++index) {
+        ClassicalTraceTerm term = coefficients[index];
+        if (term.mg != 0.0F || term.eg != 0.0F) {
+            term.index = static_cast<std::uint16_t>(index);
+            trace.terms.push_back(term);
+        }
+    }
+    trace.phase = std::clamp(game_phase, 0, max_game_phase);
+    trace.scale = opposite_coloured_bishops(board) ? 0.5F : 1.0F;
+    trace.evaluation = evaluate(board);
+    return true;
+}
+
 std::unique_ptr<EvaluationBackend> make_classical_evaluation() {
     return std::make_unique<ClassicalEvaluation>();
 }
@@ -1589,22 +1480,12 @@ std::unique_ptr<EvaluationBackend> make_nnue_evaluation(const std::string &path,
 
 namespace {
 
-struct EvaluationGlobalState {
-    std::mutex mutex;
-    std::unique_ptr<EvaluationBackend> prototype;
-    std::atomic<std::uint64_t> generation{1};
-};
-
-EvaluationGlobalState &global_state() {
-    static EvaluationGlobalState state;
-    return state;
-}
-
 struct EvaluationThreadState {
     std::unique_ptr<EvaluationBackend> backend;
     bool initialized = false;
     int stack_depth = 0;
     bool notifications_enabled = false;
+    const EvaluationPrototype *owner = nullptr;
     std::uint64_t generation = 0;
     nnue::ThreadAccumulator nnue_primary_accumulator;
     nnue::ThreadAccumulator nnue_secondary_accumulator;
@@ -1615,6 +1496,24 @@ EvaluationThreadState &thread_state() {
     return state;
 }
 
+// Backend generations are unique across every prototype of the process, so a prototype created
+// at the address of a destroyed one never matches a clone cached from the old one.
+std::atomic<std::uint64_t> next_backend_generation{1};
+
+std::uint64_t new_backend_generation() {
+    return next_backend_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+EvaluationPrototype *&bound_prototype() {
+    thread_local EvaluationPrototype *prototype = nullptr;
+    return prototype;
+}
+
+EvaluationPrototype &current_prototype() {
+    EvaluationPrototype *bound = bound_prototype();
+    return bound != nullptr ? *bound : default_evaluation_prototype();
+}
+
 void attach_thread_accumulators(EvaluationThreadState &state) {
     if (!state.backend) {
         return;
@@ -1627,35 +1526,16 @@ void attach_thread_accumulators(EvaluationThreadState &state) {
     }
 }
 
-void ensure_global_backend() {
-    EvaluationGlobalState &global = global_state();
-    if (!global.prototype) {
-        std::lock_guard lock(global.mutex);
-        if (!global.prototype) {
-            global.prototype = make_classical_evaluation();
-            global.generation.fetch_add(1, std::memory_order_relaxed);
-        }
-    }
-}
-
 void ensure_thread_backend() {
-    ensure_global_backend();
-    EvaluationGlobalState &global = global_state();
+    EvaluationPrototype &prototype = current_prototype();
     EvaluationThreadState &state = thread_state();
-    std::uint64_t current_generation = global.generation.load(std::memory_order_acquire);
-    if (!state.backend || state.generation != current_generation) {
-        std::lock_guard lock(global.mutex);
-        if (!global.prototype) {
-            global.prototype = make_classical_evaluation();
-            current_generation = global.generation.fetch_add(1, std::memory_order_relaxed) + 1;
-        } else {
-            current_generation = global.generation.load(std::memory_order_relaxed);
-        }
-        state.backend = global.prototype->clone();
+    // Pool threads serve several engines; the generation alone identifies the prototype's backend.
+    if (!state.backend || state.owner != &prototype || state.generation != prototype.generation()) {
+        state.backend = prototype.clone_backend(&state.generation);
+        state.owner = &prototype;
         state.initialized = false;
         state.stack_depth = 0;
         state.notifications_enabled = false;
-        state.generation = current_generation;
         state.nnue_primary_accumulator.reset();
         state.nnue_secondary_accumulator.reset();
         attach_thread_accumulators(state);
@@ -1675,21 +1555,61 @@ void ensure_initialized(const Board &board) {
 
 }  // namespace
 
-void set_evaluation_backend(std::unique_ptr<EvaluationBackend> backend) {
+struct EvaluationPrototype::State {
+    mutable std::mutex mutex;
+    std::unique_ptr<EvaluationBackend> prototype;
+    std::atomic<std::uint64_t> generation{new_backend_generation()};
+};
+
+EvaluationPrototype::EvaluationPrototype() : state_(std::make_unique<State>()) {}
+
+EvaluationPrototype::~EvaluationPrototype() = default;
+
+void EvaluationPrototype::set_backend(std::unique_ptr<EvaluationBackend> backend) {
     if (!backend) {
         backend = make_classical_evaluation();
     }
-    EvaluationGlobalState &global = global_state();
-    {
-        std::lock_guard lock(global.mutex);
-        global.prototype = std::move(backend);
-        global.generation.fetch_add(1, std::memory_order_release);
+    std::lock_guard lock(state_->mutex);
+    state_->prototype = std::move(backend);
+    state_->generation.store(new_backend_generation(), std::memory_order_release);
+}
+
+std::unique_ptr<EvaluationBackend> EvaluationPrototype::clone_backend(std::uint64_t *generation) {
+    std::lock_guard lock(state_->mutex);
+    if (!state_->prototype) {
+        state_->prototype = make_classical_evaluation();
+        state_->generation.store(new_backend_generation(), std::memory_order_relaxed);
+    }
+    if (generation != nullptr) {
+        *generation = state_->generation.load(std::memory_order_relaxed);
     }
+    return state_->prototype->clone();
+}
+
+std::uint64_t EvaluationPrototype::generation() const {
+    return state_->generation.load(std::memory_order_acquire);
+}
+
+EvaluationPrototype &default_evaluation_prototype() {
+    static EvaluationPrototype prototype;
+    return prototype;
+}
+
+ScopedEvaluationPrototype::ScopedEvaluationPrototype(EvaluationPrototype &prototype)
+    : previous_(bound_prototype()) {
+    bound_prototype() = &prototype;
+}
+
+ScopedEvaluationPrototype::~ScopedEvaluationPrototype() { bound_prototype() = previous_; }
+
+void set_evaluation_backend(std::unique_ptr<EvaluationBackend> backend) {
+    current_prototype().set_backend(std::move(backend));
     EvaluationThreadState &state = thread_state();
     state.backend.reset();
     state.initialized = false;
     state.stack_depth = 0;
     state.notifications_enabled = false;
+    state.owner = nullptr;
     state.generation = 0;
     state.nnue_primary_accumulator.reset();
     state.nnue_secondary_accumulator.reset();
@@ -1704,6 +1624,62 @@ EvaluationBackend &active_evaluation_backend() {
     return *thread_state().backend;
 }
 
+const std::vector<ClassicalWeightGroup> &classical_weight_groups() {
+    static const std::vector<ClassicalWeightGroup> groups = {
+        {"piece_values_mg", "piece_values_eg", 6},
+        {"pawn_table_mg", "pawn_table_eg", 64},
+        {"knight_table_mg", "knight_table_eg", 64},
+        {"bishop_table_mg", "bishop_table_eg", 64},
+        {"rook_table_mg", "rook_table_eg", 64},
+        {"queen_table_mg", "queen_table_eg", 64},
+        {"king_table_mg", "king_table_eg", 64},
+        {"bishop_pair_bonus_mg", "bishop_pair_bonus_eg", 0},
+        {"pawn_structure_mg_weight", "pawn_structure_eg_weight", 0},
+        {"king_safety_mg_weight", "king_safety_eg_weight", 0},
+        {"mobility_mg_weight", "mobility_eg_weight", 0},
+        {"minor_piece_mg_weight", "minor_piece_eg_weight", 0}};
+    return groups;
+}
+
+std::vector<ClassicalWeight> classical_weights() {
+    std::vector<ClassicalWeight> weights;
+    weights.reserve(trace_weight_count);
+    for (std::size_t index = 0; index < piece_values_mg.size(); ++index) {
+        weights.push_back({piece_values_mg[index], piece_values_eg[index]});
+    }
+    for (std::size_t piece = 0; piece < piece_square_tables_mg.size(); ++piece) {
+        for (std::size_t square = 0; square < 64; ++square) {
+            weights.push_back(
+                {(*piece_square_tables_mg[piece])[square], (*piece_square_tables_eg[piece])[square]});
+        }
+    }
+    weights.push_back({bishop_pair_bonus_mg, bishop_pair_bonus_eg});
+    weights.push_back({pawn_structure_mg_weight, pawn_structure_eg_weight});
+    weights.push_back({king_safety_mg_weight, king_safety_eg_weight});
+    weights.push_back({mobility_mg_weight, mobility_eg_weight});
+    weights.push_back({minor_piece_mg_weight, minor_piece_eg_weight});
+    return weights;
+}
+
+bool trace_classical_evaluation(const Board &board, ClassicalEvaluationTrace &trace) {
+    // A private backend so the caller's thread-local evaluation state is left alone; initialising
+    // it per position keeps its pawn cache from growing over a whole dataset.
+    thread_local ClassicalEvaluation tracer;
+    tracer.initialize(board);
+    return tracer.trace(board, trace);
+}
+
+double evaluate_classical_trace(const ClassicalEvaluationTrace &trace,
+                                const std::vector<ClassicalWeight> &weights) {
+    double mg = 0.0;
+    double eg = 0.0;
+    for (const ClassicalTraceTerm &term : trace.terms) {
+        mg += term.mg * weights[term.index].mg;
+        eg += term.eg * weights[term.index].eg;
+    }
+    return trace.scale * (mg * trace.phase + eg * (max_game_phase - trace.phase)) / max_game_phase;
+}
+
 std::size_t classical_evaluation_pawn_cache_misses() {
     ensure_thread_backend();
     EvaluationThreadState &state = thread_state();
@@ -68,6 +68,9 @@ bool ExperimentalSirioNNUE2Runtime::load_from_config(const ExperimentalEvaluatio
         return false;
     }
     if (!config.network_path.has_value() || config.network_path->empty()) {
+        if (nnue::embedded_network() != nullptr) {
+            return load_embedded();
+        }
         status_ = ExperimentalSirioNNUE2RuntimeStatus::LoadRejected;
         fallback_reason_ =
             "network load rejected: Experimental SirioNNUE2 route requires network file path";
@@ -92,6 +95,23 @@ bool ExperimentalSirioNNUE2Runtime::load_from_file(const std::string &network_pa
     return true;
 }
 
+bool ExperimentalSirioNNUE2Runtime::load_embedded() {
+    active_ = true;
+    loaded_network_.reset();
+    fallback_reason_.clear();
+    std::string load_error;
+    const nnue::Nnue2NetworkParameters *embedded = nnue::embedded_network(&load_error);
+    if (embedded == nullptr) {
+        status_ = ExperimentalSirioNNUE2RuntimeStatus::LoadRejected;
+        fallback_reason_ = "network load rejected: " + load_error;
+        return false;
+    }
+    // Copies the header and the views only; the weights stay in the executable image.
+    loaded_network_ = *embedded;
+    status_ = ExperimentalSirioNNUE2RuntimeStatus::Loaded;
+    return true;
+}
+
 bool ExperimentalSirioNNUE2Runtime::is_active() const { return active_; }
 bool ExperimentalSirioNNUE2Runtime::is_loaded() const { return loaded_network_.has_value(); }
 ExperimentalSirioNNUE2RuntimeStatus ExperimentalSirioNNUE2Runtime::status() const { return status_; }
@@ -160,6 +180,12 @@ ExperimentalEvaluationState prepare_experimental_evaluation_state_for_tests(
 
     state.load_attempted = true;
     if (!config.network_path.has_value() || config.network_path->empty()) {
+        if (const nnue::Nnue2NetworkParameters *embedded = nnue::embedded_network()) {
+            state.load_status = ExperimentalEvaluationLoadStatus::Loaded;
+            state.load_succeeded = true;
+            state.loaded_network = *embedded;
+            return state;
+        }
         state.load_status = ExperimentalEvaluationLoadStatus::LoadRejected;
         state.fallback_reason =
             "network load rejected: Experimental SirioNNUE2 route requires network file path";
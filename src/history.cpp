@@ -411,6 +411,75 @@ void SearchHistory::record_move_count_pruning_continue() {
 void SearchHistory::reset_move_count_pruning_runtime_observability_for_tests() {
     move_count_pruning_runtime_counters_ = {};
 }
+int SearchHistory::null_move_cutoff_count_for_tests() const {
+    return null_move_pruning_runtime_counters_.cutoff_applied;
+}
+void SearchHistory::record_null_move_cutoff() {
+    ++null_move_pruning_runtime_counters_.cutoff_applied;
+}
+int SearchHistory::null_move_verification_count_for_tests() const {
+    return null_move_pruning_runtime_counters_.verification_applied;
+}
+void SearchHistory::record_null_move_verification() {
+    ++null_move_pruning_runtime_counters_.verification_applied;
+}
+int SearchHistory::null_move_verification_failed_count_for_tests() const {
+    return null_move_pruning_runtime_counters_.verification_failed_applied;
+}
+void SearchHistory::record_null_move_verification_failed() {
+    ++null_move_pruning_runtime_counters_.verification_failed_applied;
+}
+int SearchHistory::null_move_tt_skip_count_for_tests() const {
+    return null_move_pruning_runtime_counters_.tt_skip_applied;
+}
+void SearchHistory::record_null_move_tt_skip() {
+    ++null_move_pruning_runtime_counters_.tt_skip_applied;
+}
+void SearchHistory::reset_null_move_pruning_runtime_observability_for_tests() {
+    null_move_pruning_runtime_counters_ = {};
+}
+int SearchHistory::mate_distance_prune_count_for_tests() const {
+    return mate_distance_runtime_counters_.prune_applied;
+}
+void SearchHistory::record_mate_distance_prune() {
+    ++mate_distance_runtime_counters_.prune_applied;
+}
+void SearchHistory::reset_mate_distance_runtime_observability_for_tests() {
+    mate_distance_runtime_counters_ = {};
+}
+int SearchHistory::zero_window_search_count_for_tests() const {
+    return research_runtime_counters_.zero_window_applied;
+}
+void SearchHistory::record_zero_window_search() {
+    ++research_runtime_counters_.zero_window_applied;
+}
+int SearchHistory::lmr_research_count_for_tests() const {
+    return research_runtime_counters_.lmr_research_applied;
+}
+void SearchHistory::record_lmr_research(std::uint64_t nodes) {
+    ++research_runtime_counters_.lmr_research_applied;
+    research_runtime_counters_.lmr_research_nodes += nodes;
+}
+void SearchHistory::record_lmr_reduction(int plies) {
+    ++research_runtime_counters_.lmr_reduction_applied;
+    research_runtime_counters_.lmr_reduction_plies += static_cast<std::uint64_t>(plies);
+}
+int SearchHistory::pvs_research_count_for_tests() const {
+    return research_runtime_counters_.pvs_research_applied;
+}
+void SearchHistory::record_pvs_research(std::uint64_t nodes) {
+    ++research_runtime_counters_.pvs_research_applied;
+    research_runtime_counters_.pvs_research_nodes += nodes;
+}
+void SearchHistory::reset_research_runtime_observability_for_tests() {
+    research_runtime_counters_ = {};
+}
+int SearchHistory::smp_deferral_count_for_tests() const {
+    return smp_runtime_counters_.deferral_applied;
+}
+void SearchHistory::record_smp_deferral() {
+    ++smp_runtime_counters_.deferral_applied;
+}
 int SearchHistory::probcut_probe_count_for_tests() const {
     return probcut_runtime_counters_.probe_applied;
 }
@@ -631,6 +700,9 @@ void SearchHistory::clear() {
     reset_correction_runtime_observability_for_tests();
     reset_reverse_futility_runtime_observability_for_tests();
     reset_move_count_pruning_runtime_observability_for_tests();
+    reset_null_move_pruning_runtime_observability_for_tests();
+    reset_mate_distance_runtime_observability_for_tests();
+    reset_research_runtime_observability_for_tests();
     reset_probcut_runtime_observability_for_tests();
 }
 
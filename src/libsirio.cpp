@@ -0,0 +1,298 @@
+#include "sirio/libsirio.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "sirio/board.hpp"
+#include "sirio/engine.hpp"
+#include "sirio/evaluation.hpp"
+#include "sirio/move.hpp"
+#include "sirio/search.hpp"
+#include "sirio/search_params.hpp"
+#include "sirio/syzygy.hpp"
+
+struct sirio_engine {
+    std::unique_ptr<sirio::Engine> engine;
+    sirio::Board board;
+    std::string last_error;
+};
+
+namespace {
+
+sirio_status fail(sirio_engine *engine, sirio_status status, std::string message) {
+    if (engine != nullptr) {
+        engine->last_error = std::move(message);
+    }
+    return status;
+}
+
+sirio_status succeed(sirio_engine *engine) {
+    engine->last_error.clear();
+    return SIRIO_OK;
+}
+
+sirio_move encode_move(const sirio::Move &move) {
+    unsigned promotion = 0;
+    if (move.promotion.has_value()) {
+        promotion = static_cast<unsigned>(*move.promotion);
+    }
+    return static_cast<sirio_move>(static_cast<unsigned>(move.from) |
+                                   (static_cast<unsigned>(move.to) << 6) | (promotion << 12));
+}
+
+void fill_search_info(const sirio::SearchResult &result, sirio_search_info &info) {
+    info = sirio_search_info{};
+    info.best_move = result.has_move ? encode_move(result.best_move) : SIRIO_NULL_MOVE;
+    if (sirio::search_params::is_mate_score(result.score)) {
+        int moves = (sirio::search_params::mate_score - std::abs(result.score) + 1) / 2;
+        info.score = result.score < 0 ? -moves : moves;
+        info.is_mate = 1;
+    } else {
+        info.score = result.score;
+    }
+    info.depth = result.depth_reached;
+    info.seldepth = std::max(result.seldepth, result.depth_reached);
+    info.nodes = result.nodes;
+    info.nodes_per_second = result.nodes_per_second;
+    info.time_ms = result.time_ms;
+    info.timed_out = result.timed_out ? 1 : 0;
+    std::size_t length = std::min<std::size_t>(result.principal_variation.size(), SIRIO_MAX_PV_LENGTH);
+    for (std::size_t index = 0; index < length; ++index) {
+        info.pv[index] = encode_move(result.principal_variation[index]);
+    }
+    info.pv_length = static_cast<std::uint32_t>(length);
+}
+
+bool parse_int(std::string_view text, long long &value) {
+    while (!text.empty() && text.front() == ' ') {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && text.back() == ' ') {
+        text.remove_suffix(1);
+    }
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+}  // namespace
+
+extern "C" {
+
+uint32_t sirio_api_version(void) { return SIRIO_API_VERSION; }
+
+sirio_engine *sirio_engine_create(uint32_t hash_mb, int32_t threads) {
+    if (hash_mb == 0 || threads < 1) {
+        return nullptr;
+    }
+    try {
+        auto handle = std::make_unique<sirio_engine>();
+        handle->engine = std::make_unique<sirio::Engine>(hash_mb, threads);
+        handle->engine->set_uci_output(false);
+        return handle.release();
+    } catch (const std::exception &) {
+        return nullptr;
+    }
+}
+
+void sirio_engine_destroy(sirio_engine *engine) { delete engine; }
+
+const char *sirio_engine_last_error(const sirio_engine *engine) {
+    return engine != nullptr ? engine->last_error.c_str() : "";
+}
+
+sirio_status sirio_engine_set_option(sirio_engine *engine, const char *name, const char *value) {
+    if (engine == nullptr || name == nullptr) {
+        return fail(engine, SIRIO_ERROR_INVALID_ARGUMENT, "engine and option name are required");
+    }
+    std::string_view option{name};
+    std::string_view text = value != nullptr ? std::string_view{value} : std::string_view{};
+    try {
+        if (option == "Clear Hash") {
+            engine->engine->clear_hash();
+            return succeed(engine);
+        }
+        if (option == "Hash" || option == "Threads") {
+            long long number = 0;
+            if (!parse_int(text, number) || number < 1) {
+                return fail(engine, SIRIO_ERROR_INVALID_VALUE,
+                            std::string{option} + " expects a positive integer");
+            }
+            if (option == "Hash") {
+                engine->engine->set_hash_size(static_cast<std::size_t>(number));
+            } else {
+                engine->engine->set_threads(static_cast<int>(std::min<long long>(number, 1024)));
+            }
+            return succeed(engine);
+        }
+        if (option == "EvalFile") {
+            if (text.empty() || text == "classical") {
+                engine->engine->evaluation().set_backend(sirio::make_classical_evaluation());
+                return succeed(engine);
+            }
+            std::string error;
+            auto backend = sirio::make_nnue_evaluation(std::string{text}, &error);
+            if (!backend) {
+                return fail(engine, SIRIO_ERROR_LOAD_FAILED,
+                            error.empty() ? "unable to load " + std::string{text} : error);
+            }
+            engine->engine->evaluation().set_backend(std::move(backend));
+            return succeed(engine);
+        }
+        if (option == "SyzygyPath") {
+            sirio::syzygy::set_tablebase_path(std::string{text});
+            return succeed(engine);
+        }
+    } catch (const std::exception &error) {
+        return fail(engine, SIRIO_ERROR_INTERNAL, error.what());
+    }
+    return fail(engine, SIRIO_ERROR_UNKNOWN_OPTION, "unknown option " + std::string{option});
+}
+
+sirio_status sirio_engine_set_position(sirio_engine *engine, const char *fen,
+                                       const char *const *moves, size_t move_count) {
+    if (engine == nullptr || (moves == nullptr && move_count > 0)) {
+        return fail(engine, SIRIO_ERROR_INVALID_ARGUMENT, "engine and moves are required");
+    }
+    sirio::Board board;
+    if (fen != nullptr) {
+        if (const auto error = board.parse_fen(fen); error != sirio::FenError::None) {
+            return fail(engine, SIRIO_ERROR_INVALID_FEN, std::string{sirio::fen_error_message(error)});
+        }
+    }
+    for (std::size_t index = 0; index < move_count; ++index) {
+        if (moves[index] == nullptr || !sirio::apply_uci_move(board, moves[index])) {
+            return fail(engine, SIRIO_ERROR_ILLEGAL_MOVE,
+                        "illegal move at index " + std::to_string(index));
+        }
+    }
+    engine->board = std::move(board);
+    return succeed(engine);
+}
+
+sirio_status sirio_engine_search(sirio_engine *engine, const sirio_search_limits *limits,
+                                 sirio_info_callback callback, void *user_data,
+                                 sirio_search_info *result) {
+    if (engine == nullptr) {
+        return fail(engine, SIRIO_ERROR_INVALID_ARGUMENT, "engine is required");
+    }
+    sirio::SearchLimits search_limits;
+    if (limits != nullptr) {
+        search_limits.max_depth = std::max(0, limits->depth);
+        search_limits.move_time = std::max(0, limits->move_time_ms);
+        search_limits.max_nodes = limits->nodes;
+        search_limits.time_left_white = std::max(0, limits->white_time_ms);
+        search_limits.time_left_black = std::max(0, limits->black_time_ms);
+        search_limits.increment_white = std::max(0, limits->white_increment_ms);
+        search_limits.increment_black = std::max(0, limits->black_increment_ms);
+        search_limits.moves_to_go = std::max(0, limits->moves_to_go);
+    }
+    search_limits.infinite = search_limits.max_depth == 0 && search_limits.move_time == 0 &&
+                             search_limits.max_nodes == 0 && search_limits.time_left_white == 0 &&
+                             search_limits.time_left_black == 0 && search_limits.increment_white == 0 &&
+                             search_limits.increment_black == 0 && search_limits.moves_to_go == 0;
+    const bool white_to_move = engine->board.side_to_move() == sirio::Color::White;
+    const int clock = white_to_move ? search_limits.time_left_white : search_limits.time_left_black;
+    const int increment = white_to_move ? search_limits.increment_white : search_limits.increment_black;
+    if (!search_limits.infinite && search_limits.max_depth == 0 && search_limits.move_time == 0 &&
+        search_limits.max_nodes == 0 && clock == 0 && increment == 0) {
+        return fail(engine, SIRIO_ERROR_INVALID_ARGUMENT,
+                    "clock limits need a time or increment for the side to move");
+    }
+
+    try {
+        if (callback != nullptr) {
+            engine->engine->set_info_callback([callback, user_data](const sirio::SearchResult &update) {
+                sirio_search_info info;
+                fill_search_info(update, info);
+                callback(&info, user_data);
+            });
+        } else {
+            engine->engine->set_info_callback({});
+        }
+        // A stop sent while no search was running (or after the previous one had finished) is
+        // not meant for this search.
+        engine->engine->clear_pending_stop();
+        sirio::SearchResult best = engine->engine->search(engine->board, search_limits);
+        engine->engine->set_info_callback({});
+        if (result != nullptr) {
+            fill_search_info(best, *result);
+        }
+    } catch (const std::exception &error) {
+        engine->engine->set_info_callback({});
+        return fail(engine, SIRIO_ERROR_INTERNAL, error.what());
+    }
+    return succeed(engine);
+}
+
+void sirio_engine_stop(sirio_engine *engine) {
+    if (engine != nullptr) {
+        engine->engine->request_stop();
+    }
+}
+
+sirio_status sirio_engine_evaluate(sirio_engine *engine, const char *const *fens, size_t count,
+                                   int32_t *scores) {
+    if (engine == nullptr || ((fens == nullptr || scores == nullptr) && count > 0)) {
+        return fail(engine, SIRIO_ERROR_INVALID_ARGUMENT, "engine, fens and scores are required");
+    }
+    sirio::ScopedEvaluationPrototype evaluation_scope{engine->engine->evaluation()};
+    std::size_t invalid = 0;
+    std::size_t first_invalid = 0;
+    for (std::size_t index = 0; index < count; ++index) {
+        try {
+            if (fens[index] == nullptr) {
+                throw std::invalid_argument("null FEN");
+            }
+            sirio::Board board{std::string_view{fens[index]}};
+            sirio::initialize_evaluation(board);
+            int eval = sirio::evaluate(board);
+            scores[index] = board.side_to_move() == sirio::Color::White ? eval : -eval;
+        } catch (const std::exception &) {
+            if (invalid++ == 0) {
+                first_invalid = index;
+            }
+            scores[index] = SIRIO_EVAL_INVALID;
+        }
+    }
+    if (invalid > 0) {
+        return fail(engine, SIRIO_ERROR_INVALID_FEN,
+                    std::to_string(invalid) + " invalid FEN(s), first at index " +
+                        std::to_string(first_invalid));
+    }
+    return succeed(engine);
+}
+
+sirio_status sirio_move_to_uci(sirio_move move, char *buffer, size_t buffer_size) {
+    if (buffer == nullptr || buffer_size < 6) {
+        return SIRIO_ERROR_INVALID_ARGUMENT;
+    }
+    if (move == SIRIO_NULL_MOVE) {
+        std::memcpy(buffer, "0000", 5);
+        return SIRIO_OK;
+    }
+    unsigned from = move & 63u;
+    unsigned to = (move >> 6) & 63u;
+    unsigned promotion = (move >> 12) & 7u;
+    if (promotion > 4) {
+        return SIRIO_ERROR_INVALID_ARGUMENT;
+    }
+    std::size_t length = 0;
+    buffer[length++] = static_cast<char>('a' + from % 8);
+    buffer[length++] = static_cast<char>('1' + from / 8);
+    buffer[length++] = static_cast<char>('a' + to % 8);
+    buffer[length++] = static_cast<char>('1' + to / 8);
+    if (promotion != 0) {
+        buffer[length++] = "nbrq"[promotion - 1];
+    }
+    buffer[length] = '\0';
+    return SIRIO_OK;
+}
+
+}  // extern "C"
@@ -1,6 +1,6 @@
 #include "sirio/uci.hpp"
 
-int main() {
-    return sirio::uci::run();
+int main(int argc, char* argv[]) {
+    return sirio::uci::run(argc, argv);
 }
 
@@ -0,0 +1,105 @@
+#include "sirio/main_search_thread.hpp"
+
+#include <utility>
+
+namespace sirio {
+
+MainSearchThread::MainSearchThread(Engine &engine) : engine_(engine) {}
+
+MainSearchThread::~MainSearchThread() {
+    request_stop();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    job_cv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void MainSearchThread::start(Board board, SearchLimits limits, Completion on_complete) {
+    Clock::time_point go_time = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [&]() { return !busy_; });
+    job_ = Job{std::move(board), limits, std::move(on_complete), go_time};
+    busy_ = true;
+    stop_time_.reset();
+    if (!thread_.joinable()) {
+        thread_ = std::thread([this]() { run(); });
+    }
+    lock.unlock();
+    job_cv_.notify_one();
+}
+
+void MainSearchThread::request_stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!busy_) {
+        return;
+    }
+    if (!stop_time_.has_value()) {
+        stop_time_ = Clock::now();
+    }
+    // A stop that arrives before the hand-off is picked up is held by the engine and applied when
+    // the search starts; once the search has returned there is nothing left to stop.
+    if (in_search_ || job_.has_value()) {
+        engine_.request_stop();
+    }
+}
+
+void MainSearchThread::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [&]() { return !busy_; });
+}
+
+bool MainSearchThread::searching() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return busy_;
+}
+
+MainSearchLatency MainSearchThread::last_latency() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latency_;
+}
+
+void MainSearchThread::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        job_cv_.wait(lock, [&]() { return quit_ || job_.has_value(); });
+        if (quit_ && !job_.has_value()) {
+            return;
+        }
+        Job job = std::move(*job_);
+        job_.reset();
+        in_search_ = true;
+        lock.unlock();
+
+        Clock::time_point entry = Clock::now();
+        SearchResult result = engine_.search(job.board, job.limits);
+
+        lock.lock();
+        in_search_ = false;
+        lock.unlock();
+
+        if (job.on_complete) {
+            job.on_complete(job.board, job.limits, result);
+        }
+        Clock::time_point done = Clock::now();
+
+        lock.lock();
+        MainSearchLatency latency;
+        latency.go_to_first_node_us =
+            static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(entry - job.go_time).count()) +
+            result.instrumentation.first_node_us;
+        if (stop_time_.has_value() && done > *stop_time_) {
+            latency.stop_to_result_us = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(done - *stop_time_).count());
+        }
+        latency_ = latency;
+        busy_ = false;
+        idle_cv_.notify_all();
+    }
+}
+
+}  // namespace sirio
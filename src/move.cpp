@@ -2,6 +2,7 @@
 
 #include <cctype>
 #include <cstdlib>
+#include <optional>
 #include <stdexcept>
 
 #include "sirio/bitboard.hpp"
@@ -57,8 +58,215 @@ int square_from_uci(const std::string &text, std::size_t offset) {
     return (rank - '1') * 8 + (file - 'a');
 }
 
+std::optional<PieceType> piece_from_san_char(char symbol) {
+    switch (symbol) {
+        case 'N':
+            return PieceType::Knight;
+        case 'B':
+            return PieceType::Bishop;
+        case 'R':
+            return PieceType::Rook;
+        case 'Q':
+            return PieceType::Queen;
+        case 'K':
+            return PieceType::King;
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<Move> castling_from_san(const Board &board, bool kingside) {
+    const Color us = board.side_to_move();
+    const CastlingRights &rights = board.castling_rights();
+    const bool allowed = us == Color::White
+                             ? (kingside ? rights.white_kingside : rights.white_queenside)
+                             : (kingside ? rights.black_kingside : rights.black_queenside);
+    const int rank_base = us == Color::White ? 0 : 56;
+    const int king_sq = rank_base + 4;
+    if (!allowed || board.king_square(us) != king_sq) {
+        return std::nullopt;
+    }
+    const Bitboard path = kingside ? one_bit(rank_base + 5) | one_bit(rank_base + 6)
+                                   : one_bit(rank_base + 1) | one_bit(rank_base + 2) |
+                                         one_bit(rank_base + 3);
+    if ((board.occupancy() & path) != 0) {
+        return std::nullopt;
+    }
+    Move move{king_sq, rank_base + (kingside ? 6 : 2), PieceType::King};
+    move.is_castling = true;
+    if (!board.is_legal(move)) {
+        return std::nullopt;
+    }
+    return move;
+}
+
 }  // namespace
 
+std::optional<Move> move_from_san(const Board &board, std::string_view san) {
+    while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' ||
+                            san.back() == '?')) {
+        san.remove_suffix(1);
+    }
+    if (san == "O-O" || san == "0-0") {
+        return castling_from_san(board, true);
+    }
+    if (san == "O-O-O" || san == "0-0-0") {
+        return castling_from_san(board, false);
+    }
+    if (san.size() < 2) {
+        return std::nullopt;
+    }
+
+    PieceType piece = PieceType::Pawn;
+    if (auto type = piece_from_san_char(san.front())) {
+        piece = *type;
+        san.remove_prefix(1);
+    }
+
+    std::optional<PieceType> promotion;
+    if (san.size() >= 2 && san[san.size() - 2] == '=') {
+        const auto symbol = static_cast<unsigned char>(san.back());
+        promotion = piece_from_san_char(static_cast<char>(std::toupper(symbol)));
+        if (!promotion) {
+            return std::nullopt;
+        }
+        san.remove_suffix(2);
+    } else if (piece == PieceType::Pawn && san.size() >= 3 &&
+               std::isdigit(static_cast<unsigned char>(san[san.size() - 2]))) {
+        // "e8Q" without the '='.
+        promotion = piece_from_san_char(san.back());
+        if (!promotion) {
+            return std::nullopt;
+        }
+        san.remove_suffix(1);
+    }
+    if (promotion && (piece != PieceType::Pawn || *promotion == PieceType::King)) {
+        return std::nullopt;
+    }
+
+    if (san.size() < 2) {
+        return std::nullopt;
+    }
+    const char to_file = san[san.size() - 2];
+    const char to_rank = san[san.size() - 1];
+    if (to_file < 'a' || to_file > 'h' || to_rank < '1' || to_rank > '8') {
+        return std::nullopt;
+    }
+    const int to = (to_rank - '1') * 8 + (to_file - 'a');
+    san.remove_suffix(2);
+
+    bool capture = false;
+    int from_file = -1;
+    Bitboard from_filter = ~Bitboard{0};
+    for (char symbol : san) {
+        if (symbol == 'x' || symbol == ':') {
+            capture = true;
+        } else if (symbol >= 'a' && symbol <= 'h') {
+            from_file = symbol - 'a';
+            from_filter &= file_a_mask << from_file;
+        } else if (symbol >= '1' && symbol <= '8') {
+            from_filter &= rank_1_mask << (8 * (symbol - '1'));
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    const Color us = board.side_to_move();
+    const Bitboard occupied = board.occupancy();
+    const Bitboard to_mask = one_bit(to);
+    if (board.occupancy(us) & to_mask) {
+        return std::nullopt;
+    }
+    const auto target = board.piece_at(to);
+    std::optional<PieceType> captured;
+    if (target) {
+        captured = target->second;
+    }
+
+    const bool last_rank = us == Color::White ? to >= 56 : to < 8;
+    bool en_passant = false;
+    Bitboard candidates = 0;
+    switch (piece) {
+        case PieceType::Pawn: {
+            if (last_rank != promotion.has_value()) {
+                return std::nullopt;
+            }
+            // A different source file without 'x' ("ed5") still denotes a capture.
+            const bool diagonal = capture || (from_file >= 0 && from_file != file_of(to));
+            if (diagonal) {
+                const auto ep_square = board.en_passant_square();
+                en_passant = !target && ep_square && *ep_square == to;
+                if (!target && !en_passant) {
+                    return std::nullopt;
+                }
+                candidates = us == Color::White ? pawn_attacks_black(to_mask)
+                                                : pawn_attacks_white(to_mask);
+            } else {
+                if (target) {
+                    return std::nullopt;
+                }
+                const int single = us == Color::White ? to - 8 : to + 8;
+                if (single < 0 || single >= 64) {
+                    return std::nullopt;
+                }
+                candidates = one_bit(single);
+                const bool double_push_rank =
+                    us == Color::White ? rank_of(to) == 3 : rank_of(to) == 4;
+                if (double_push_rank && (occupied & one_bit(single)) == 0) {
+                    candidates |= one_bit(us == Color::White ? to - 16 : to + 16);
+                }
+            }
+            break;
+        }
+        case PieceType::Knight:
+            candidates = knight_attacks(to);
+            break;
+        case PieceType::Bishop:
+        case PieceType::Rook:
+        case PieceType::Queen: {
+            // There are rarely more than two sliders of a type, so checking each one's line to the
+            // destination is cheaper than an attack-table lookup from it.
+            Bitboard sliders = board.pieces(us, piece) & from_filter;
+            while (sliders) {
+                const int from = pop_lsb(sliders);
+                const int file_delta = file_of(from) - file_of(to);
+                const int rank_delta = rank_of(from) - rank_of(to);
+                const bool straight = file_delta == 0 || rank_delta == 0;
+                const bool diagonal = file_delta == rank_delta || file_delta == -rank_delta;
+                const bool aligned = piece == PieceType::Rook     ? straight
+                                     : piece == PieceType::Bishop ? diagonal
+                                                                  : straight || diagonal;
+                if (aligned && (squares_between(from, to) & occupied) == 0) {
+                    candidates |= one_bit(from);
+                }
+            }
+            break;
+        }
+        case PieceType::King:
+            candidates = king_attacks(to);
+            break;
+        case PieceType::Count:
+            return std::nullopt;
+    }
+    candidates &= board.pieces(us, piece) & from_filter;
+
+    std::optional<Move> resolved;
+    while (candidates) {
+        Move move{pop_lsb(candidates), to, piece};
+        move.captured = en_passant ? std::optional<PieceType>{PieceType::Pawn} : captured;
+        move.promotion = promotion;
+        move.is_en_passant = en_passant;
+        if (!board.is_legal(move)) {
+            continue;
+        }
+        if (resolved) {
+            return std::nullopt;
+        }
+        resolved = move;
+    }
+    return resolved;
+}
+
 std::string move_to_uci(const Move &move) {
     std::string result;
     result.reserve(5);
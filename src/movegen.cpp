@@ -1,7 +1,6 @@
 #include "sirio/movegen.hpp"
 
-#include <array>
-#include <exception>
+#include <algorithm>
 #include <optional>
 
 namespace sirio {
@@ -20,6 +19,11 @@ void append_move(std::vector<Move> &moves, Move move) {
     moves.push_back(move);
 }
 
+template <Color Us>
+constexpr Color opponent_of() {
+    return Us == Color::White ? Color::Black : Color::White;
+}
+
 template <Color Us>
 Bitboard pawn_push(Bitboard pawns) {
     if constexpr (Us == Color::White) {
@@ -47,21 +51,30 @@ Bitboard pawn_right_attacks(Bitboard pawns) {
     }
 }
 
-template <Color Us>
-void generate_pawn_moves_color(const Board &board, Color them, Bitboard occupancy_all,
-                               std::vector<Move> &moves, bool tactical_only) {
+template <GenType Type>
+constexpr bool generates_quiets() {
+    return Type != GenType::Captures;
+}
+
+template <GenType Type>
+constexpr bool generates_captures() {
+    return Type != GenType::Quiets && Type != GenType::QuietChecks;
+}
+
+// `target` holds the destination squares allowed for the category: enemy pieces for captures,
+// empty squares for quiets, the checker and the interposition squares for evasions.
+template <Color Us, GenType Type>
+void generate_pawn_moves(const Board &board, Bitboard target, std::vector<Move> &moves) {
+    constexpr Color Them = opponent_of<Us>();
     constexpr Bitboard promotion_rank = Us == Color::White ? rank_8_mask : rank_1_mask;
-    constexpr Bitboard start_rank = Us == Color::White ? rank_2_mask : rank_7_mask;
+    constexpr Bitboard double_push_rank = Us == Color::White ? rank_3_mask : rank_6_mask;
     constexpr int forward_offset = Us == Color::White ? 8 : -8;
     constexpr int double_offset = forward_offset * 2;
     constexpr int left_offset = Us == Color::White ? 7 : -9;
     constexpr int right_offset = Us == Color::White ? 9 : -7;
 
-    Bitboard pawns = board.pieces(Us, PieceType::Pawn);
-    Bitboard enemy_occ = board.occupancy(them);
-    Bitboard empty = ~occupancy_all;
-    auto en_passant = board.en_passant_square();
-    Bitboard en_passant_mask = en_passant ? one_bit(*en_passant) : 0ULL;
+    const Bitboard pawns = board.pieces(Us, PieceType::Pawn);
+    const Bitboard empty = ~board.occupancy();
 
     auto emit_promotion = [&](int from, int to, std::optional<PieceType> captured_piece) {
         for (PieceType promo : {PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight}) {
@@ -74,335 +87,277 @@ void generate_pawn_moves_color(const Board &board, Color them, Bitboard occupanc
         }
     };
 
-    Bitboard single_pushes = pawn_push<Us>(pawns) & empty;
-    Bitboard promotion_pushes = single_pushes & promotion_rank;
-    Bitboard quiet_pushes = single_pushes & ~promotion_rank;
-    while (promotion_pushes) {
-        int to = pop_lsb(promotion_pushes);
-        int from = to - forward_offset;
-        emit_promotion(from, to, std::nullopt);
+    const Bitboard single_pushes = pawn_push<Us>(pawns) & empty;
+    if constexpr (generates_captures<Type>()) {
+        Bitboard promotion_pushes = single_pushes & promotion_rank;
+        if constexpr (Type == GenType::Evasions) {
+            promotion_pushes &= target;
+        }
+        while (promotion_pushes) {
+            int to = pop_lsb(promotion_pushes);
+            emit_promotion(to - forward_offset, to, std::nullopt);
+        }
     }
 
-    if (!tactical_only) {
-        Bitboard non_promo = quiet_pushes;
-        while (non_promo) {
-            int to = pop_lsb(non_promo);
-            int from = to - forward_offset;
-            append_move(moves, Move{from, to, PieceType::Pawn});
+    if constexpr (generates_quiets<Type>()) {
+        Bitboard pushes = single_pushes & ~promotion_rank;
+        Bitboard double_pushes = pawn_push<Us>(single_pushes & double_push_rank) & empty;
+        if constexpr (Type == GenType::Evasions) {
+            pushes &= target;
+            double_pushes &= target;
+        } else if constexpr (Type == GenType::QuietChecks) {
+            // Direct checks land on the pawn check squares; a pinned-to-their-king pawn may
+            // uncover a check from anywhere.
+            const Bitboard discoverers = pawns & board.king_blockers(Them);
+            const Bitboard checks = board.check_squares(PieceType::Pawn);
+            pushes &= checks | pawn_push<Us>(discoverers);
+            double_pushes &= checks | pawn_push<Us>(pawn_push<Us>(discoverers));
+        }
+        while (pushes) {
+            int to = pop_lsb(pushes);
+            append_move(moves, Move{to - forward_offset, to, PieceType::Pawn});
         }
-
-        Bitboard double_sources = pawns & start_rank;
-        Bitboard first_step = pawn_push<Us>(double_sources) & empty;
-        Bitboard double_pushes = pawn_push<Us>(first_step) & empty;
         while (double_pushes) {
             int to = pop_lsb(double_pushes);
-            int from = to - double_offset;
-            append_move(moves, Move{from, to, PieceType::Pawn});
+            append_move(moves, Move{to - double_offset, to, PieceType::Pawn});
         }
     }
 
-    auto process_captures = [&](Bitboard capture_mask, int offset) {
-        Bitboard promo = capture_mask & promotion_rank;
-        Bitboard normal = capture_mask & ~promotion_rank;
-        while (promo) {
-            int to = pop_lsb(promo);
-            int from = to - offset;
-            auto captured = captured_piece_on(board, to, them);
-            emit_promotion(from, to, captured);
-        }
-        while (normal) {
-            int to = pop_lsb(normal);
-            int from = to - offset;
-            Move move{from, to, PieceType::Pawn};
-            move.captured = captured_piece_on(board, to, them);
-            append_move(moves, move);
+    if constexpr (generates_captures<Type>()) {
+        Bitboard enemy_occ = board.occupancy(Them);
+        if constexpr (Type == GenType::Evasions) {
+            enemy_occ &= target;
         }
-    };
 
-    Bitboard left_captures = pawn_left_attacks<Us>(pawns) & enemy_occ;
-    Bitboard right_captures = pawn_right_attacks<Us>(pawns) & enemy_occ;
-    process_captures(left_captures, left_offset);
-    process_captures(right_captures, right_offset);
+        auto process_captures = [&](Bitboard capture_mask, int offset) {
+            Bitboard promo = capture_mask & promotion_rank;
+            Bitboard normal = capture_mask & ~promotion_rank;
+            while (promo) {
+                int to = pop_lsb(promo);
+                emit_promotion(to - offset, to, captured_piece_on(board, to, Them));
+            }
+            while (normal) {
+                int to = pop_lsb(normal);
+                Move move{to - offset, to, PieceType::Pawn};
+                move.captured = captured_piece_on(board, to, Them);
+                append_move(moves, move);
+            }
+        };
+        process_captures(pawn_left_attacks<Us>(pawns) & enemy_occ, left_offset);
+        process_captures(pawn_right_attacks<Us>(pawns) & enemy_occ, right_offset);
 
-    if (en_passant_mask != 0) {
-        Bitboard ep_left = pawn_left_attacks<Us>(pawns) & en_passant_mask;
-        while (ep_left) {
-            int to = pop_lsb(ep_left);
-            int from = to - left_offset;
-            Move move{from, to, PieceType::Pawn};
-            move.is_en_passant = true;
-            move.captured = PieceType::Pawn;
-            append_move(moves, move);
+        const auto en_passant = board.en_passant_square();
+        if (!en_passant) {
+            return;
         }
-        Bitboard ep_right = pawn_right_attacks<Us>(pawns) & en_passant_mask;
-        while (ep_right) {
-            int to = pop_lsb(ep_right);
-            int from = to - right_offset;
-            Move move{from, to, PieceType::Pawn};
-            move.is_en_passant = true;
-            move.captured = PieceType::Pawn;
-            append_move(moves, move);
+        if constexpr (Type == GenType::Evasions) {
+            // Only useful when the double-pushed pawn is the checker or the square blocks.
+            if ((target & (one_bit(*en_passant) | one_bit(*en_passant - forward_offset))) == 0) {
+                return;
+            }
         }
+        const Bitboard en_passant_mask = one_bit(*en_passant);
+        auto process_en_passant = [&](Bitboard capture_mask, int offset) {
+            while (capture_mask) {
+                int to = pop_lsb(capture_mask);
+                Move move{to - offset, to, PieceType::Pawn};
+                move.is_en_passant = true;
+                move.captured = PieceType::Pawn;
+                append_move(moves, move);
+            }
+        };
+        process_en_passant(pawn_left_attacks<Us>(pawns) & en_passant_mask, left_offset);
+        process_en_passant(pawn_right_attacks<Us>(pawns) & en_passant_mask, right_offset);
     }
 }
 
-void generate_pawn_moves_impl(const Board &board, Color us, Color them, Bitboard occupancy_all,
-                              std::vector<Move> &moves, bool tactical_only) {
-    if (us == Color::White) {
-        generate_pawn_moves_color<Color::White>(board, them, occupancy_all, moves, tactical_only);
+template <PieceType Piece>
+Bitboard piece_attacks(int square, Bitboard occupancy) {
+    if constexpr (Piece == PieceType::Knight) {
+        return knight_attacks(square);
+    } else if constexpr (Piece == PieceType::Bishop) {
+        return bishop_attacks(square, occupancy);
+    } else if constexpr (Piece == PieceType::Rook) {
+        return rook_attacks(square, occupancy);
+    } else if constexpr (Piece == PieceType::Queen) {
+        return queen_attacks(square, occupancy);
     } else {
-        generate_pawn_moves_color<Color::Black>(board, them, occupancy_all, moves, tactical_only);
+        return king_attacks(square);
     }
 }
 
-void generate_pawn_moves(const Board &board, Color us, Color them, Bitboard occupancy_all,
-                         std::vector<Move> &moves) {
-    generate_pawn_moves_impl(board, us, them, occupancy_all, moves, false);
-}
-
-void generate_leaper_moves(const Board &board, Color us, Color them, Bitboard occupancy_us,
-                           Bitboard occupancy_them, PieceType piece_type,
-                           Bitboard (*attack_function)(int), std::vector<Move> &moves) {
-    Bitboard pieces = board.pieces(us, piece_type);
+template <Color Us, PieceType Piece, GenType Type>
+void generate_piece_moves(const Board &board, Bitboard target, std::vector<Move> &moves) {
+    constexpr Color Them = opponent_of<Us>();
+    Bitboard pieces = board.pieces(Us, Piece);
+    const Bitboard occupancy_all = board.occupancy();
+    const Bitboard occupancy_them = board.occupancy(Them);
     while (pieces) {
         int from = pop_lsb(pieces);
-        Bitboard attacks = attack_function(from) & ~occupancy_us;
-        Bitboard quiet = attacks & ~occupancy_them;
-        while (quiet) {
-            int to = pop_lsb(quiet);
-            append_move(moves, Move{from, to, piece_type});
+        Bitboard attacks = piece_attacks<Piece>(from, occupancy_all) & target;
+        if constexpr (Type == GenType::QuietChecks) {
+            // Pieces shielding their king from one of our sliders may check from any square.
+            if ((board.king_blockers(Them) & one_bit(from)) == 0) {
+                if constexpr (Piece == PieceType::King) {
+                    continue;
+                } else {
+                    attacks &= board.check_squares(Piece);
+                }
+            }
         }
-        Bitboard captures = attacks & occupancy_them;
-        while (captures) {
-            int to = pop_lsb(captures);
-            Move move{from, to, piece_type};
-            move.captured = captured_piece_on(board, to, them);
-            append_move(moves, move);
+        if constexpr (generates_quiets<Type>()) {
+            Bitboard quiet = attacks & ~occupancy_them;
+            while (quiet) {
+                int to = pop_lsb(quiet);
+                append_move(moves, Move{from, to, Piece});
+            }
+        }
+        if constexpr (generates_captures<Type>()) {
+            Bitboard captures = attacks & occupancy_them;
+            while (captures) {
+                int to = pop_lsb(captures);
+                Move move{from, to, Piece};
+                move.captured = captured_piece_on(board, to, Them);
+                append_move(moves, move);
+            }
         }
     }
 }
 
-void generate_leaper_captures(const Board &board, Color us, Color them, Bitboard occupancy_them,
-                              PieceType piece_type, Bitboard (*attack_function)(int),
-                              std::vector<Move> &moves) {
-    Bitboard pieces = board.pieces(us, piece_type);
-    while (pieces) {
-        int from = pop_lsb(pieces);
-        Bitboard captures = attack_function(from) & occupancy_them;
-        while (captures) {
-            int to = pop_lsb(captures);
-            Move move{from, to, piece_type};
-            move.captured = captured_piece_on(board, to, them);
-            append_move(moves, move);
-        }
+template <Color Us>
+void generate_castling_moves(const Board &board, std::vector<Move> &moves) {
+    constexpr Color Them = opponent_of<Us>();
+    constexpr int rank_base = Us == Color::White ? 0 : 56;
+    constexpr Bitboard kingside_path = one_bit(rank_base + 5) | one_bit(rank_base + 6);
+    constexpr Bitboard queenside_path =
+        one_bit(rank_base + 1) | one_bit(rank_base + 2) | one_bit(rank_base + 3);
+
+    const CastlingRights &rights = board.castling_rights();
+    const bool kingside = Us == Color::White ? rights.white_kingside : rights.black_kingside;
+    const bool queenside = Us == Color::White ? rights.white_queenside : rights.black_queenside;
+    if (!kingside && !queenside) {
+        return;
+    }
+    int king_sq = board.king_square(Us);
+    if (king_sq < 0 || board.checkers() != 0) {
+        return;
     }
-}
 
-void generate_slider_moves(const Board &board, Color us, Color them, Bitboard occupancy_us,
-                           Bitboard occupancy_all, PieceType piece_type,
-                           Bitboard (*attack_function)(int, Bitboard),
-                           std::vector<Move> &moves) {
-    Bitboard pieces = board.pieces(us, piece_type);
-    Bitboard occupancy_them = board.occupancy(them);
-    while (pieces) {
-        int from = pop_lsb(pieces);
-        Bitboard attacks = attack_function(from, occupancy_all) & ~occupancy_us;
-        Bitboard quiet = attacks & ~occupancy_them;
-        while (quiet) {
-            int to = pop_lsb(quiet);
-            append_move(moves, Move{from, to, piece_type});
-        }
-        Bitboard captures = attacks & occupancy_them;
-        while (captures) {
-            int to = pop_lsb(captures);
-            Move move{from, to, piece_type};
-            move.captured = captured_piece_on(board, to, them);
-            append_move(moves, move);
-        }
+    const Bitboard all_occ = board.occupancy();
+    if (kingside && (all_occ & kingside_path) == 0 &&
+        !board.is_square_attacked(rank_base + 5, Them) &&
+        !board.is_square_attacked(rank_base + 6, Them)) {
+        Move move{king_sq, rank_base + 6, PieceType::King};
+        move.is_castling = true;
+        append_move(moves, move);
+    }
+    if (queenside && (all_occ & queenside_path) == 0 &&
+        !board.is_square_attacked(rank_base + 2, Them) &&
+        !board.is_square_attacked(rank_base + 3, Them)) {
+        Move move{king_sq, rank_base + 2, PieceType::King};
+        move.is_castling = true;
+        append_move(moves, move);
     }
 }
 
-void generate_slider_captures(const Board &board, Color us, Color them, Bitboard occupancy_all,
-                              PieceType piece_type, Bitboard (*attack_function)(int, Bitboard),
-                              std::vector<Move> &moves) {
-    Bitboard pieces = board.pieces(us, piece_type);
-    Bitboard occupancy_them = board.occupancy(them);
-    while (pieces) {
-        int from = pop_lsb(pieces);
-        Bitboard captures = attack_function(from, occupancy_all) & occupancy_them;
-        while (captures) {
-            int to = pop_lsb(captures);
-            Move move{from, to, piece_type};
-            move.captured = captured_piece_on(board, to, them);
-            append_move(moves, move);
+template <Color Us, GenType Type>
+void generate_all(const Board &board, std::vector<Move> &moves) {
+    constexpr Color Them = opponent_of<Us>();
+    [[maybe_unused]] const std::size_t first = moves.size();
+
+    Bitboard target = 0;
+    Bitboard king_target = 0;
+    if constexpr (Type == GenType::Captures) {
+        target = board.occupancy(Them);
+        king_target = target;
+    } else if constexpr (Type == GenType::Quiets || Type == GenType::QuietChecks) {
+        target = ~board.occupancy();
+        king_target = target;
+    } else if constexpr (Type == GenType::All) {
+        target = ~board.occupancy(Us);
+        king_target = target;
+    } else {
+        const Bitboard checkers = board.checkers();
+        king_target = ~board.occupancy(Us);
+        // In double check only the king can move.
+        if (checkers == 0) {
+            target = ~board.occupancy(Us);
+        } else if ((checkers & (checkers - 1)) == 0) {
+            const int checker = bit_scan_forward(checkers);
+            target = squares_between(board.king_square(Us), checker) | checkers;
         }
     }
-}
 
-void generate_castling_moves(const Board &board, Color us, Color them, std::vector<Move> &moves) {
-    const CastlingRights &rights = board.castling_rights();
-    int king_sq = board.king_square(us);
-    if (king_sq < 0) {
-        return;
+    if (target != 0) {
+        generate_pawn_moves<Us, Type>(board, target, moves);
+        generate_piece_moves<Us, PieceType::Knight, Type>(board, target, moves);
+        generate_piece_moves<Us, PieceType::Bishop, Type>(board, target, moves);
+        generate_piece_moves<Us, PieceType::Rook, Type>(board, target, moves);
+        generate_piece_moves<Us, PieceType::Queen, Type>(board, target, moves);
     }
-    if (board.is_square_attacked(king_sq, them)) {
-        return;
+    generate_piece_moves<Us, PieceType::King, Type>(board, king_target, moves);
+    if constexpr (Type == GenType::Quiets || Type == GenType::All) {
+        generate_castling_moves<Us>(board, moves);
     }
 
-    Bitboard all_occ = board.occupancy();
-    if (us == Color::White) {
-        if (rights.white_kingside) {
-            if ((all_occ & (one_bit(5) | one_bit(6))) == 0 &&
-                !board.is_square_attacked(5, them) && !board.is_square_attacked(6, them)) {
-                Move move{king_sq, 6, PieceType::King};
-                move.is_castling = true;
-                append_move(moves, move);
-            }
-        }
-        if (rights.white_queenside) {
-            if ((all_occ & (one_bit(1) | one_bit(2) | one_bit(3))) == 0 &&
-                !board.is_square_attacked(2, them) && !board.is_square_attacked(3, them)) {
-                Move move{king_sq, 2, PieceType::King};
-                move.is_castling = true;
-                append_move(moves, move);
-            }
-        }
-    } else {
-        if (rights.black_kingside) {
-            if ((all_occ & (one_bit(61) | one_bit(62))) == 0 &&
-                !board.is_square_attacked(61, them) && !board.is_square_attacked(62, them)) {
-                Move move{king_sq, 62, PieceType::King};
-                move.is_castling = true;
-                append_move(moves, move);
-            }
-        }
-        if (rights.black_queenside) {
-            if ((all_occ & (one_bit(57) | one_bit(58) | one_bit(59))) == 0 &&
-                !board.is_square_attacked(58, them) && !board.is_square_attacked(59, them)) {
-                Move move{king_sq, 58, PieceType::King};
-                move.is_castling = true;
-                append_move(moves, move);
-            }
-        }
+    if constexpr (Type == GenType::QuietChecks) {
+        // Discovered-check candidates moving along the line to their king do not check.
+        moves.erase(std::remove_if(moves.begin() + static_cast<std::ptrdiff_t>(first), moves.end(),
+                                   [&](const Move &move) { return !board.gives_check(move); }),
+                    moves.end());
     }
 }
 
-void generate_pawn_tactical_moves(const Board &board, Color us, Color them,
-                                  Bitboard occupancy_all, std::vector<Move> &moves) {
-    generate_pawn_moves_impl(board, us, them, occupancy_all, moves, true);
+}  // namespace
+
+template <GenType Type>
+void generate_moves(const Board &board, std::vector<Move> &moves) {
+    if (board.side_to_move() == Color::White) {
+        generate_all<Color::White, Type>(board, moves);
+    } else {
+        generate_all<Color::Black, Type>(board, moves);
+    }
 }
 
-}  // namespace
+template void generate_moves<GenType::Captures>(const Board &, std::vector<Move> &);
+template void generate_moves<GenType::Quiets>(const Board &, std::vector<Move> &);
+template void generate_moves<GenType::Evasions>(const Board &, std::vector<Move> &);
+template void generate_moves<GenType::QuietChecks>(const Board &, std::vector<Move> &);
+template void generate_moves<GenType::All>(const Board &, std::vector<Move> &);
 
 std::vector<Move> generate_pseudo_legal_moves(const Board &board) {
     std::vector<Move> moves;
-    const Color us = board.side_to_move();
-    const Color them = opposite(us);
-    const Bitboard occupancy_all = board.occupancy();
-    const Bitboard occupancy_us = board.occupancy(us);
-    const Bitboard occupancy_them = board.occupancy(them);
-
-    generate_pawn_moves(board, us, them, occupancy_all, moves);
-    generate_leaper_moves(board, us, them, occupancy_us, occupancy_them, PieceType::Knight,
-                          knight_attacks, moves);
-    generate_slider_moves(board, us, them, occupancy_us, occupancy_all, PieceType::Bishop,
-                          bishop_attacks, moves);
-    generate_slider_moves(board, us, them, occupancy_us, occupancy_all, PieceType::Rook,
-                          rook_attacks, moves);
-    generate_slider_moves(board, us, them, occupancy_us, occupancy_all, PieceType::Queen,
-                          queen_attacks, moves);
-    generate_leaper_moves(board, us, them, occupancy_us, occupancy_them, PieceType::King,
-                          king_attacks, moves);
-    generate_castling_moves(board, us, them, moves);
-
+    generate_moves<GenType::All>(board, moves);
     return moves;
 }
 
 std::vector<Move> generate_pseudo_legal_tactical_moves(const Board &board) {
     std::vector<Move> moves;
-    const Color us = board.side_to_move();
-    const Color them = opposite(us);
-    const Bitboard occupancy_all = board.occupancy();
-    const Bitboard occupancy_them = board.occupancy(them);
-
-    generate_pawn_tactical_moves(board, us, them, occupancy_all, moves);
-    generate_leaper_captures(board, us, them, occupancy_them, PieceType::Knight, knight_attacks,
-                             moves);
-    generate_slider_captures(board, us, them, occupancy_all, PieceType::Bishop, bishop_attacks,
-                             moves);
-    generate_slider_captures(board, us, them, occupancy_all, PieceType::Rook, rook_attacks, moves);
-    generate_slider_captures(board, us, them, occupancy_all, PieceType::Queen, queen_attacks,
-                             moves);
-    generate_leaper_captures(board, us, them, occupancy_them, PieceType::King, king_attacks, moves);
-
+    generate_moves<GenType::Captures>(board, moves);
     return moves;
 }
 
-std::vector<Move> generate_pseudo_legal_quiet_checks(Board &board) {
-    auto pseudo = generate_pseudo_legal_moves(board);
+std::vector<Move> generate_pseudo_legal_quiet_checks(const Board &board) {
     std::vector<Move> quiet_checks;
-    quiet_checks.reserve(pseudo.size());
-
-    for (const Move &move : pseudo) {
-        if (move.captured.has_value() || move.promotion.has_value() || move.is_en_passant ||
-            move.is_castling) {
-            continue;
-        }
-
-        Board::UndoState undo;
-        try {
-            board.make_move(move, undo);
-        } catch (const std::exception &) {
-            continue;
-        }
-
-        Color mover = opposite(board.side_to_move());
-        if (board.king_square(mover) >= 0 && board.in_check(mover)) {
-            board.undo_move(move, undo);
-            continue;
-        }
-
-        if (board.in_check(board.side_to_move())) {
-            quiet_checks.push_back(move);
-        }
-
-        board.undo_move(move, undo);
-    }
-
+    generate_moves<GenType::QuietChecks>(board, quiet_checks);
+    std::erase_if(quiet_checks, [&](const Move &move) { return !board.is_legal(move); });
     return quiet_checks;
 }
 
 std::vector<Move> generate_legal_moves(Board &board) {
-    std::vector<Move> legal_moves;
-    auto pseudo = generate_pseudo_legal_moves(board);
-    legal_moves.reserve(pseudo.size());
-    for (const Move &move : pseudo) {
-        Board::UndoState undo;
-        bool legal = true;
-        try {
-            board.make_move(move, undo);
-        } catch (const std::exception &) {
-            legal = false;
-        }
-        if (legal) {
-            Color mover = opposite(board.side_to_move());
-            if (board.king_square(mover) >= 0 && board.in_check(mover)) {
-                legal = false;
-            }
-        }
-        if (legal) {
-            legal_moves.push_back(move);
-        }
-        board.undo_move(move, undo);
-    }
-
-    return legal_moves;
+    return generate_legal_moves(static_cast<const Board &>(board));
 }
 
 std::vector<Move> generate_legal_moves(const Board &board) {
-    Board copy = board;
-    return generate_legal_moves(copy);
+    // Evasions keep the relative order of the full list, so the legal moves come out identical.
+    std::vector<Move> moves;
+    if (board.checkers() != 0) {
+        generate_moves<GenType::Evasions>(board, moves);
+    } else {
+        generate_moves<GenType::All>(board, moves);
+    }
+    std::erase_if(moves, [&](const Move &move) { return !board.is_legal(move); });
+    return moves;
 }
 
 }  // namespace sirio
-
@@ -8,10 +8,11 @@
 #include <sstream>
 #include <stdexcept>
 
-#if defined(SIRIO_USE_AVX2) || defined(SIRIO_USE_AVX512)
-#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
 #endif
 
+#include "sirio/cpu_features.hpp"
 #include "sirio/move.hpp"
 #include "sirio/nnue/features.hpp"
 
@@ -43,90 +44,6 @@ int total_piece_count(const Board &board) {
     return total;
 }
 
-#if defined(SIRIO_USE_AVX512)
-struct WeightRegisters {
-    __m512d main;
-    __m256d tail;
-};
-
-WeightRegisters load_weight_registers(const double *weights) {
-    WeightRegisters regs{};
-    regs.main = _mm512_loadu_pd(weights);
-    regs.tail = _mm256_loadu_pd(weights + 8);
-    return regs;
-}
-
-double dot_product(const WeightRegisters &regs, const int *counts) {
-    __m256i count_lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(counts));
-    __m512d count_lo_pd = _mm512_cvtepi32_pd(count_lo);
-    __m512d prod_lo = _mm512_mul_pd(regs.main, count_lo_pd);
-
-    __m128i count_hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(counts + 8));
-    __m256d count_hi_pd = _mm256_cvtepi32_pd(count_hi);
-    __m256d prod_hi = _mm256_mul_pd(regs.tail, count_hi_pd);
-
-    alignas(64) double accum_buffer[8];
-    alignas(32) double tail_buffer[4];
-    _mm512_storeu_pd(accum_buffer, prod_lo);
-    _mm256_storeu_pd(tail_buffer, prod_hi);
-
-    double sum = 0.0;
-    for (double entry : accum_buffer) {
-        sum += entry;
-    }
-    for (double entry : tail_buffer) {
-        sum += entry;
-    }
-    return sum;
-}
-#elif defined(SIRIO_USE_AVX2)
-struct WeightRegisters {
-    __m256d first;
-    __m256d second;
-    __m256d third;
-};
-
-WeightRegisters load_weight_registers(const double *weights) {
-    WeightRegisters regs{};
-    regs.first = _mm256_loadu_pd(weights);
-    regs.second = _mm256_loadu_pd(weights + 4);
-    regs.third = _mm256_loadu_pd(weights + 8);
-    return regs;
-}
-
-double dot_product(const WeightRegisters &regs, const int *counts) {
-    __m128i counts0_i = _mm_loadu_si128(reinterpret_cast<const __m128i *>(counts));
-    __m256d counts0 = _mm256_cvtepi32_pd(counts0_i);
-    __m128i counts1_i = _mm_loadu_si128(reinterpret_cast<const __m128i *>(counts + 4));
-    __m256d counts1 = _mm256_cvtepi32_pd(counts1_i);
-    __m128i counts2_i = _mm_loadu_si128(reinterpret_cast<const __m128i *>(counts + 8));
-    __m256d counts2 = _mm256_cvtepi32_pd(counts2_i);
-
-    __m256d accum = _mm256_mul_pd(regs.first, counts0);
-    accum = _mm256_fmadd_pd(regs.second, counts1, accum);
-    accum = _mm256_fmadd_pd(regs.third, counts2, accum);
-
-    alignas(32) double buffer[4];
-    _mm256_storeu_pd(buffer, accum);
-    return buffer[0] + buffer[1] + buffer[2] + buffer[3];
-}
-#else
-struct WeightRegisters {
-    const double *weights = nullptr;
-};
-
-WeightRegisters load_weight_registers(const double *weights) {
-    return WeightRegisters{weights};
-}
-
-double dot_product(const WeightRegisters &regs, const int *counts) {
-    double sum = 0.0;
-    for (std::size_t idx = 0; idx < kFeatureCount; ++idx) {
-        sum += regs.weights[idx] * static_cast<double>(counts[idx]);
-    }
-    return sum;
-}
-#endif
 
 
 
@@ -140,6 +57,8 @@ bool apply_sirio_nnue2_minimal_feature_lists(
     const std::vector<SparseFeature> &black_added,
     SirioNNUE2MinimalAccumulator &accumulator, std::string &error_message) {
     auto updated_hidden = accumulator.hidden_pre_activation;
+    const auto input_weights = network.input_weights_view();
+    const cpu::AccumulateRowFn accumulate_row = cpu::kernels().accumulate_row;
     const auto apply_list = [&](const std::vector<SparseFeature> &features, std::int32_t sign) -> bool {
         for (const SparseFeature &feature : features) {
             if (feature.index >= layout.features_per_perspective) {
@@ -147,10 +66,8 @@ bool apply_sirio_nnue2_minimal_feature_lists(
                 return false;
             }
             const std::size_t row_offset = static_cast<std::size_t>(feature.index) * layout.hidden1_size;
-            for (std::size_t h = 0; h < layout.hidden1_size; ++h) {
-                updated_hidden[h] += sign * static_cast<std::int32_t>(network.input_weights[row_offset + h]) *
-                                     static_cast<std::int32_t>(feature.value);
-            }
+            accumulate_row(updated_hidden.data(), input_weights.data() + row_offset, layout.hidden1_size,
+                           sign * static_cast<std::int32_t>(feature.value));
         }
         return true;
     };
@@ -193,9 +110,21 @@ std::size_t SparseFeatureState::total_active_features() const {
     return total;
 }
 
+std::span<const std::int16_t> Nnue2NetworkParameters::input_weights_view() const {
+    return is_borrowed() ? borrowed_input_weights : std::span<const std::int16_t>{input_weights};
+}
+
+std::span<const std::int16_t> Nnue2NetworkParameters::hidden_bias_view() const {
+    return is_borrowed() ? borrowed_hidden_bias : std::span<const std::int16_t>{hidden_bias};
+}
+
+std::span<const std::int16_t> Nnue2NetworkParameters::output_weights_view() const {
+    return is_borrowed() ? borrowed_output_weights : std::span<const std::int16_t>{output_weights};
+}
+
 bool Nnue2NetworkParameters::is_initialized() const {
-    return is_valid_nnue2_header(header) && !input_weights.empty() && !hidden_bias.empty() &&
-           !output_weights.empty();
+    return is_valid_nnue2_header(header) && !input_weights_view().empty() &&
+           !hidden_bias_view().empty() && !output_weights_view().empty();
 }
 
 void Nnue2NetworkParameters::clear() {
@@ -204,6 +133,9 @@ void Nnue2NetworkParameters::clear() {
     hidden_bias.clear();
     output_weights.clear();
     output_bias = 0;
+    borrowed_input_weights = {};
+    borrowed_hidden_bias = {};
+    borrowed_output_weights = {};
 }
 
 bool is_valid_nnue2_header(const Nnue2BinaryHeader &header) {
@@ -293,6 +225,51 @@ bool load_nnue2_network_file(const std::string &path, Nnue2NetworkParameters &ou
     return true;
 }
 
+bool map_nnue2_network_memory(std::span<const std::byte> bytes, Nnue2NetworkParameters &out_network,
+                              std::string &error_message) {
+    out_network.clear();
+    Nnue2BinaryHeader header{};
+    if (bytes.size() < sizeof(header)) {
+        error_message = "Truncated SirioNNUE2 header";
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (!is_valid_nnue2_header(header)) {
+        error_message = "Invalid SirioNNUE2 header contract";
+        return false;
+    }
+    const std::size_t expected = sizeof(header) + static_cast<std::size_t>(header.payload_bytes);
+    if (bytes.size() < expected) {
+        error_message = "Truncated SirioNNUE2 payload";
+        return false;
+    }
+    if (bytes.size() > expected) {
+        error_message = "Unexpected trailing bytes in SirioNNUE2 file";
+        return false;
+    }
+    if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(std::int16_t) != 0 ||
+        header.input_weights_bytes % sizeof(std::int16_t) != 0 ||
+        header.hidden_bias_bytes % sizeof(std::int16_t) != 0 ||
+        header.output_weights_bytes % sizeof(std::int16_t) != 0 ||
+        header.output_bias_bytes != sizeof(std::int32_t)) {
+        error_message = "SirioNNUE2 image is not aligned for in-place use";
+        return false;
+    }
+
+    const std::byte *cursor = bytes.data() + sizeof(header);
+    const auto take = [&cursor](std::uint32_t section_bytes) {
+        const auto *values = reinterpret_cast<const std::int16_t *>(cursor);
+        cursor += section_bytes;
+        return std::span<const std::int16_t>{values, section_bytes / sizeof(std::int16_t)};
+    };
+    out_network.header = header;
+    out_network.borrowed_input_weights = take(header.input_weights_bytes);
+    out_network.borrowed_hidden_bias = take(header.hidden_bias_bytes);
+    out_network.borrowed_output_weights = take(header.output_weights_bytes);
+    std::memcpy(&out_network.output_bias, cursor, sizeof(out_network.output_bias));
+    return true;
+}
+
 bool decode_nnue2_minimal_layout(const Nnue2NetworkParameters &network,
                                  Nnue2MinimalDecodedLayout &out_layout,
                                  std::string &error_message) {
@@ -318,10 +295,10 @@ bool decode_nnue2_minimal_layout(const Nnue2NetworkParameters &network,
         error_message = "SirioNNUE2-MinimalV1 dimensions do not match required contract";
         return false;
     }
-    if (network.input_weights.size() !=
+    if (network.input_weights_view().size() !=
             static_cast<std::size_t>(out_layout.features_per_perspective) * out_layout.hidden1_size ||
-        network.hidden_bias.size() != out_layout.hidden1_size ||
-        network.output_weights.size() != out_layout.hidden1_size) {
+        network.hidden_bias_view().size() != out_layout.hidden1_size ||
+        network.output_weights_view().size() != out_layout.hidden1_size) {
         error_message = "SirioNNUE2-MinimalV1 tensor payload size mismatch";
         return false;
     }
@@ -343,9 +320,12 @@ bool refresh_sirio_nnue2_minimal_accumulator(
         return false;
     }
 
+    const auto input_weights = network.input_weights_view();
+    const auto hidden_bias = network.hidden_bias_view();
+    const cpu::AccumulateRowFn accumulate_row = cpu::kernels().accumulate_row;
     accumulator.hidden_pre_activation.assign(layout.hidden1_size, 0);
     for (std::size_t h = 0; h < layout.hidden1_size; ++h) {
-        accumulator.hidden_pre_activation[h] = network.hidden_bias[h];
+        accumulator.hidden_pre_activation[h] = hidden_bias[h];
     }
 
     for (std::size_t perspective = 0; perspective < kNnue2PerspectiveCount; ++perspective) {
@@ -358,11 +338,8 @@ bool refresh_sirio_nnue2_minimal_accumulator(
                 return false;
             }
             const std::size_t row_offset = static_cast<std::size_t>(feature.index) * layout.hidden1_size;
-            for (std::size_t h = 0; h < layout.hidden1_size; ++h) {
-                accumulator.hidden_pre_activation[h] +=
-                    static_cast<std::int32_t>(network.input_weights[row_offset + h]) *
-                    static_cast<std::int32_t>(feature.value);
-            }
+            accumulate_row(accumulator.hidden_pre_activation.data(), input_weights.data() + row_offset,
+                           layout.hidden1_size, static_cast<std::int32_t>(feature.value));
         }
     }
     accumulator.valid = true;
@@ -463,11 +440,10 @@ bool evaluate_sirio_nnue2_minimal_accumulator(
         return false;
     }
 
-    std::int64_t output_accum = network.output_bias;
-    for (std::size_t h = 0; h < layout.hidden1_size; ++h) {
-        const std::int32_t activated = std::max<std::int32_t>(0, accumulator.hidden_pre_activation[h]);
-        output_accum += static_cast<std::int64_t>(activated) * network.output_weights[h];
-    }
+    const auto output_weights = network.output_weights_view();
+    std::int64_t output_accum =
+        network.output_bias + cpu::kernels().relu_dot(accumulator.hidden_pre_activation.data(),
+                                                      output_weights.data(), layout.hidden1_size);
     apply_sirio_nnue2_minimal_test_quantization(network, output_accum);
     out_score = static_cast<std::int32_t>(output_accum);
     return true;
@@ -678,8 +654,8 @@ int SingleNetworkBackend::evaluate_state(const FeatureState &state) const {
     _mm_prefetch(reinterpret_cast<const char *>(params_.piece_weights.data()), _MM_HINT_T0);
 #endif
 
-    const WeightRegisters regs = load_weight_registers(params_.piece_weights.data());
-    double value = params_.bias + dot_product(regs, state.piece_counts.data());
+    double value = params_.bias + cpu::kernels().dot_weights(params_.piece_weights.data(),
+                                                             state.piece_counts.data(), kFeatureCount);
     value *= params_.scale;
     return static_cast<int>(std::lround(value));
 }
@@ -694,7 +670,7 @@ void SingleNetworkBackend::evaluate_batch(std::span<const FeatureState> states,
         return;
     }
 
-    const WeightRegisters regs = load_weight_registers(params_.piece_weights.data());
+    const cpu::DotWeightsFn dot_weights = cpu::kernels().dot_weights;
     for (std::size_t index = 0; index < states.size(); ++index) {
         const FeatureState &state = states[index];
 #if defined(__GNUC__) || defined(__clang__)
@@ -702,7 +678,8 @@ void SingleNetworkBackend::evaluate_batch(std::span<const FeatureState> states,
 #elif defined(_MSC_VER)
         _mm_prefetch(reinterpret_cast<const char *>(state.piece_counts.data()), _MM_HINT_T0);
 #endif
-        double value = params_.bias + dot_product(regs, state.piece_counts.data());
+        double value = params_.bias +
+                       dot_weights(params_.piece_weights.data(), state.piece_counts.data(), kFeatureCount);
         value *= params_.scale;
         out[index] = static_cast<int>(std::lround(value));
     }
@@ -0,0 +1,80 @@
+#include "sirio/nnue/backend.hpp"
+
+#include <cstddef>
+#include <string>
+
+#if defined(SIRIO_EMBEDDED_NETWORK_FILE)
+// incbin-style embedding: the assembler copies the network file verbatim into a read-only,
+// cache-line aligned section. The weights are then used in place, straight from the executable's
+// pages, which every running instance shares.
+#if defined(__APPLE__)
+#define SIRIO_EMBED_SECTION ".const_data\n"
+#define SIRIO_EMBED_SYMBOL(name) "_" #name
+#elif defined(_WIN32)
+#define SIRIO_EMBED_SECTION ".section .rdata,\"dr\"\n"
+#define SIRIO_EMBED_SYMBOL(name) #name
+#else
+#define SIRIO_EMBED_SECTION ".section .rodata\n"
+#define SIRIO_EMBED_SYMBOL(name) #name
+#endif
+
+__asm__(SIRIO_EMBED_SECTION
+        ".balign 64\n"
+        ".globl " SIRIO_EMBED_SYMBOL(sirio_embedded_network_begin) "\n"
+        SIRIO_EMBED_SYMBOL(sirio_embedded_network_begin) ":\n"
+        ".incbin \"" SIRIO_EMBEDDED_NETWORK_FILE "\"\n"
+        ".globl " SIRIO_EMBED_SYMBOL(sirio_embedded_network_end) "\n"
+        SIRIO_EMBED_SYMBOL(sirio_embedded_network_end) ":\n"
+        ".text\n");
+
+extern "C" const unsigned char sirio_embedded_network_begin[];
+extern "C" const unsigned char sirio_embedded_network_end[];
+#endif
+
+namespace sirio::nnue {
+
+namespace {
+
+struct EmbeddedNetwork {
+    Nnue2NetworkParameters network{};
+    bool valid = false;
+    std::string error;
+};
+
+const EmbeddedNetwork &embedded() {
+    static const EmbeddedNetwork instance = [] {
+        EmbeddedNetwork result;
+        const auto image = embedded_network_image();
+        if (image.empty()) {
+            result.error = "No network embedded in this build";
+            return result;
+        }
+        result.valid = map_nnue2_network_memory(image, result.network, result.error);
+        return result;
+    }();
+    return instance;
+}
+
+}  // namespace
+
+std::span<const std::byte> embedded_network_image() {
+#if defined(SIRIO_EMBEDDED_NETWORK_FILE)
+    return {reinterpret_cast<const std::byte *>(sirio_embedded_network_begin),
+            static_cast<std::size_t>(sirio_embedded_network_end - sirio_embedded_network_begin)};
+#else
+    return {};
+#endif
+}
+
+const Nnue2NetworkParameters *embedded_network(std::string *error_message) {
+    const EmbeddedNetwork &instance = embedded();
+    if (!instance.valid) {
+        if (error_message) {
+            *error_message = instance.error;
+        }
+        return nullptr;
+    }
+    return &instance.network;
+}
+
+}  // namespace sirio::nnue
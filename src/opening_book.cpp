@@ -10,7 +10,6 @@
 #include <optional>
 #include <random>
 #include <system_error>
-#include <sstream>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -49,15 +48,29 @@ std::string trim(std::string_view view) {
     return std::string{view.substr(start, end - start)};
 }
 
-std::string normalize_fen_key(const std::string &fen) {
-    std::istringstream stream{fen};
-    std::string fields[4];
-    for (int i = 0; i < 4; ++i) {
-        if (!(stream >> fields[i])) {
+// The first four FEN fields: the book ignores the move counters.
+std::string normalize_fen_key(std::string_view fen) {
+    std::string key;
+    key.reserve(fen.size());
+    for (int field = 0; field < 4; ++field) {
+        std::size_t start = 0;
+        while (start < fen.size() && std::isspace(static_cast<unsigned char>(fen[start]))) {
+            ++start;
+        }
+        std::size_t end = start;
+        while (end < fen.size() && !std::isspace(static_cast<unsigned char>(fen[end]))) {
+            ++end;
+        }
+        if (end == start) {
             return {};
         }
+        if (field > 0) {
+            key += ' ';
+        }
+        key.append(fen.substr(start, end - start));
+        fen.remove_prefix(end);
     }
-    return fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3];
+    return key;
 }
 
 }  // namespace
@@ -183,7 +196,8 @@ bool is_loaded() {
 }
 
 std::optional<Move> choose_move(const Board &board) {
-    std::string key = normalize_fen_key(board.to_fen());
+    char fen[Board::max_fen_length];
+    std::string key = normalize_fen_key(std::string_view{fen, board.write_fen(fen, sizeof(fen))});
     std::string selected_move;
     {
         std::lock_guard lock(g_mutex);
@@ -0,0 +1,448 @@
+#include "sirio/pgn.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sirio::pgn {
+
+namespace {
+
+constexpr std::string_view kStartPosition =
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+constexpr std::string_view kGameStart = "[Event ";
+// Chunks smaller than this cost more in scheduling than they gain in balance.
+constexpr std::size_t kMinChunkBytes = std::size_t{1} << 20;
+// Chunks per worker, so a run of long games in one chunk does not leave the others idle.
+constexpr std::size_t kChunksPerThread = 16;
+
+bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+bool is_token_end(char c) {
+    return is_space(c) || c == '{' || c == '}' || c == '(' || c == ')' || c == ';' || c == '[';
+}
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+std::optional<GameResult> parse_result(std::string_view text) {
+    if (text == "1-0") {
+        return GameResult::WhiteWins;
+    }
+    if (text == "0-1") {
+        return GameResult::BlackWins;
+    }
+    if (text == "1/2-1/2") {
+        return GameResult::Draw;
+    }
+    if (text == "*") {
+        return GameResult::Unknown;
+    }
+    return std::nullopt;
+}
+
+// Offset of the next line starting with "[Event " at or after `from`; text.size() when none.
+std::size_t next_game_start(std::string_view text, std::size_t from) {
+    for (std::size_t pos = text.find(kGameStart, from); pos != std::string_view::npos;
+         pos = text.find(kGameStart, pos + 1)) {
+        if (pos == 0 || text[pos - 1] == '\n') {
+            return pos;
+        }
+    }
+    return text.size();
+}
+
+class ChunkParser {
+public:
+    ChunkParser(std::string_view text, const Visitor &visitor, unsigned thread, ReadStats &stats)
+        : text_(text), visitor_(visitor), thread_(thread), stats_(stats) {}
+
+    void parse(std::size_t begin, std::size_t end) {
+        pos_ = begin;
+        end_ = end;
+        while (true) {
+            while (pos_ < end_ && is_space(text_[pos_])) {
+                ++pos_;
+            }
+            if (pos_ >= end_) {
+                break;
+            }
+            const char c = text_[pos_];
+            if (c == '%' && (pos_ == 0 || text_[pos_ - 1] == '\n')) {
+                skip_line();
+                continue;
+            }
+            if (c == '[') {
+                if (in_movetext_) {
+                    finish_game();
+                }
+                if (!in_game_) {
+                    start_game();
+                }
+                parse_tag();
+                continue;
+            }
+            if (!in_game_) {
+                start_game();
+            }
+            if (!in_movetext_) {
+                begin_movetext();
+            }
+            switch (c) {
+                case '{':
+                    skip_comment();
+                    continue;
+                case ';':
+                    skip_line();
+                    continue;
+                case '(':
+                    skip_variation();
+                    continue;
+                case ')':
+                case '}':
+                    ++pos_;
+                    continue;
+                case '$':
+                    ++pos_;
+                    while (pos_ < end_ && is_digit(text_[pos_])) {
+                        ++pos_;
+                    }
+                    continue;
+                default:
+                    break;
+            }
+            parse_token();
+        }
+        if (in_game_) {
+            finish_game();
+        }
+    }
+
+private:
+    void start_game() {
+        in_game_ = true;
+        game_.offset = pos_;
+    }
+
+    void begin_movetext() {
+        in_movetext_ = true;
+        if (auto result = parse_result(game_.tag("Result"))) {
+            game_.result = *result;
+        }
+        const std::string_view fen = game_.tag("FEN");
+        if (board_.parse_fen(fen.empty() ? kStartPosition : fen) != FenError::None) {
+            game_.error = fen;
+        }
+    }
+
+    void finish_game() {
+        ++stats_.games;
+        if (!game_.error.empty()) {
+            ++stats_.errors;
+        }
+        if (visitor_.on_game) {
+            visitor_.on_game(game_, thread_);
+        }
+        game_.tags.clear();
+        game_.moves.clear();
+        game_.result = GameResult::Unknown;
+        game_.error = {};
+        in_game_ = false;
+        in_movetext_ = false;
+    }
+
+    void parse_tag() {
+        ++pos_;
+        skip_blanks();
+        const std::size_t name_start = pos_;
+        while (pos_ < end_ && !is_space(text_[pos_]) && text_[pos_] != '"' && text_[pos_] != ']') {
+            ++pos_;
+        }
+        const std::string_view name = text_.substr(name_start, pos_ - name_start);
+        skip_blanks();
+        std::string_view value;
+        if (pos_ < end_ && text_[pos_] == '"') {
+            const std::size_t value_start = ++pos_;
+            while (pos_ < end_ && text_[pos_] != '"' && text_[pos_] != '\n') {
+                pos_ += text_[pos_] == '\\' ? 2 : 1;
+            }
+            pos_ = std::min(pos_, end_);
+            value = text_.substr(value_start, pos_ - value_start);
+        }
+        while (pos_ < end_ && text_[pos_] != ']' && text_[pos_] != '\n') {
+            ++pos_;
+        }
+        if (pos_ < end_ && text_[pos_] == ']') {
+            ++pos_;
+        }
+        if (!name.empty()) {
+            game_.tags.emplace_back(name, value);
+        }
+    }
+
+    void parse_token() {
+        const std::size_t start = pos_;
+        while (pos_ < end_ && !is_token_end(text_[pos_])) {
+            ++pos_;
+        }
+        const std::string_view token = text_.substr(start, pos_ - start);
+
+        if (auto result = parse_result(token)) {
+            if (game_.result == GameResult::Unknown) {
+                game_.result = *result;
+            }
+            finish_game();
+            return;
+        }
+        // Move numbers ("12.", "12...") may be glued to the move that follows ("1.e4").
+        if (is_digit(token.front()) && token.rfind("0-0", 0) != 0) {
+            std::size_t skip = 0;
+            while (skip < token.size() && is_digit(token[skip])) {
+                ++skip;
+            }
+            if (skip < token.size() && token[skip] != '.') {
+                return;
+            }
+            while (skip < token.size() && token[skip] == '.') {
+                ++skip;
+            }
+            pos_ = start + skip;
+            return;
+        }
+        if (token.front() == '.') {
+            std::size_t skip = 0;
+            while (skip < token.size() && token[skip] == '.') {
+                ++skip;
+            }
+            pos_ = start + skip;
+            return;
+        }
+        play(token);
+    }
+
+    void play(std::string_view san) {
+        if (!game_.error.empty()) {
+            return;
+        }
+        const auto move = move_from_san(board_, san);
+        if (!move) {
+            game_.error = san;
+            return;
+        }
+        if (visitor_.on_position) {
+            visitor_.on_position(game_, board_, *move, thread_);
+        }
+        board_.make_move(*move, undo_);
+        game_.moves.push_back(*move);
+        ++stats_.moves;
+    }
+
+    void skip_blanks() {
+        while (pos_ < end_ && (text_[pos_] == ' ' || text_[pos_] == '\t')) {
+            ++pos_;
+        }
+    }
+
+    void skip_line() {
+        const std::size_t newline = text_.find('\n', pos_);
+        pos_ = newline == std::string_view::npos ? end_ : std::min(newline + 1, end_);
+    }
+
+    void skip_comment() {
+        const std::size_t close = text_.find('}', pos_);
+        pos_ = close == std::string_view::npos ? end_ : std::min(close + 1, end_);
+    }
+
+    void skip_variation() {
+        int depth = 0;
+        while (pos_ < end_) {
+            const char c = text_[pos_];
+            if (c == '{') {
+                skip_comment();
+                continue;
+            }
+            if (c == ';') {
+                skip_line();
+                continue;
+            }
+            ++pos_;
+            if (c == '(') {
+                ++depth;
+            } else if (c == ')' && --depth == 0) {
+                return;
+            }
+        }
+    }
+
+    std::string_view text_;
+    const Visitor &visitor_;
+    unsigned thread_;
+    ReadStats &stats_;
+    Game game_;
+    Board board_;
+    Board::UndoState undo_;
+    std::size_t pos_ = 0;
+    std::size_t end_ = 0;
+    bool in_game_ = false;
+    bool in_movetext_ = false;
+};
+
+}  // namespace
+
+std::string_view Game::tag(std::string_view name) const {
+    for (const auto &[key, value] : tags) {
+        if (key == name) {
+            return value;
+        }
+    }
+    return {};
+}
+
+PgnFile::~PgnFile() { close(); }
+
+bool PgnFile::open(const std::string &path, std::string *error) {
+    close();
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (error != nullptr) {
+            *error = "No se pudo abrir el fichero PGN: " + path;
+        }
+        return false;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        if (error != nullptr) {
+            *error = "No se pudo leer el tamaño del fichero PGN: " + path;
+        }
+        return false;
+    }
+    const auto length = static_cast<std::size_t>(info.st_size);
+    if (length == 0) {
+        ::close(fd);
+        return true;
+    }
+    void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        if (error != nullptr) {
+            *error = "No se pudo mapear el fichero PGN: " + path;
+        }
+        return false;
+    }
+    // The workers read disjoint chunks at once; let the kernel fetch the whole file ahead.
+    madvise(address, length, MADV_WILLNEED);
+    data_ = static_cast<const char *>(address);
+    size_ = length;
+    mapped_ = true;
+    return true;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        if (error != nullptr) {
+            *error = "No se pudo abrir el fichero PGN: " + path;
+        }
+        return false;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return true;
+#endif
+}
+
+void PgnFile::close() {
+#if !defined(_WIN32)
+    if (mapped_) {
+        munmap(const_cast<char *>(data_), size_);
+    }
+#endif
+    buffer_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+ReadStats read_games(std::string_view text, const Visitor &visitor, unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    const std::size_t start = text.rfind("\xEF\xBB\xBF", 0) == 0 ? 3 : 0;
+
+    // Chunk boundaries are game starts, so every game is parsed whole by one worker.
+    std::vector<std::size_t> bounds{start};
+    const std::size_t chunk_bytes =
+        std::max(kMinChunkBytes, text.size() / (threads * kChunksPerThread) + 1);
+    for (std::size_t target = start + chunk_bytes; target < text.size();
+         target = bounds.back() + chunk_bytes) {
+        const std::size_t next = next_game_start(text, target);
+        if (next >= text.size()) {
+            break;
+        }
+        bounds.push_back(next);
+    }
+    bounds.push_back(text.size());
+    const std::size_t chunks = bounds.size() - 1;
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, chunks));
+
+    std::vector<ReadStats> per_thread(threads);
+    std::atomic<std::size_t> next_chunk{0};
+    std::atomic<bool> stop{false};
+    std::mutex failure_mutex;
+    std::exception_ptr failure;
+    auto work = [&](unsigned thread) {
+        try {
+            ChunkParser parser{text, visitor, thread, per_thread[thread]};
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::size_t index = next_chunk.fetch_add(1, std::memory_order_relaxed);
+                if (index >= chunks) {
+                    break;
+                }
+                parser.parse(bounds[index], bounds[index + 1]);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            stop.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    // Even a single worker gets its own thread: the caller's evaluation notifications, if enabled,
+    // would otherwise track every replayed move.
+    std::vector<std::thread> workers;
+    for (unsigned thread = 0; thread < threads; ++thread) {
+        workers.emplace_back(work, thread);
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    ReadStats total;
+    for (const ReadStats &stats : per_thread) {
+        total.games += stats.games;
+        total.moves += stats.moves;
+        total.errors += stats.errors;
+    }
+    total.bytes = text.size();
+    total.threads = threads;
+    return total;
+}
+
+}  // namespace sirio::pgn
@@ -25,7 +25,9 @@
 
 #include "engine/work_queue_watchdog.hpp"
 
+#include "sirio/analysis_store.hpp"
 #include "sirio/draws.hpp"
+#include "sirio/engine.hpp"
 #include "sirio/endgame.hpp"
 #include "sirio/history.hpp"
 #include "sirio/evaluation.hpp"
@@ -49,34 +51,120 @@ enum class SearchNodeKind {
 
 
 
-int late_move_reduction_base(int depth, int move_index) {
+using LateMoveReductionTable =
+    std::array<std::array<int, search_params::max_lmr_moves>, search_params::max_lmr_depth>;
+
+// One table per diversity divisor; thread profiles pick theirs by index.
+int late_move_reduction_base(int depth, int move_index, int variant = 0) {
     depth = std::clamp(depth, 0, search_params::max_lmr_depth - 1);
     move_index = std::clamp(move_index, 0, search_params::max_lmr_moves - 1);
-    static const std::array<std::array<int, search_params::max_lmr_moves>, search_params::max_lmr_depth> table = [] {
-        std::array<std::array<int, search_params::max_lmr_moves>, search_params::max_lmr_depth> result{};
-        for (int d = 0; d < search_params::max_lmr_depth; ++d) {
-            for (int m = 0; m < search_params::max_lmr_moves; ++m) {
-                if (d == 0 || m == 0) {
-                    result[d][m] = 0;
-                    continue;
+    static const auto tables = [] {
+        std::array<LateMoveReductionTable, search_params::smp_lmr_divisors.size()> result{};
+        for (std::size_t v = 0; v < result.size(); ++v) {
+            for (int d = 0; d < search_params::max_lmr_depth; ++d) {
+                for (int m = 0; m < search_params::max_lmr_moves; ++m) {
+                    if (d == 0 || m == 0) {
+                        result[v][d][m] = 0;
+                        continue;
+                    }
+                    const double depth_factor = std::log(static_cast<double>(d + 1));
+                    const double move_factor = std::log(static_cast<double>(m + 1));
+                    const double reduction =
+                        (depth_factor * move_factor) / search_params::smp_lmr_divisors[v];
+                    result[v][d][m] = reduction < 0.0 ? 0 : static_cast<int>(std::round(reduction));
                 }
-                const double depth_factor = std::log(static_cast<double>(d + 1));
-                const double move_factor = std::log(static_cast<double>(m + 1));
-                const double reduction = (depth_factor * move_factor) / 1.95;
-                result[d][m] = reduction < 0.0 ? 0 : static_cast<int>(std::round(reduction));
             }
         }
         return result;
     }();
-    return table[depth][move_index];
+    return tables[static_cast<std::size_t>(variant)][depth][move_index];
 }
 
-std::atomic<int> search_thread_count{1};
+// How a Lazy SMP thread departs from the plain search so the threads' trees overlap less. The
+// primary thread, and every thread when diversity is disabled, uses the default profile.
+struct ThreadDiversityProfile {
+    int lmr_variant = 0;
+    int null_move_r_delta = 0;
+    // Root moves after the first are rotated left by this many places each iteration.
+    int root_move_rotation = 0;
+    // Iterations are skipped in blocks of skip_size depths; 0 searches every depth.
+    int skip_size = 0;
+    int skip_phase = 0;
+
+    [[nodiscard]] bool skips_depth(int depth) const {
+        return skip_size > 0 && ((depth + skip_phase) / skip_size) % 2 != 0;
+    }
+};
+
+ThreadDiversityProfile make_diversity_profile(int thread_index) {
+    ThreadDiversityProfile profile;
+    if (thread_index <= 0) {
+        return profile;
+    }
+    const auto index = static_cast<std::size_t>(thread_index);
+    profile.lmr_variant = static_cast<int>(index % search_params::smp_lmr_divisors.size());
+    profile.null_move_r_delta =
+        search_params::smp_null_move_r_deltas[(index / 2) % search_params::smp_null_move_r_deltas.size()];
+    if (index % 2 == 1) {
+        profile.root_move_rotation = 1 + thread_index / 2;
+    }
+    const std::size_t skip_index = (index - 1) % search_params::smp_skip_size.size();
+    profile.skip_size = search_params::smp_skip_size[skip_index];
+    profile.skip_phase = search_params::smp_skip_phase[skip_index];
+    return profile;
+}
 
-std::mutex active_search_mutex;
-SearchSharedState *active_search_state = nullptr;
 std::atomic_flag info_output_flag = ATOMIC_FLAG_INIT;
-std::atomic<bool> stop_requested_pending{false};
+
+// ABDADA-style "currently searching" table shared by the Lazy SMP threads. A slot packs the upper
+// bits of a node key with the id (1-255) of the thread searching it. A node whose slot is taken is
+// simply not advertised, so the table needs no locking and a collision costs at most a missed
+// deferral.
+class SearchingTable {
+public:
+    class Entry {
+    public:
+        Entry(SearchingTable *table, std::uint64_t key, std::uint64_t thread_id)
+            : slot_(table != nullptr ? table->enter(key, thread_id) : nullptr) {}
+        ~Entry() {
+            if (slot_ != nullptr) {
+                slot_->store(0, std::memory_order_release);
+            }
+        }
+        Entry(const Entry &) = delete;
+        Entry &operator=(const Entry &) = delete;
+
+    private:
+        std::atomic<std::uint64_t> *slot_;
+    };
+
+    [[nodiscard]] bool searched_by_other(std::uint64_t key, std::uint64_t thread_id) const {
+        const std::uint64_t value = slot(key).load(std::memory_order_relaxed);
+        return value != 0 && (value & kKeyMask) == (key & kKeyMask) && (value & ~kKeyMask) != thread_id;
+    }
+
+private:
+    static constexpr std::uint64_t kKeyMask = ~std::uint64_t{0xFF};
+
+    std::atomic<std::uint64_t> *enter(std::uint64_t key, std::uint64_t thread_id) {
+        std::atomic<std::uint64_t> &target = slot(key);
+        std::uint64_t expected = 0;
+        if (target.compare_exchange_strong(expected, (key & kKeyMask) | thread_id,
+                                           std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return &target;
+        }
+        return nullptr;
+    }
+
+    std::atomic<std::uint64_t> &slot(std::uint64_t key) {
+        return slots_[key & (search_params::smp_searching_table_size - 1)];
+    }
+    const std::atomic<std::uint64_t> &slot(std::uint64_t key) const {
+        return slots_[key & (search_params::smp_searching_table_size - 1)];
+    }
+
+    std::array<std::atomic<std::uint64_t>, search_params::smp_searching_table_size> slots_{};
+};
 
 
 
@@ -87,6 +175,21 @@ struct SearchSharedState {
     std::atomic<std::uint64_t> node_counter{0};
     std::atomic<std::uint64_t> main_nodes{0};
     std::atomic<std::uint64_t> quiescence_nodes{0};
+    std::atomic<std::uint64_t> reverse_futility_cutoffs{0};
+    std::atomic<std::uint64_t> move_count_prunes{0};
+    std::atomic<std::uint64_t> null_move_cutoffs{0};
+    std::atomic<std::uint64_t> null_move_verifications{0};
+    std::atomic<std::uint64_t> null_move_verification_failures{0};
+    std::atomic<std::uint64_t> null_move_tt_skips{0};
+    std::atomic<std::uint64_t> mate_distance_prunes{0};
+    std::atomic<std::uint64_t> zero_window_searches{0};
+    std::atomic<std::uint64_t> lmr_reductions{0};
+    std::atomic<std::uint64_t> lmr_reduction_plies{0};
+    std::atomic<std::uint64_t> lmr_researches{0};
+    std::atomic<std::uint64_t> lmr_research_nodes{0};
+    std::atomic<std::uint64_t> pvs_researches{0};
+    std::atomic<std::uint64_t> pvs_research_nodes{0};
+    std::atomic<std::uint64_t> smp_deferrals{0};
     std::atomic<int> background_tasks{0};
     bool has_time_limit = false;
     bool has_node_limit = false;
@@ -108,6 +211,16 @@ struct SearchSharedState {
     std::vector<SearchEventRecord> event_log;
     bool has_last_event = false;
     std::chrono::steady_clock::time_point last_event_timestamp{};
+    std::function<void(const SearchResult &)> info_callback;
+    bool uci_output = true;
+    bool smp_diversity = true;
+    int multi_pv = 1;
+    std::vector<Move> search_moves;
+    // Clock-based searches let the best move's share of the root nodes scale the soft limit.
+    bool node_fraction_time = false;
+    std::chrono::steady_clock::time_point entry_time{};
+    std::chrono::steady_clock::time_point first_node_time{};
+    SearchingTable searching;
 
     void start_background_tasks(int count) {
         {
@@ -271,6 +384,154 @@ struct SearchSharedState {
     }
 };
 
+bool same_move(const Move &lhs, const Move &rhs);
+
+constexpr int kRootScoreNone = std::numeric_limits<int>::min();
+
+// A legal root move with what the searching thread has learned about it so far. Only moves that
+// raise alpha (or the first move searched) get a score; the rest are reset to kRootScoreNone, so
+// they sort after every scored move and among themselves by the nodes spent on them.
+struct RootMove {
+    explicit RootMove(const Move &root_move) : move(root_move) {}
+
+    Move move;
+    int score = kRootScoreNone;
+    int previous_score = kRootScoreNone;
+    // Nodes searched below this move, summed over every iteration.
+    std::uint64_t nodes = 0;
+    // Line and selective depth of the search that last gave the move a score; the PV starts with
+    // the move itself.
+    std::vector<Move> principal_variation;
+    int selective_depth = 0;
+};
+
+// Per-thread root move list. The search walks it in order, so re-sorting it after each iteration
+// (by score, then by effort) gives the next iteration its move ordering.
+class RootMoves {
+public:
+    RootMoves() = default;
+
+    // `legal` is every legal root move in the order the first iteration should try them.
+    RootMoves(const std::vector<Move> &legal, const std::vector<Move> &search_moves) {
+        for (const Move &move : legal) {
+            const bool requested =
+                search_moves.empty() ||
+                std::any_of(search_moves.begin(), search_moves.end(),
+                            [&](const Move &candidate) { return same_move(candidate, move); });
+            if (requested) {
+                moves_.emplace_back(move);
+            }
+        }
+        // Moves that are not legal here are ignored; if none remain, every legal move is searched.
+        restricted_ = !moves_.empty() && moves_.size() < legal.size();
+        if (moves_.empty()) {
+            for (const Move &move : legal) {
+                moves_.emplace_back(move);
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return moves_.size(); }
+    [[nodiscard]] bool empty() const { return moves_.empty(); }
+    // True when `go searchmoves` left out some legal moves.
+    [[nodiscard]] bool restricted() const { return restricted_; }
+    RootMove &operator[](std::size_t index) { return moves_[index]; }
+    const RootMove &operator[](std::size_t index) const { return moves_[index]; }
+
+    RootMove *find(const Move &move) {
+        for (RootMove &root_move : moves_) {
+            if (same_move(root_move.move, move)) {
+                return &root_move;
+            }
+        }
+        return nullptr;
+    }
+
+    void begin_iteration() {
+        for (RootMove &root_move : moves_) {
+            root_move.previous_score = root_move.score;
+            root_move.score = kRootScoreNone;
+        }
+    }
+
+    // Stable, so moves without a score this iteration stay in last iteration's order.
+    void sort(std::size_t first, std::size_t last) {
+        last = std::min(last, moves_.size());
+        if (first >= last) {
+            return;
+        }
+        std::stable_sort(moves_.begin() + static_cast<std::ptrdiff_t>(first),
+                         moves_.begin() + static_cast<std::ptrdiff_t>(last),
+                         [](const RootMove &lhs, const RootMove &rhs) {
+                             if (lhs.score != rhs.score) {
+                                 return lhs.score > rhs.score;
+                             }
+                             return lhs.nodes > rhs.nodes;
+                         });
+    }
+
+    void sort_from(std::size_t first) { sort(first, moves_.size()); }
+
+    void rotate_from(std::size_t first, int places) {
+        if (places <= 0 || first + 1 >= moves_.size()) {
+            return;
+        }
+        const std::size_t span = moves_.size() - first;
+        const std::size_t shift = static_cast<std::size_t>(places) % span;
+        std::rotate(moves_.begin() + static_cast<std::ptrdiff_t>(first),
+                    moves_.begin() + static_cast<std::ptrdiff_t>(first + shift), moves_.end());
+    }
+
+    [[nodiscard]] std::uint64_t total_nodes() const {
+        std::uint64_t total = 0;
+        for (const RootMove &root_move : moves_) {
+            total += root_move.nodes;
+        }
+        return total;
+    }
+
+private:
+    std::vector<RootMove> moves_;
+    bool restricted_ = false;
+};
+
+// Triangular PV table: row `ply` holds the best line found so far at the node being searched at
+// that ply. A node clears its row on entry and, when a move raises alpha at a PV node, copies the
+// move followed by its child's row, so the root reads each move's line from row 1.
+class PrincipalVariationTable {
+public:
+    void clear(int ply) {
+        if (ply < kPlies) {
+            length_[static_cast<std::size_t>(ply)] = 0;
+        }
+    }
+
+    void update(int ply, const Move &move) {
+        if (ply + 1 >= kPlies) {
+            return;
+        }
+        Move *row = &moves_[static_cast<std::size_t>(ply * kPlies)];
+        const Move *child = &moves_[static_cast<std::size_t>((ply + 1) * kPlies)];
+        const int child_length = length_[static_cast<std::size_t>(ply + 1)];
+        row[0] = move;
+        std::copy(child, child + child_length, row + 1);
+        length_[static_cast<std::size_t>(ply)] = child_length + 1;
+    }
+
+    void append_line(int ply, std::vector<Move> &line) const {
+        if (ply >= kPlies) {
+            return;
+        }
+        const Move *row = &moves_[static_cast<std::size_t>(ply * kPlies)];
+        line.insert(line.end(), row, row + length_[static_cast<std::size_t>(ply)]);
+    }
+
+private:
+    static constexpr int kPlies = search_params::max_search_depth;
+    std::vector<Move> moves_ = std::vector<Move>(static_cast<std::size_t>(kPlies * kPlies));
+    std::array<int, kPlies> length_{};
+};
+
 struct SearchContext {
     GlobalTranspositionTable *tt = nullptr;
     std::uint8_t tt_generation = 1;
@@ -282,9 +543,16 @@ struct SearchContext {
     std::uint64_t quiescence_node_accumulator = 0;
     std::uint64_t total_nodes = 0;
     bool is_primary_thread = false;
+    // Tag in the shared searching table; 0 when this is the only search thread.
+    std::uint64_t smp_thread_id = 0;
+    ThreadDiversityProfile diversity{};
+    // Root move list searched at ply 0, from index root_pv_index on (MultiPV line being searched).
+    RootMoves *root_moves = nullptr;
+    std::size_t root_pv_index = 0;
     SearchHistory history{};
     std::array<std::optional<Board>, search_params::max_search_depth> previous_board_by_ply{};
     std::array<std::optional<Move>, search_params::max_search_depth> previous_move_by_ply{};
+    PrincipalVariationTable pv_table;
 };
 
 
@@ -375,6 +643,36 @@ void flush_thread_node_counter(SearchContext &context) {
     context.local_node_accumulator = 0;
 }
 
+void flush_thread_selectivity_counters(const SearchContext &context) {
+    if (context.shared == nullptr) {
+        return;
+    }
+    SearchSharedState &shared = *context.shared;
+    const auto &history = context.history;
+    auto add = [](std::atomic<std::uint64_t> &target, int value) {
+        if (value > 0) {
+            target.fetch_add(static_cast<std::uint64_t>(value), std::memory_order_relaxed);
+        }
+    };
+    add(shared.reverse_futility_cutoffs, history.reverse_futility_runtime_counters().return_applied);
+    add(shared.move_count_prunes, history.move_count_pruning_runtime_counters().continue_applied);
+    const auto &null_move = history.null_move_pruning_runtime_counters();
+    add(shared.null_move_cutoffs, null_move.cutoff_applied);
+    add(shared.null_move_verifications, null_move.verification_applied);
+    add(shared.null_move_verification_failures, null_move.verification_failed_applied);
+    add(shared.null_move_tt_skips, null_move.tt_skip_applied);
+    add(shared.mate_distance_prunes, history.mate_distance_runtime_counters().prune_applied);
+    const auto &research = history.research_runtime_counters();
+    add(shared.zero_window_searches, research.zero_window_applied);
+    add(shared.lmr_reductions, research.lmr_reduction_applied);
+    shared.lmr_reduction_plies.fetch_add(research.lmr_reduction_plies, std::memory_order_relaxed);
+    add(shared.lmr_researches, research.lmr_research_applied);
+    add(shared.pvs_researches, research.pvs_research_applied);
+    shared.lmr_research_nodes.fetch_add(research.lmr_research_nodes, std::memory_order_relaxed);
+    shared.pvs_research_nodes.fetch_add(research.pvs_research_nodes, std::memory_order_relaxed);
+    add(shared.smp_deferrals, history.smp_runtime_counters().deferral_applied);
+}
+
 
 }  // namespace
 
@@ -757,7 +1055,7 @@ std::optional<TTEntry> probe_transposition(GlobalTranspositionTable &tt, std::ui
         if (!entry_opt.has_value()) {
             return std::nullopt;
         }
-        if (entry_opt->generation == 0 || entry_opt->generation == expected_generation) {
+        if (tt.trusts_generation(entry_opt->generation, expected_generation)) {
             return entry_opt;
         }
     }
@@ -784,6 +1082,9 @@ std::vector<Move> extract_principal_variation(const Board &board, GlobalTranspos
     const int limit = std::min(max_length, search_params::max_search_depth);
     for (int depth = 0; depth < limit; ++depth) {
         auto entry_opt = probe_transposition(tt, current.zobrist_hash(), generation);
+        if (!entry_opt.has_value() && shared_analysis_store().enabled()) {
+            entry_opt = shared_analysis_store().probe(current.zobrist_hash());
+        }
         if (!entry_opt.has_value()) {
             break;
         }
@@ -816,27 +1117,46 @@ void announce_search_update(const Board &board, const SearchResult &result,
     if (elapsed_ms < 0) {
         elapsed_ms = 0;
     }
+    if (shared_state.info_callback) {
+        shared_state.info_callback(result);
+    }
+    if (!shared_state.uci_output) {
+        return;
+    }
     std::uint64_t nodes = shared_state.node_counter.load(std::memory_order_relaxed);
     NodeThroughputMetrics metrics = compute_node_metrics(shared_state, nodes, elapsed_ns);
     std::uint64_t nps = result.nodes_per_second > 0 ? result.nodes_per_second : metrics.nps;
     int depth = result.depth_reached;
     int seldepth = result.seldepth > 0 ? result.seldepth : depth;
-    std::string pv_string = principal_variation_to_uci(board, result.principal_variation);
+    auto print_line = [&](std::size_t index, int score, int line_seldepth,
+                          const std::vector<Move> &pv) {
+        std::string pv_string = principal_variation_to_uci(board, pv);
+        std::cout << "info depth " << depth << " seldepth " << std::max(line_seldepth, depth)
+                  << " multipv " << index
+                  << " score " << format_uci_score(score) << " nodes " << nodes << " nps " << nps
+                  << " hashfull 0 tbhits 0 time " << elapsed_ms;
+        if (!pv_string.empty()) {
+            std::cout << " pv " << pv_string;
+        }
+        std::cout << std::endl;
+    };
     TimedAtomicFlagLock lock(info_output_flag, search_params::info_output_lock_timeout);
     if (!lock.owns_lock()) {
         return;
     }
-    std::cout << "info depth " << depth << " seldepth " << seldepth << " multipv 1 score "
-              << format_uci_score(result.score) << " nodes " << nodes << " nps " << nps
-              << " hashfull 0 tbhits 0 time " << elapsed_ms;
-    if (!pv_string.empty()) {
-        std::cout << " pv " << pv_string;
+    if (result.lines.size() <= 1) {
+        print_line(1, result.score, seldepth, result.principal_variation);
+        return;
+    }
+    for (std::size_t index = 0; index < result.lines.size(); ++index) {
+        const SearchLine &line = result.lines[index];
+        print_line(index + 1, line.score, line.seldepth > 0 ? line.seldepth : seldepth,
+                   line.principal_variation);
     }
-    std::cout << std::endl;
 }
 
 void announce_currmove(const Move &move, int move_index, const SearchContext &context) {
-    if (!context.is_primary_thread || context.shared == nullptr) {
+    if (!context.is_primary_thread || context.shared == nullptr || !context.shared->uci_output) {
         return;
     }
 
@@ -1172,12 +1492,14 @@ int from_tt_score(int score, int ply) {
     return score;
 }
 
-int quiescence(Board &board, int alpha, int beta, int ply, SearchContext &context);
+int quiescence(Board &board, int alpha, int beta, int ply, SearchContext &context,
+               int depth = 0);
 
 int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_move,
             bool *found_best, SearchContext &context, int parent_static_eval,
-            bool allow_null_move) {
+            bool allow_null_move, bool cut_node = false) {
     context.selective_depth = std::max(context.selective_depth, ply + 1);
+    context.pv_table.clear(ply);
     if (should_stop(context, SearchNodeKind::Main)) {
         return evaluate_for_current_player(board);
     }
@@ -1190,6 +1512,16 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
         return 0;
     }
 
+    // Mate-distance pruning: a shorter mate already bounds this subtree.
+    if (ply > 0) {
+        alpha = search_params::mate_distance_alpha(alpha, ply);
+        beta = search_params::mate_distance_beta(beta, ply);
+        if (alpha >= beta) {
+            context.history.record_mate_distance_prune();
+            return alpha;
+        }
+    }
+
     const std::uint64_t hash = board.zobrist_hash();
     if (context.tt != nullptr) {
         context.tt->prefetch(hash);
@@ -1213,6 +1545,24 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
     }
 
     std::optional<TTEntry> tt_entry = probe_transposition(context.tt, hash, context.tt_generation);
+    if (ply <= search_params::analysis_store_seed_max_ply) {
+        // Near the root, deep analysis from earlier sessions seeds the TT when it beats what the
+        // table already holds for this position.
+        AnalysisStore &store = shared_analysis_store();
+        if (store.enabled()) {
+            if (auto stored = store.probe(hash);
+                stored.has_value() && (!tt_entry.has_value() || stored->depth > tt_entry->depth)) {
+                stored->generation = context.tt_generation;
+                if (context.tt != nullptr) {
+                    context.tt->store(hash, *stored, context.tt_generation);
+                }
+                tt_entry = stored;
+            }
+        }
+    }
+    // At the root every move is searched through the thread's root move list, so nothing may
+    // return early there without a root move.
+    RootMoves *const root_moves = ply == 0 ? context.root_moves : nullptr;
     std::optional<Move> tt_move;
     if (tt_entry.has_value()) {
         tt_move = tt_entry->best_move;
@@ -1227,7 +1577,8 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
         syzygy::max_pieces() >= piece_count && depth_left <= syzygy::probe_depth_limit()) {
         if (auto tb = syzygy::probe_wdl(board); tb.has_value()) {
             int tb_score = syzygy_wdl_to_score(tb->wdl, ply);
-            if (std::abs(tb_score) >= search_params::mate_threshold || tb->wdl == 0) {
+            if (root_moves == nullptr &&
+                (std::abs(tb_score) >= search_params::mate_threshold || tb->wdl == 0)) {
                 if (best_move && tb->best_move) {
                     *best_move = *tb->best_move;
                 }
@@ -1247,7 +1598,7 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
         return quiescence(board, alpha, beta, ply, context);
     }
 
-    if (tt_entry.has_value() && tt_entry->depth >= depth_left) {
+    if (tt_entry.has_value() && tt_entry->depth >= depth_left && root_moves == nullptr) {
         int tt_score = from_tt_score(tt_entry->score, ply);
         switch (tt_entry->type) {
             case TTNodeType::Exact:
@@ -1274,9 +1625,23 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
             }
             return tt_score;
         }
+    } else if (tt_entry.has_value() && ply > 0) {
+        // A stored mate bound stays proven at any depth, so it can tighten the window even
+        // when the entry is too shallow for a regular cutoff.
+        const int tt_score = from_tt_score(tt_entry->score, ply);
+        if (tt_score >= search_params::mate_threshold && tt_entry->type != TTNodeType::UpperBound) {
+            alpha = std::max(alpha, tt_score);
+        } else if (tt_score <= -search_params::mate_threshold &&
+                   tt_entry->type != TTNodeType::LowerBound) {
+            beta = std::min(beta, tt_score);
+        }
+        if (alpha >= beta) {
+            context.history.record_mate_distance_prune();
+            return tt_score;
+        }
     }
 
-    if (!in_check && depth_left == 1) {
+    if (!in_check && depth_left == 1 && root_moves == nullptr) {
         if (corrected_static_eval - search_params::futility_margin_depth1 >= beta) {
             return corrected_static_eval - search_params::futility_margin_depth1;
         }
@@ -1379,31 +1744,67 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
         return corrected_static_eval;
     }
 
-    if (allow_null_move && !in_check && depth_left >= 3 && corrected_static_eval >= beta &&
-        has_non_pawn_material(board, board.side_to_move())) {
+    bool tt_predicts_fail_low = false;
+    if (tt_entry.has_value() && tt_entry->type == TTNodeType::UpperBound) {
+        tt_predicts_fail_low = from_tt_score(tt_entry->score, ply) < beta;
+    }
+    if (allow_null_move && tt_predicts_fail_low &&
+        search_params::should_apply_null_move_pruning(depth_left, corrected_static_eval, beta,
+                                                      in_check, is_pv_node, ply == 0,
+                                                      has_non_pawn_material(board, side_to_move),
+                                                      false)) {
+        context.history.record_null_move_tt_skip();
+    }
+    if (allow_null_move &&
+        search_params::should_apply_null_move_pruning(
+            depth_left,
+            corrected_static_eval,
+            beta,
+            in_check,
+            is_pv_node,
+            ply == 0,
+            has_non_pawn_material(board, side_to_move),
+            tt_predicts_fail_low)) {
+        const int reduction = std::max(
+            1, search_params::null_move_reduction(depth_left, corrected_static_eval, beta) +
+                   context.diversity.null_move_r_delta);
+        const int null_depth = std::max(0, depth_left - 1 - reduction);
         Board::NullUndoState null_undo;
-        Color null_mover = board.side_to_move();
         board.make_null_move(null_undo);
-        int null_score = std::numeric_limits<int>::min();
-        bool evaluated = false;
+        int null_score = 0;
         {
-            EvaluationScope null_eval_scope(null_mover, std::nullopt, board);
-            int reduction = 2 + depth_left / 4;
-            int null_depth = depth_left - 1 - reduction;
-            if (null_depth >= 0) {
-                null_score = -negamax(board, null_depth, -beta, -beta + 1, ply + 1, nullptr, nullptr,
-                                      context, corrected_static_eval, false);
-                evaluated = true;
-            }
+            EvaluationScope null_eval_scope(side_to_move, std::nullopt, board);
+            null_score = -negamax(board, null_depth, -beta, -beta + 1, ply + 1, nullptr, nullptr,
+                                  context, corrected_static_eval, false, !cut_node);
         }
         board.undo_null_move(null_undo);
-        if (evaluated) {
+        if (context.shared->stop.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        if (null_score >= beta) {
+            // Null-move results never prove a mate, so report a plain bound instead.
+            if (null_score >= search_params::mate_threshold) {
+                null_score = beta;
+            }
+            if (!search_params::null_move_requires_verification(depth_left)) {
+                context.history.record_null_move_cutoff();
+                return null_score;
+            }
+
+            // Zugzwang guard: re-search the position itself at the reduced depth with
+            // null moves disabled and only trust the cutoff if it holds.
+            context.history.record_null_move_verification();
+            const int verification_score =
+                negamax(board, null_depth, beta - 1, beta, ply, nullptr, nullptr, context,
+                        parent_static_eval, false);
             if (context.shared->stop.load(std::memory_order_relaxed)) {
                 return 0;
             }
-            if (null_score >= beta) {
-                return beta;
+            if (verification_score >= beta) {
+                context.history.record_null_move_cutoff();
+                return null_score;
             }
+            context.history.record_null_move_verification_failed();
         }
     }
 
@@ -1426,20 +1827,49 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
     MovePicker picker(board, std::move(raw_moves), context, ply, tt_move, side_to_move, false, previous_board,
                       previous_move);
 
+    const bool share_work = context.smp_thread_id != 0;
+    SearchingTable::Entry searching_entry(
+        share_work && ply > 0 && depth_left >= search_params::smp_searching_min_depth
+            ? &context.shared->searching
+            : nullptr,
+        hash, context.smp_thread_id);
+    // Moves whose child another thread is already searching are tried once the picker runs dry;
+    // by then the other thread has usually stored the result in the TT.
+    const bool may_defer = share_work && depth_left - 1 >= search_params::smp_searching_min_depth;
+    std::array<Move, search_params::smp_max_deferred_moves> deferred_moves{};
+    std::size_t deferred_count = 0;
+    std::size_t deferred_next = 0;
+    bool picker_done = false;
+    std::size_t root_next = context.root_pv_index;
+    auto next_move = [&]() -> std::optional<Move> {
+        if (!picker_done) {
+            if (root_moves != nullptr) {
+                if (root_next < root_moves->size()) {
+                    return (*root_moves)[root_next++].move;
+                }
+            } else if (auto move = picker.next()) {
+                return move;
+            }
+            picker_done = true;
+        }
+        if (deferred_next < deferred_count) {
+            return deferred_moves[deferred_next++];
+        }
+        return std::nullopt;
+    };
+
     int alpha_original = alpha;
     int best_score = std::numeric_limits<int>::min();
     Move local_best{};
     bool local_found = false;
     std::array<Move, 64> tried_quiet_moves{};
     std::size_t tried_quiet_count = 0;
+    const bool tt_move_is_capture = tt_move.has_value() && tt_move->captured.has_value();
 
     int move_index = 0;
-    while (auto move_opt = picker.next()) {
+    while (auto move_opt = next_move()) {
         const Move &move = *move_opt;
         ++move_index;
-        if (ply == 0) {
-            announce_currmove(move, move_index, context);
-        }
         Color mover = board.side_to_move();
         Color opponent = opposite(mover);
         bool piece_under_attack = false;
@@ -1463,25 +1893,44 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
             context.history.record_move_count_pruning_continue();
             continue;
         }
+        const int move_history = quiet_move ? context.history.quiet_history_score(move, mover) : 0;
         bool is_tt_move = tt_move.has_value() && same_move(*tt_move, move);
-        if (!in_check && tactical_move && !is_tt_move) {
+        // Every root move is searched, so each MultiPV line ends up with a score.
+        if (ply > 0 && !in_check && tactical_move && !is_tt_move) {
             int see_score = static_exchange_score(board, move);
             if (see_score < 0 && depth_left <= 5 && !move.promotion.has_value()) {
                 continue;
             }
         }
+        const bool gives_check = board.gives_check(move);
         Board::UndoState undo;
         board.make_move(move, undo);
+        if (may_defer && move_index > 1 && !picker_done && deferred_count < deferred_moves.size() &&
+            context.shared->searching.searched_by_other(board.zobrist_hash(), context.smp_thread_id)) {
+            board.undo_move(move, undo);
+            deferred_moves[deferred_count++] = move;
+            --move_index;
+            context.history.record_smp_deferral();
+            continue;
+        }
+        // After the deferral check: a deferred root move is announced once, when it is searched, and
+        // currmovenumber stays consecutive.
+        if (ply == 0) {
+            announce_currmove(move, move_index, context);
+        }
         if (context.tt != nullptr) {
             context.tt->prefetch(board.zobrist_hash());
         }
         EvaluationScope eval_scope(mover, &move, board);
-        bool gives_check = board.in_check(board.side_to_move());
+        RootMove *const root_move = root_moves != nullptr ? root_moves->find(move) : nullptr;
+        const std::uint64_t root_nodes_before = context.total_nodes;
+        const int root_selective_depth_before = context.selective_depth;
+        if (root_move != nullptr) {
+            context.selective_depth = 0;
+        }
 
+        // Checking moves are extended once, by the in-check extension at the child node.
         int child_depth = depth_left - 1;
-        if (gives_check && child_depth < search_params::max_search_depth - (ply + 1)) {
-            ++child_depth;
-        }
         if (is_pawn_storm_move(move, mover) && child_depth < search_params::max_search_depth - (ply + 1)) {
             ++child_depth;
         }
@@ -1494,38 +1943,79 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
             bool responds_to_threat = in_check || piece_under_attack;
             bool tactical_danger = responds_to_threat || delayed_capture_threat || central_sacrifice;
             if (!tactical_danger) {
-                int base_reduction = late_move_reduction_base(child_depth, move_index);
+                int base_reduction = late_move_reduction_base(child_depth, move_index,
+                                                              context.diversity.lmr_variant);
                 if (base_reduction <= 0) {
                     base_reduction = 1;
                 }
-                if (!improving) {
-                    ++base_reduction;
-                }
+                base_reduction += search_params::late_move_reduction_adjustment(
+                    move_history, improving, cut_node, tt_move_is_capture, is_pv_node);
                 if (piece_under_attack) {
                     base_reduction = std::max(base_reduction - 1, 0);
                 }
                 reduction = std::clamp(base_reduction, 0, std::max(0, child_depth - 1));
+                if (reduction > 0) {
+                    context.history.record_lmr_reduction(reduction);
+                }
             }
         }
 
         int new_depth = std::max(0, child_depth - reduction);
         int history_depth = std::max(new_depth + 1, 1);
+        if (child_depth > 0 && ply + 1 < search_params::max_search_depth) {
+            context.previous_board_by_ply[static_cast<std::size_t>(ply + 1)] = board;
+            context.previous_move_by_ply[static_cast<std::size_t>(ply + 1)] = move;
+        }
+        auto search_child = [&](int search_depth, int child_alpha, int child_beta,
+                                bool child_cut_node) {
+            if (search_depth <= 0) {
+                return -quiescence(board, -child_beta, -child_alpha, ply + 1, context);
+            }
+            return -negamax(board, search_depth, -child_beta, -child_alpha, ply + 1, nullptr, nullptr,
+                            context, corrected_static_eval, true, child_cut_node);
+        };
+
+        // PVS: only the first move gets the full window. Later moves are probed with a null
+        // window (reduced when LMR applies) and re-searched only when they fail high inside it.
         int score;
-        if (new_depth <= 0) {
-            score = -quiescence(board, -beta, -alpha, ply + 1, context);
+        // Expected node types alternate: the first child of a cut node is an all node, and a
+        // reduced null-window probe expects to be refuted, so its child is a cut node.
+        if (move_index == 1) {
+            score = search_child(child_depth, alpha, beta, !is_pv_node && !cut_node);
         } else {
-            if (ply + 1 < search_params::max_search_depth) {
-                context.previous_board_by_ply[static_cast<std::size_t>(ply + 1)] = board;
-                context.previous_move_by_ply[static_cast<std::size_t>(ply + 1)] = move;
+            context.history.record_zero_window_search();
+            score = search_child(new_depth, alpha, alpha + 1, reduction > 0 || !cut_node);
+            if (score > alpha && reduction > 0) {
+                const std::uint64_t nodes_before = context.total_nodes;
+                score = search_child(child_depth, alpha, alpha + 1, !cut_node);
+                context.history.record_lmr_research(context.total_nodes - nodes_before);
+            }
+            if (score > alpha && score < beta && is_pv_node) {
+                const std::uint64_t nodes_before = context.total_nodes;
+                score = search_child(child_depth, alpha, beta, false);
+                context.history.record_pvs_research(context.total_nodes - nodes_before);
             }
-            score = -negamax(board, new_depth, -beta, -alpha, ply + 1, nullptr, nullptr, context,
-                             corrected_static_eval, true);
         }
         board.undo_move(move, undo);
         if (context.shared->stop.load(std::memory_order_relaxed)) {
             return 0;
         }
 
+        if (is_pv_node && score > alpha) {
+            context.pv_table.update(ply, move);
+        }
+        if (root_move != nullptr) {
+            root_move->nodes += context.total_nodes - root_nodes_before;
+            // A later move that does not raise alpha only has an upper bound.
+            root_move->score = move_index == 1 || score > alpha ? score : kRootScoreNone;
+            if (root_move->score != kRootScoreNone) {
+                root_move->principal_variation.assign(1, move);
+                context.pv_table.append_line(ply + 1, root_move->principal_variation);
+                root_move->selective_depth = context.selective_depth;
+            }
+            context.selective_depth = std::max(context.selective_depth, root_selective_depth_before);
+        }
+
         if (score > best_score) {
             best_score = score;
             local_best = move;
@@ -1604,7 +2094,11 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
         apply_correction_history_fail_low_update(context.history, correction_key, raw_static_eval, best_score);
     }
 
-    if (local_found) {
+    // A root search over part of the moves (a later MultiPV line, or searchmoves) is no bound on
+    // the position.
+    const bool root_excludes_moves =
+        root_moves != nullptr && (context.root_pv_index > 0 || root_moves->restricted());
+    if (local_found && !root_excludes_moves) {
         TTEntry new_entry{};
         new_entry.best_move = local_best;
         new_entry.depth = depth_left;
@@ -1620,13 +2114,34 @@ int negamax(Board &board, int depth, int alpha, int beta, int ply, Move *best_mo
         if (context.tt != nullptr) {
             context.tt->store(hash, new_entry, context.tt_generation);
         }
+        if (is_pv_node && new_entry.type == TTNodeType::Exact) {
+            AnalysisStore &store = shared_analysis_store();
+            if (store.enabled() && new_entry.depth >= store.min_depth()) {
+                store.record(hash, new_entry);
+            }
+        }
     }
 
     return best_score;
 }
 
-int quiescence(Board &board, int alpha, int beta, int ply, SearchContext &context) {
+// Material a capture or promotion can win at best, for quiescence futility.
+int quiescence_move_gain(const Move &move) {
+    int gain = 0;
+    if (move.captured.has_value()) {
+        gain += search_params::see_piece_values[static_cast<std::size_t>(*move.captured)];
+    }
+    if (move.promotion.has_value()) {
+        gain += search_params::see_piece_values[static_cast<std::size_t>(*move.promotion)] -
+                search_params::see_piece_values[static_cast<std::size_t>(PieceType::Pawn)];
+    }
+    return gain;
+}
+
+// `depth` is 0 at the first quiescence ply and decreases below it.
+int quiescence(Board &board, int alpha, int beta, int ply, SearchContext &context, int depth) {
     context.selective_depth = std::max(context.selective_depth, ply + 1);
+    context.pv_table.clear(ply);
     if (should_stop(context, SearchNodeKind::Quiescence)) {
         return alpha;
     }
@@ -1635,28 +2150,72 @@ int quiescence(Board &board, int alpha, int beta, int ply, SearchContext &contex
             return syzygy_wdl_to_score(tb->wdl, ply);
         }
     }
-    int stand_pat = evaluate_for_current_player(board);
-    if (stand_pat >= beta) {
-        return stand_pat;
+    alpha = search_params::mate_distance_alpha(alpha, ply);
+    beta = search_params::mate_distance_beta(beta, ply);
+    if (alpha >= beta) {
+        context.history.record_mate_distance_prune();
+        return alpha;
     }
-    if (stand_pat > alpha) {
-        alpha = stand_pat;
+
+    const bool in_check = board.checkers() != 0;
+    if (ply >= search_params::max_search_depth - 1) {
+        return in_check ? 0 : evaluate_for_current_player(board);
     }
 
-    auto tactical_moves = generate_pseudo_legal_tactical_moves(board);
-    if (tactical_moves.empty()) {
-        return alpha;
+    // In check there is no stand pat: every evasion is searched and having none is mate.
+    int stand_pat = 0;
+    std::vector<Move> moves;
+    if (in_check) {
+        generate_moves<GenType::Evasions>(board, moves);
+    } else {
+        stand_pat = evaluate_for_current_player(board);
+        if (stand_pat >= beta) {
+            return stand_pat;
+        }
+        if (stand_pat > alpha) {
+            alpha = stand_pat;
+        }
+
+        const Color us = board.side_to_move();
+        const Bitboard promotion_rank = us == Color::White ? rank_7_mask : rank_2_mask;
+        int best_gain = search_params::see_piece_values[static_cast<std::size_t>(PieceType::Queen)];
+        if (board.pieces(us, PieceType::Pawn) & promotion_rank) {
+            best_gain += best_gain - search_params::see_piece_values[static_cast<std::size_t>(PieceType::Pawn)];
+        }
+        if (stand_pat + best_gain + search_params::quiescence_delta_margin <= alpha) {
+            return alpha;
+        }
+
+        generate_moves<GenType::Captures>(board, moves);
+        if (search_params::selectivity_quiescence_checks_are_enabled() && depth == 0) {
+            generate_moves<GenType::QuietChecks>(board, moves);
+        }
+    }
+    if (moves.empty()) {
+        return in_check ? search_params::mated_in(ply) : alpha;
     }
 
-    MovePicker picker(board, std::move(tactical_moves), context, ply, std::nullopt,
-                      board.side_to_move(), true);
+    const bool with_quiets =
+        in_check || (search_params::selectivity_quiescence_checks_are_enabled() && depth == 0);
+    MovePicker picker(board, std::move(moves), context, ply, std::nullopt, board.side_to_move(),
+                      !with_quiets);
 
+    const int futility_base = stand_pat + search_params::quiescence_futility_margin;
     bool found_legal = false;
     while (auto move_opt = picker.next()) {
         const Move &move = *move_opt;
-        if (static_exchange_score(board, move) < 0) {
+        if (!board.is_legal(move)) {
             continue;
         }
+        if (!in_check) {
+            const bool gives_check = board.gives_check(move);
+            if (!gives_check && futility_base + quiescence_move_gain(move) <= alpha) {
+                continue;
+            }
+            if (static_exchange_score(board, move) < 0) {
+                continue;
+            }
+        }
         Board::UndoState undo;
         Color mover = board.side_to_move();
         try {
@@ -1666,13 +2225,9 @@ int quiescence(Board &board, int alpha, int beta, int ply, SearchContext &contex
         }
 
         EvaluationScope eval_scope(mover, &move, board);
-        if (board.king_square(mover) >= 0 && board.in_check(mover)) {
-            board.undo_move(move, undo);
-            continue;
-        }
 
         found_legal = true;
-        int score = -quiescence(board, -beta, -alpha, ply + 1, context);
+        int score = -quiescence(board, -beta, -alpha, ply + 1, context, depth - 1);
         board.undo_move(move, undo);
         if (context.shared->stop.load(std::memory_order_relaxed)) {
             return alpha;
@@ -1685,8 +2240,8 @@ int quiescence(Board &board, int alpha, int beta, int ply, SearchContext &contex
         }
     }
 
-    if (!found_legal) {
-        return alpha;
+    if (in_check && !found_legal) {
+        return search_params::mated_in(ply);
     }
 
     return alpha;
@@ -1704,24 +2259,6 @@ public:
     SearchThreadPool(const SearchThreadPool &) = delete;
     SearchThreadPool &operator=(const SearchThreadPool &) = delete;
 
-    void ensure_size(int desired) {
-        if (desired <= 0) {
-            desired = 1;
-        }
-        std::unique_lock<std::mutex> lock(mutex_);
-        int current = static_cast<int>(workers_.size());
-        if (desired <= current) {
-            return;
-        }
-        int to_add = desired - current;
-        for (int i = 0; i < to_add; ++i) {
-            auto control = std::make_unique<WorkerControl>();
-            std::size_t index = workers_.size();
-            workers_.push_back(std::move(control));
-            spawn_worker_locked(index);
-        }
-    }
-
     void enqueue(SearchSharedState &shared, std::function<void()> task) {
         {
             std::lock_guard<std::mutex> lock(mutex_);
@@ -1731,13 +2268,40 @@ public:
         cv_.notify_one();
     }
 
-    void notify_search_start(SearchSharedState &) {
-        ensure_size(search_thread_count.load(std::memory_order_relaxed));
+    // Helpers kept alive between searches: the sum over engines of their `Threads - 1`. The
+    // pool starts empty and is resized whenever this or the in-flight reservation changes.
+    void adjust_configured_helpers(int delta) {
+        std::vector<std::shared_ptr<WorkerControl>> retired;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            configured_helpers_ = std::max(0, configured_helpers_ + delta);
+            retired = resize_locked();
+        }
+        join_retired(retired);
+    }
+
+    // Concurrent searches (one per Engine) each reserve `threads - 1` helpers for their duration.
+    void notify_search_start(SearchSharedState &, int threads) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reserved_helpers_ += std::max(0, threads - 1);
+        resize_locked();
     }
 
-    void notify_search_end(SearchSharedState &shared) {
+    void notify_search_end(SearchSharedState &shared, int threads) {
         shared.request_stop();
         shared.wait_for_background_tasks();
+        std::vector<std::shared_ptr<WorkerControl>> retired;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reserved_helpers_ = std::max(0, reserved_helpers_ - std::max(0, threads - 1));
+            retired = resize_locked();
+        }
+        join_retired(retired);
+    }
+
+    int size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<int>(workers_.size());
     }
 
 private:
@@ -1752,14 +2316,48 @@ private:
         std::atomic<bool> exit_requested{false};
     };
 
-    SearchThreadPool() {
-        ensure_size(recommended_search_threads());
-    }
+    SearchThreadPool() = default;
 
     ~SearchThreadPool() {
         shutdown();
     }
 
+    // Grows or shrinks to max(configured, reserved) helpers. Surplus workers are asked to exit
+    // and returned so the caller can join them outside the lock; joining releases their stacks,
+    // thread-local evaluation state and watchdog registrations.
+    std::vector<std::shared_ptr<WorkerControl>> resize_locked() {
+        std::vector<std::shared_ptr<WorkerControl>> retired;
+        if (shutdown_) {
+            return retired;
+        }
+        const std::size_t desired =
+            static_cast<std::size_t>(std::max(configured_helpers_, reserved_helpers_));
+        while (workers_.size() < desired) {
+            workers_.push_back(std::make_shared<WorkerControl>());
+            spawn_worker_locked(workers_.size() - 1);
+        }
+        while (workers_.size() > desired) {
+            auto control = std::move(workers_.back());
+            workers_.pop_back();
+            control->exit_requested.store(true, std::memory_order_relaxed);
+            control->registration.reset();
+            retired.push_back(std::move(control));
+        }
+        if (!retired.empty()) {
+            cv_.notify_all();
+        }
+        return retired;
+    }
+
+    static void join_retired(std::vector<std::shared_ptr<WorkerControl>> &retired) {
+        for (auto &control : retired) {
+            if (control->thread.joinable()) {
+                control->thread.join();
+            }
+        }
+        retired.clear();
+    }
+
     void worker_loop(WorkerControl *control,
                      std::shared_ptr<engine::WorkQueueRegistration> registration) {
         while (true) {
@@ -1801,29 +2399,26 @@ private:
         if (shutdown_) {
             return;
         }
-        WorkerControl *control = workers_[index].get();
+        std::shared_ptr<WorkerControl> control = workers_[index];
         control->exit_requested.store(false, std::memory_order_relaxed);
-        auto registration = engine::WorkQueueWatchdog::instance().register_worker([this, index]() {
-            request_worker_restart(index);
-        });
+        std::weak_ptr<WorkerControl> weak_control = control;
+        auto registration = engine::WorkQueueWatchdog::instance().register_worker(
+            [this, weak_control]() { request_worker_restart(weak_control); });
+        watchdog_started_ = true;
         control->registration = registration;
+        // The thread keeps its control block alive so a shrink can drop it from workers_ first.
         control->thread = std::thread([this, control, registration]() {
-            worker_loop(control, registration);
+            worker_loop(control.get(), registration);
         });
     }
 
-    void request_worker_restart(std::size_t index) {
+    void request_worker_restart(const std::weak_ptr<WorkerControl> &weak_control) {
         std::thread old_thread;
+        std::shared_ptr<WorkerControl> control;
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            if (index >= workers_.size()) {
-                return;
-            }
-            if (shutdown_) {
-                return;
-            }
-            WorkerControl *control = workers_[index].get();
-            if (control == nullptr) {
+            control = weak_control.lock();
+            if (shutdown_ || control == nullptr) {
                 return;
             }
             bool expected = false;
@@ -1842,72 +2437,77 @@ private:
 
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            if (index >= workers_.size()) {
-                return;
-            }
             if (shutdown_) {
                 return;
             }
-            WorkerControl *control = workers_[index].get();
-            if (control == nullptr) {
+            auto it = std::find(workers_.begin(), workers_.end(), control);
+            if (it == workers_.end()) {
                 return;
             }
-            spawn_worker_locked(index);
+            spawn_worker_locked(static_cast<std::size_t>(it - workers_.begin()));
         }
     }
 
     void shutdown() {
+        std::vector<std::shared_ptr<WorkerControl>> workers;
+        bool watchdog_started = false;
         {
             std::lock_guard<std::mutex> lock(mutex_);
             shutdown_ = true;
-            engine::WorkQueueWatchdog::instance().update_queue_size(tasks_.size());
+            watchdog_started = watchdog_started_;
             for (auto &worker : workers_) {
-                if (worker) {
-                    worker->exit_requested.store(true, std::memory_order_relaxed);
-                }
+                worker->exit_requested.store(true, std::memory_order_relaxed);
             }
+            workers = std::move(workers_);
+            workers_.clear();
         }
         cv_.notify_all();
-        for (auto &worker : workers_) {
-            if (worker && worker->thread.joinable()) {
-                worker->thread.join();
-            }
+        join_retired(workers);
+        if (watchdog_started) {
+            engine::WorkQueueWatchdog::instance().update_queue_size(0);
+            engine::WorkQueueWatchdog::instance().shutdown();
         }
-        engine::WorkQueueWatchdog::instance().shutdown();
     }
 
-    std::vector<std::unique_ptr<WorkerControl>> workers_;
-    std::mutex mutex_;
+    std::vector<std::shared_ptr<WorkerControl>> workers_;
+    mutable std::mutex mutex_;
     std::condition_variable cv_;
     std::deque<Task> tasks_;
     bool shutdown_ = false;
+    bool watchdog_started_ = false;
+    int configured_helpers_ = 0;
+    int reserved_helpers_ = 0;
 };
 
-void set_search_threads(int threads) {
-    int clamped = clamp_thread_count(threads);
-    search_thread_count.store(clamped, std::memory_order_relaxed);
-    SearchThreadPool::instance().ensure_size(clamped);
-}
-
-int get_search_threads() { return search_thread_count.load(std::memory_order_relaxed); }
+struct Engine::State {
+    std::atomic<int> threads{1};
+    std::mutex active_search_mutex;
+    SearchSharedState *active_search_state = nullptr;
+    std::atomic<bool> stop_requested_pending{false};
+    std::mutex output_mutex;
+    Engine::InfoCallback info_callback;
+    bool uci_output = true;
+    std::atomic<bool> smp_diversity{true};
+};
 
 class ActiveSearchGuard {
 public:
-    explicit ActiveSearchGuard(SearchSharedState *state) : state_(state) {
-        SearchThreadPool::instance().notify_search_start(*state_);
-        std::lock_guard<std::mutex> lock(active_search_mutex);
-        active_search_state = state_;
-        if (stop_requested_pending.load(std::memory_order_relaxed)) {
+    ActiveSearchGuard(Engine::State &engine, SearchSharedState *state, int threads)
+        : engine_(engine), state_(state), threads_(threads) {
+        SearchThreadPool::instance().notify_search_start(*state_, threads_);
+        std::lock_guard<std::mutex> lock(engine_.active_search_mutex);
+        engine_.active_search_state = state_;
+        if (engine_.stop_requested_pending.load(std::memory_order_relaxed)) {
             state_->request_stop();
-            stop_requested_pending.store(false, std::memory_order_relaxed);
+            engine_.stop_requested_pending.store(false, std::memory_order_relaxed);
         }
     }
 
     ~ActiveSearchGuard() {
-        SearchThreadPool::instance().notify_search_end(*state_);
-        std::lock_guard<std::mutex> lock(active_search_mutex);
-        if (active_search_state == state_) {
-            active_search_state = nullptr;
+        SearchThreadPool::instance().notify_search_end(*state_, threads_);
+        std::lock_guard<std::mutex> lock(engine_.active_search_mutex);
+        if (engine_.active_search_state == state_) {
+            engine_.active_search_state = nullptr;
         }
     }
 
@@ -1915,7 +2515,9 @@ public:
     ActiveSearchGuard &operator=(const ActiveSearchGuard &) = delete;
 
 private:
+    Engine::State &engine_;
     SearchSharedState *state_;
+    int threads_;
 };
 
 struct TimeAllocation {
@@ -2017,6 +2619,18 @@ struct SharedBestResult {
     SearchResult result;
 };
 
+// With MultiPV a later line can transpose back into the root and overwrite its TT move, so the
+// first line carries the variation instead of the table.
+std::vector<Move> result_principal_variation(const Board &board, const SearchResult &result,
+                                             GlobalTranspositionTable &tt,
+                                             std::uint8_t tt_generation) {
+    if (!result.lines.empty() && same_move(result.lines.front().move, result.best_move)) {
+        return result.lines.front().principal_variation;
+    }
+    return extract_principal_variation(board, tt, tt_generation,
+                                       std::max(result.depth_reached, 1));
+}
+
 bool publish_best_result(const SearchResult &candidate, SharedBestResult &shared,
                          const Board &board, GlobalTranspositionTable &tt,
                          std::uint8_t tt_generation, SearchSharedState &shared_state,
@@ -2041,8 +2655,7 @@ bool publish_best_result(const SearchResult &candidate, SharedBestResult &shared
     }
 
     SearchResult enriched = candidate;
-    enriched.principal_variation = extract_principal_variation(
-        board, tt, tt_generation, std::max(candidate.depth_reached, 1));
+    enriched.principal_variation = result_principal_variation(board, candidate, tt, tt_generation);
     if (enriched.principal_variation.empty() && candidate.has_move) {
         enriched.principal_variation.push_back(candidate.best_move);
     }
@@ -2085,6 +2698,39 @@ bool publish_best_result(const SearchResult &candidate, SharedBestResult &shared
     return true;
 }
 
+std::vector<SearchLine> collect_search_lines(const Board &board, const RootMoves &root_moves,
+                                             std::size_t count, GlobalTranspositionTable &tt,
+                                             std::uint8_t tt_generation, int depth) {
+    std::vector<SearchLine> lines;
+    for (std::size_t index = 0; index < count && index < root_moves.size(); ++index) {
+        const RootMove &root_move = root_moves[index];
+        // A move never scored in any iteration has no line to report.
+        if (root_move.score == kRootScoreNone && root_move.previous_score == kRootScoreNone) {
+            continue;
+        }
+        SearchLine line;
+        line.move = root_move.move;
+        line.score = root_move.score != kRootScoreNone ? root_move.score : root_move.previous_score;
+        line.seldepth = root_move.selective_depth;
+        line.principal_variation = root_move.principal_variation;
+        if (line.principal_variation.empty()) {
+            line.principal_variation.push_back(root_move.move);
+        }
+        // A TT cutoff inside the line ends the move's own PV early; the table continues it.
+        Board end = board;
+        for (const Move &move : line.principal_variation) {
+            Board::UndoState undo;
+            end.make_move(move, undo);
+        }
+        const int remaining = depth - static_cast<int>(line.principal_variation.size());
+        for (const Move &move : extract_principal_variation(end, tt, tt_generation, remaining)) {
+            line.principal_variation.push_back(move);
+        }
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
 SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedState &shared,
                                SharedBestResult &shared_result, const SearchResult &seed,
                                int thread_index, bool is_primary, GlobalTranspositionTable &tt,
@@ -2094,6 +2740,12 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
     context.tt = &tt;
     context.tt_generation = tt_generation;
     context.is_primary_thread = is_primary;
+    if (shared.thread_count > 1) {
+        context.smp_thread_id = 1 + static_cast<std::uint64_t>(thread_index) % 255;
+        if (shared.smp_diversity) {
+            context.diversity = make_diversity_profile(thread_index);
+        }
+    }
     SearchResult local = seed;
     Move best_move = seed.has_move ? seed.best_move : Move{};
     bool best_found = seed.has_move;
@@ -2103,6 +2755,27 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
 
     initialize_evaluation(board);
 
+    // The first iteration walks the root moves in move-picker order, TT move first.
+    std::vector<Move> root_order;
+    {
+        std::optional<Move> root_tt_move;
+        if (auto entry = probe_transposition(&tt, board.zobrist_hash(), tt_generation)) {
+            root_tt_move = entry->best_move;
+        }
+        MovePicker picker(board, generate_legal_moves(board), context, 0, root_tt_move,
+                          root_color, false);
+        while (auto move = picker.next()) {
+            root_order.push_back(*move);
+        }
+    }
+    RootMoves root_moves(root_order, shared.search_moves);
+    context.root_moves = &root_moves;
+    // Helpers only search the best line; they fill the TT for the primary thread's other lines.
+    const std::size_t line_count =
+        is_primary ? std::clamp<std::size_t>(static_cast<std::size_t>(shared.multi_pv), 1,
+                                              std::max<std::size_t>(root_moves.size(), 1))
+                   : 1;
+
     const std::chrono::milliseconds thread_delay{std::chrono::milliseconds{15 * thread_index}};
     const std::chrono::milliseconds soft_extension{
         std::chrono::milliseconds{std::min(200, 20 * thread_index)}};
@@ -2112,7 +2785,10 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
     }
 
     int capped_depth_limit = std::max(1, max_depth_limit);
-    const int first_active_depth = std::clamp(1 + thread_index, 1, capped_depth_limit);
+    // Without diversity profiles, helpers only stagger their start depth.
+    const int first_active_depth = context.diversity.skip_size > 0
+                                       ? 1
+                                       : std::clamp(1 + thread_index, 1, capped_depth_limit);
     bool retired = false;
     auto ensure_retired = [&]() {
         if (!retired) {
@@ -2127,6 +2803,9 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
         }
 
         if (is_primary) {
+            if (depth == 1) {
+                shared.first_node_time = std::chrono::steady_clock::now();
+            }
             shared.begin_iteration(depth);
         } else {
             if (!shared.wait_for_iteration_start(depth)) {
@@ -2152,7 +2831,7 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
             break;
         }
 
-        if (depth < first_active_depth) {
+        if (depth < first_active_depth || context.diversity.skips_depth(depth)) {
             finalize_iteration();
             continue;
         }
@@ -2168,9 +2847,6 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
 
         const int full_min = std::numeric_limits<int>::min() / 2;
         const int full_max = std::numeric_limits<int>::max() / 2;
-        int aspiration_window = 25;
-        int alpha = have_previous ? previous_score - aspiration_window : full_min;
-        int beta = have_previous ? previous_score + aspiration_window : full_max;
 
         Move current_best{};
         bool found = false;
@@ -2184,32 +2860,77 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
             shared.log_event("iter/" + std::to_string(depth) + "/start", nodes_snapshot);
         }
 
-        while (true) {
-            score = negamax(board, depth, alpha, beta, 0, &current_best, &found, context, 0, true);
-            if (shared.stop.load(std::memory_order_relaxed)) {
-                if (is_primary) {
-                    std::uint64_t nodes_snapshot =
-                        shared.node_counter.load(std::memory_order_relaxed) +
-                        context.local_node_accumulator;
-                    shared.log_event("iter/" + std::to_string(depth) + "/cancelled",
-                                     nodes_snapshot);
+        root_moves.begin_iteration();
+        root_moves.rotate_from(1, context.diversity.root_move_rotation);
+        bool iteration_stopped = false;
+        for (std::size_t pv_index = 0; pv_index < line_count && !iteration_stopped; ++pv_index) {
+            context.root_pv_index = pv_index;
+            // Later lines aspirate around the score their move had in the previous iteration.
+            const int line_previous =
+                pv_index == 0 ? previous_score : root_moves[pv_index].previous_score;
+            const bool line_has_previous =
+                pv_index == 0 ? have_previous : line_previous != kRootScoreNone;
+            int aspiration_window = 25;
+            int alpha = line_has_previous ? line_previous - aspiration_window : full_min;
+            int beta = line_has_previous ? line_previous + aspiration_window : full_max;
+
+            while (true) {
+                Move line_best{};
+                bool line_found = false;
+                const int line_score = negamax(board, depth, alpha, beta, 0, &line_best,
+                                               &line_found, context, 0, true);
+                root_moves.sort_from(pv_index);
+                if (shared.stop.load(std::memory_order_relaxed)) {
+                    if (is_primary) {
+                        std::uint64_t nodes_snapshot =
+                            shared.node_counter.load(std::memory_order_relaxed) +
+                            context.local_node_accumulator;
+                        shared.log_event("iter/" + std::to_string(depth) + "/cancelled",
+                                         nodes_snapshot);
+                    }
+                    local.timed_out = shared.timed_out.load(std::memory_order_relaxed);
+                    iteration_stopped = true;
+                    // Partial result: a move that beat alpha before the stop was fully searched
+                    // at this depth, so it is preferred over the last completed iteration's.
+                    const RootMove &leader = root_moves[0];
+                    if (pv_index == 0 && best_found && !root_moves.empty() &&
+                        leader.score != kRootScoreNone && leader.score > alpha &&
+                        !same_move(leader.move, best_move)) {
+                        best_move = leader.move;
+                        local.best_move = leader.move;
+                        local.score = leader.score;
+                        publish_best_result(local, shared_result, board, tt, tt_generation, shared,
+                                            is_primary);
+                    }
+                    break;
+                }
+                if (line_has_previous && line_score <= alpha) {
+                    aspiration_window *= 2;
+                    alpha = std::max(full_min, line_previous - aspiration_window);
+                    beta = std::min(full_max, line_previous + aspiration_window);
+                    continue;
+                }
+                if (line_has_previous && line_score >= beta) {
+                    aspiration_window *= 2;
+                    beta = std::min(full_max, line_previous + aspiration_window);
+                    alpha = std::max(full_min, line_previous - aspiration_window);
+                    continue;
+                }
+                if (pv_index == 0) {
+                    score = line_score;
+                    current_best = line_best;
+                    found = line_found;
                 }
-                local.timed_out = shared.timed_out.load(std::memory_order_relaxed);
                 break;
             }
-            if (have_previous && score <= alpha) {
-                aspiration_window *= 2;
-                alpha = std::max(full_min, previous_score - aspiration_window);
-                beta = std::min(full_max, previous_score + aspiration_window);
-                continue;
-            }
-            if (have_previous && score >= beta) {
-                aspiration_window *= 2;
-                beta = std::min(full_max, previous_score + aspiration_window);
-                alpha = std::max(full_min, previous_score - aspiration_window);
-                continue;
-            }
-            break;
+            root_moves.sort(0, pv_index + 1);
+        }
+        context.root_pv_index = 0;
+        // A later line can outscore the first one; the move reported is the top of the list.
+        if (!iteration_stopped && found && line_count > 1 &&
+            root_moves[0].score != kRootScoreNone) {
+            current_best = root_moves[0].move;
+            score = root_moves[0].score;
         }
 
         auto iteration_end = std::chrono::steady_clock::now();
@@ -2242,6 +2963,10 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
                 reported_depth = std::min(depth, max_depth_limit);
             }
             local.depth_reached = reported_depth;
+            if (line_count > 1) {
+                local.lines =
+                    collect_search_lines(board, root_moves, line_count, tt, tt_generation, depth);
+            }
             flush_thread_node_counter(context);
             publish_best_result(local, shared_result, board, tt, tt_generation, shared,
                                 is_primary);
@@ -2254,6 +2979,18 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
             auto base_hard = shared.get_hard_limit();
             auto soft_limit = base_soft;
             auto hard_limit = base_hard;
+            const std::uint64_t root_nodes = root_moves.total_nodes();
+            const RootMove *best_root_move = best_found ? root_moves.find(best_move) : nullptr;
+            if (is_primary && shared.node_fraction_time &&
+                depth >= search_params::node_fraction_time_min_depth && root_nodes > 0 &&
+                best_root_move != nullptr) {
+                const double share = static_cast<double>(best_root_move->nodes) /
+                                     static_cast<double>(root_nodes);
+                soft_limit = std::min(
+                    base_hard, std::chrono::milliseconds{static_cast<std::int64_t>(
+                                   static_cast<double>(base_soft.count()) *
+                                   search_params::node_fraction_time_scale(share))});
+            }
             if (!is_primary) {
                 soft_limit += soft_extension;
                 hard_limit += hard_extension;
@@ -2319,18 +3056,128 @@ SearchResult run_search_thread(Board board, int max_depth_limit, SearchSharedSta
         local.has_move = true;
     }
     flush_thread_node_counter(context);
+    flush_thread_selectivity_counters(context);
     publish_best_result(local, shared_result, board, tt, tt_generation, shared, false);
 
     return local;
 }
 
+Engine::Engine(std::size_t hash_size_mb, int threads)
+    : owned_tt_(std::make_unique<GlobalTranspositionTable>()),
+      owned_evaluation_(std::make_unique<EvaluationPrototype>()),
+      tt_(owned_tt_.get()),
+      evaluation_(owned_evaluation_.get()),
+      state_(std::make_unique<State>()) {
+    tt_->resize(hash_size_mb);
+    set_threads(threads);
+}
+
+Engine::Engine(DefaultInstanceTag)
+    : tt_(&shared_transposition_table()),
+      evaluation_(&default_evaluation_prototype()),
+      state_(std::make_unique<State>()) {}
+
+Engine::~Engine() {
+    request_stop();
+    // The default engine lives until static destruction, possibly past the pool.
+    if (owned_tt_) {
+        SearchThreadPool::instance().adjust_configured_helpers(-(threads() - 1));
+    }
+}
+
+Engine &default_engine() {
+    static Engine engine{Engine::DefaultInstanceTag{}};
+    return engine;
+}
+
+void Engine::set_threads(int threads) {
+    int clamped = clamp_thread_count(threads);
+    int previous = state_->threads.exchange(clamped, std::memory_order_relaxed);
+    if (clamped != previous) {
+        SearchThreadPool::instance().adjust_configured_helpers(clamped - previous);
+    }
+}
+
+int Engine::threads() const { return state_->threads.load(std::memory_order_relaxed); }
+
+void Engine::set_smp_diversity(bool enabled) {
+    state_->smp_diversity.store(enabled, std::memory_order_relaxed);
+}
+
+bool Engine::smp_diversity() const { return state_->smp_diversity.load(std::memory_order_relaxed); }
+
+void Engine::set_hash_size(std::size_t size_mb) {
+    if (owned_tt_) {
+        tt_->resize(size_mb);
+    } else {
+        set_transposition_table_size(size_mb);
+    }
+}
+
+void Engine::clear_hash() {
+    if (owned_tt_) {
+        tt_->clear();
+    } else {
+        clear_transposition_tables();
+    }
+}
+
+void Engine::set_info_callback(InfoCallback callback) {
+    std::lock_guard<std::mutex> lock(state_->output_mutex);
+    state_->info_callback = std::move(callback);
+}
+
+void Engine::set_uci_output(bool enabled) {
+    std::lock_guard<std::mutex> lock(state_->output_mutex);
+    state_->uci_output = enabled;
+}
+
+GlobalTranspositionTable &Engine::transposition_table() { return *tt_; }
+
+EvaluationPrototype &Engine::evaluation() { return *evaluation_; }
+
+void Engine::request_stop() {
+    std::lock_guard<std::mutex> lock(state_->active_search_mutex);
+    state_->stop_requested_pending.store(true, std::memory_order_relaxed);
+    if (state_->active_search_state != nullptr) {
+        state_->active_search_state->request_stop();
+        state_->stop_requested_pending.store(false, std::memory_order_relaxed);
+    }
+}
+
+void Engine::clear_pending_stop() {
+    std::lock_guard<std::mutex> lock(state_->active_search_mutex);
+    state_->stop_requested_pending.store(false, std::memory_order_relaxed);
+}
+
+void set_search_threads(int threads) { default_engine().set_threads(threads); }
+
+int get_search_threads() { return default_engine().threads(); }
+
+void set_search_smp_diversity(bool enabled) { default_engine().set_smp_diversity(enabled); }
+
+int search_thread_pool_size() { return SearchThreadPool::instance().size(); }
+
 SearchResult search_best_move(const Board &board, const SearchLimits &limits) {
+    return default_engine().search(board, limits);
+}
+
+SearchResult Engine::search(const Board &board, const SearchLimits &limits) {
     SearchResult result;
     int max_depth_limit = limits.max_depth > 0 ? limits.max_depth : search_params::max_search_depth;
     max_depth_limit = std::min(max_depth_limit, search_params::max_search_depth);
 
     SearchSharedState shared;
     shared.start_time = std::chrono::steady_clock::now();
+    shared.entry_time = shared.start_time;
+    {
+        std::lock_guard<std::mutex> lock(state_->output_mutex);
+        shared.info_callback = state_->info_callback;
+        shared.uci_output = state_->uci_output;
+    }
+    shared.smp_diversity = state_->smp_diversity.load(std::memory_order_relaxed);
+    shared.multi_pv = std::clamp(limits.multi_pv, 1, search_params::max_multi_pv);
+    shared.search_moves = limits.search_moves;
 
     const bool treat_as_infinite = limits.infinite;
 
@@ -2354,6 +3201,7 @@ SearchResult search_best_move(const Board &board, const SearchLimits &limits) {
             shared.set_hard_limit(hard_limit);
         }
         shared.start_time = std::chrono::steady_clock::now();
+        shared.node_fraction_time = limits.move_time <= 0;
         nodes_budget_from_time = nodes_budget_for_time(hard_limit);
     }
 
@@ -2371,8 +3219,8 @@ SearchResult search_best_move(const Board &board, const SearchLimits &limits) {
     }
 
     int root_piece_count = total_piece_count(board);
-    if (syzygy::available() && root_piece_count <= syzygy::probe_piece_limit() &&
-        syzygy::max_pieces() >= root_piece_count) {
+    if (limits.search_moves.empty() && shared.multi_pv == 1 && syzygy::available() &&
+        root_piece_count <= syzygy::probe_piece_limit() && syzygy::max_pieces() >= root_piece_count) {
         if (auto root_probe = syzygy::probe_root(board); root_probe.has_value()) {
             result.score = syzygy_wdl_to_score(root_probe->wdl, 0);
             if (root_probe->best_move.has_value()) {
@@ -2391,18 +3239,19 @@ SearchResult search_best_move(const Board &board, const SearchLimits &limits) {
     SharedBestResult shared_result;
     shared_result.result = seed;
 
-    GlobalTranspositionTable &tt = shared_transposition_table();
+    GlobalTranspositionTable &tt = *tt_;
     std::uint8_t tt_generation = tt.prepare_for_search();
 
-    ActiveSearchGuard active_guard{&shared};
+    int thread_count = std::max(1, threads());
+    ActiveSearchGuard active_guard{*state_, &shared, thread_count};
 
-    int thread_count = std::max(1, get_search_threads());
     shared.configure_thread_count(thread_count);
     std::vector<SearchResult> thread_results(static_cast<std::size_t>(thread_count));
 
     const bool infinite_search = treat_as_infinite && !shared.has_time_limit && !shared.has_node_limit;
 
     auto worker_fn = [&](int index, bool is_primary) {
+        ScopedEvaluationPrototype evaluation_scope{*evaluation_};
         thread_results[static_cast<std::size_t>(index)] = run_search_thread(
             board, max_depth_limit, shared, shared_result, seed, index, is_primary, tt, tt_generation,
             infinite_search);
@@ -2435,6 +3284,11 @@ SearchResult search_best_move(const Board &board, const SearchLimits &limits) {
         }
     }
 
+    // MultiPV lines come from the primary thread, the only one that searches them.
+    if (best.lines.empty() && !thread_results.empty()) {
+        best.lines = thread_results.front().lines;
+    }
+
     if (!best.has_move) {
         auto legal_moves = generate_legal_moves(board);
         if (!legal_moves.empty()) {
@@ -2448,8 +3302,7 @@ SearchResult search_best_move(const Board &board, const SearchLimits &limits) {
         best.seldepth = shared_result.result.seldepth;
     }
     if (best.has_move && best.principal_variation.empty()) {
-        best.principal_variation = extract_principal_variation(
-            board, tt, tt_generation, std::max(best.depth_reached, 1));
+        best.principal_variation = result_principal_variation(board, best, tt, tt_generation);
         if (best.principal_variation.empty()) {
             best.principal_variation.push_back(best.best_move);
         }
@@ -2477,6 +3330,38 @@ SearchResult search_best_move(const Board &board, const SearchLimits &limits) {
         shared.main_nodes.load(std::memory_order_relaxed);
     best.instrumentation.quiescence_nodes =
         shared.quiescence_nodes.load(std::memory_order_relaxed);
+    best.instrumentation.reverse_futility_cutoffs =
+        shared.reverse_futility_cutoffs.load(std::memory_order_relaxed);
+    best.instrumentation.move_count_prunes =
+        shared.move_count_prunes.load(std::memory_order_relaxed);
+    best.instrumentation.null_move_cutoffs =
+        shared.null_move_cutoffs.load(std::memory_order_relaxed);
+    best.instrumentation.null_move_verifications =
+        shared.null_move_verifications.load(std::memory_order_relaxed);
+    best.instrumentation.null_move_verification_failures =
+        shared.null_move_verification_failures.load(std::memory_order_relaxed);
+    best.instrumentation.null_move_tt_skips =
+        shared.null_move_tt_skips.load(std::memory_order_relaxed);
+    best.instrumentation.mate_distance_prunes =
+        shared.mate_distance_prunes.load(std::memory_order_relaxed);
+    best.instrumentation.zero_window_searches =
+        shared.zero_window_searches.load(std::memory_order_relaxed);
+    best.instrumentation.lmr_reductions = shared.lmr_reductions.load(std::memory_order_relaxed);
+    best.instrumentation.lmr_reduction_plies =
+        shared.lmr_reduction_plies.load(std::memory_order_relaxed);
+    best.instrumentation.lmr_researches = shared.lmr_researches.load(std::memory_order_relaxed);
+    best.instrumentation.lmr_research_nodes =
+        shared.lmr_research_nodes.load(std::memory_order_relaxed);
+    best.instrumentation.pvs_researches = shared.pvs_researches.load(std::memory_order_relaxed);
+    best.instrumentation.pvs_research_nodes =
+        shared.pvs_research_nodes.load(std::memory_order_relaxed);
+    best.instrumentation.smp_deferrals = shared.smp_deferrals.load(std::memory_order_relaxed);
+    if (shared.first_node_time > shared.entry_time) {
+        best.instrumentation.first_node_us = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(shared.first_node_time -
+                                                                  shared.entry_time)
+                .count());
+    }
     {
         std::lock_guard<std::mutex> lock(shared.event_mutex);
         best.instrumentation.timeline = shared.event_log;
@@ -2486,7 +3371,7 @@ SearchResult search_best_move(const Board &board, const SearchLimits &limits) {
 }
 
 std::string format_uci_score(int score) {
-    if (score >= search_params::mate_threshold || score <= -search_params::mate_threshold) {
+    if (search_params::is_mate_score(score)) {
         int moves = (search_params::mate_score - std::abs(score) + 1) / 2;
         if (score < 0) {
             moves = -moves;
@@ -2525,14 +3410,7 @@ std::string principal_variation_to_uci(const Board &board, const std::vector<Mov
     return stream.str();
 }
 
-void request_stop_search() {
-    std::lock_guard<std::mutex> lock(active_search_mutex);
-    stop_requested_pending.store(true, std::memory_order_relaxed);
-    if (active_search_state != nullptr) {
-        active_search_state->request_stop();
-        stop_requested_pending.store(false, std::memory_order_relaxed);
-    }
-}
+void request_stop_search() { default_engine().request_stop(); }
 
 bool creates_delayed_capture_threat_for_tests(const Board &board, const Move &move, Color mover) {
     return creates_delayed_capture_threat(board, move, mover);
@@ -2547,6 +3425,23 @@ bool responds_to_direct_threat_for_tests(const Board &board, const Move &move, C
     return in_check || board.is_square_attacked(move.from, opponent);
 }
 
+std::array<bool, 4> searching_table_probe_for_tests(std::uint64_t key, std::uint64_t owner,
+                                                    std::uint64_t probe_key, std::uint64_t prober) {
+    auto table = std::make_unique<SearchingTable>();
+    std::array<bool, 4> seen{};
+    {
+        SearchingTable::Entry owned{table.get(), key, owner};
+        seen[0] = table->searched_by_other(probe_key, prober);
+        seen[1] = table->searched_by_other(key, owner);
+        {
+            SearchingTable::Entry colliding{table.get(), probe_key, prober};
+        }
+        seen[2] = table->searched_by_other(probe_key, prober);
+    }
+    seen[3] = table->searched_by_other(probe_key, prober);
+    return seen;
+}
+
 int static_exchange_eval_for_tests(const Board &board, const Move &move) {
     return static_exchange_score(board, move);
 }
@@ -0,0 +1,220 @@
+#include "sirio/syzygy.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sirio::syzygy {
+
+namespace {
+
+#if defined(_WIN32)
+constexpr char kPathSeparator = ';';
+#else
+constexpr char kPathSeparator = ':';
+#endif
+
+struct PreloadedFile {
+    void *address = nullptr;
+    std::size_t length = 0;
+    // Bytes pinned from the start of the mapping.
+    std::size_t locked_length = 0;
+};
+
+// Files are pinned or touched this many bytes at a time, so a cancel (quit, a new SyzygyPath)
+// never waits for a whole multi-gigabyte table.
+constexpr std::size_t kPreloadChunkBytes = std::size_t{1} << 24;
+
+std::mutex g_preload_mutex;
+std::vector<PreloadedFile> g_preloaded;
+
+// Table names list the pieces of both sides around a 'v', e.g. KRPvKR.rtbw (five pieces).
+int table_piece_count(const std::string &stem) {
+    int count = 0;
+    for (char c : stem) {
+        if (c != 'v' && std::isalpha(static_cast<unsigned char>(c))) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::vector<std::pair<int, std::filesystem::path>> select_tables(const std::string &path,
+                                                                 const PreloadPolicy &policy) {
+    std::vector<std::pair<int, std::filesystem::path>> selected;
+    std::size_t start = 0;
+    while (start <= path.size()) {
+        std::size_t end = path.find(kPathSeparator, start);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        const std::filesystem::path directory{path.substr(start, end - start)};
+        start = end + 1;
+        std::error_code ec;
+        if (directory.empty() || !std::filesystem::is_directory(directory, ec)) {
+            continue;
+        }
+        for (const auto &entry : std::filesystem::directory_iterator(directory, ec)) {
+            const auto extension = entry.path().extension();
+            const bool wdl = extension == ".rtbw";
+            if (!wdl && !(policy.mode == PreloadMode::All && extension == ".rtbz")) {
+                continue;
+            }
+            const int pieces = table_piece_count(entry.path().stem().string());
+            if (policy.mode == PreloadMode::WdlUpTo && pieces > policy.max_pieces) {
+                continue;
+            }
+            selected.emplace_back(pieces, entry.path());
+        }
+    }
+    // Smaller tables first: they are probed most often and are cheapest to bring in.
+    std::sort(selected.begin(), selected.end());
+    return selected;
+}
+
+void release_locked() {
+#if !defined(_WIN32)
+    for (const PreloadedFile &file : g_preloaded) {
+        if (file.locked_length > 0) {
+            munlock(file.address, file.locked_length);
+        }
+        munmap(file.address, file.length);
+    }
+#endif
+    g_preloaded.clear();
+}
+
+#if !defined(_WIN32)
+std::uint64_t resident_bytes(const PreloadedFile &file, std::size_t page_size) {
+    std::vector<unsigned char> pages((file.length + page_size - 1) / page_size);
+#if defined(__APPLE__)
+    if (mincore(file.address, file.length, reinterpret_cast<char *>(pages.data())) != 0) {
+#else
+    if (mincore(file.address, file.length, pages.data()) != 0) {
+#endif
+        return 0;
+    }
+    std::uint64_t resident = 0;
+    for (std::size_t index = 0; index < pages.size(); ++index) {
+        if (pages[index] & 1U) {
+            resident += std::min<std::size_t>(page_size, file.length - index * page_size);
+        }
+    }
+    return resident;
+}
+#endif
+
+bool cancelled(const std::atomic<bool> *cancel) {
+    return cancel != nullptr && cancel->load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+std::optional<PreloadPolicy> parse_preload_policy(std::string_view text) {
+    std::string value;
+    for (char c : text) {
+        value.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+    PreloadPolicy policy;
+    if (value.empty() || value == "none") {
+        return policy;
+    }
+    if (value == "all") {
+        policy.mode = PreloadMode::All;
+        return policy;
+    }
+    if (value.size() == 4 && value.compare(0, 3, "wdl") == 0 && value[3] >= '3' && value[3] <= '7') {
+        policy.mode = PreloadMode::WdlUpTo;
+        policy.max_pieces = value[3] - '0';
+        return policy;
+    }
+    return std::nullopt;
+}
+
+PreloadReport preload_tables(const std::string &path, const PreloadPolicy &policy,
+                             const std::atomic<bool> *cancel) {
+    std::lock_guard<std::mutex> lock(g_preload_mutex);
+    release_locked();
+    PreloadReport report;
+    if (policy.mode == PreloadMode::None || path.empty()) {
+        return report;
+    }
+#if defined(_WIN32)
+    // Not implemented on Windows: the tables are left to Fathom's lazy mapping.
+    (void)cancel;
+    return report;
+#else
+    const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    // Map and advise every file first so the kernel can read them ahead in parallel.
+    for (const auto &[pieces, file_path] : select_tables(path, policy)) {
+        (void)pieces;
+        if (cancelled(cancel)) {
+            break;
+        }
+        const int fd = ::open(file_path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            continue;
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            continue;
+        }
+        const auto length = static_cast<std::size_t>(info.st_size);
+        void *address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            continue;
+        }
+        madvise(address, length, MADV_WILLNEED);
+        g_preloaded.push_back(PreloadedFile{address, length, false});
+        ++report.files;
+        report.mapped_bytes += length;
+    }
+
+    // Then pin them chunk by chunk. When the lock limit is exhausted, touching each page still
+    // brings the file into the page cache, where Fathom's own mapping finds it.
+    bool lock_available = true;
+    for (PreloadedFile &file : g_preloaded) {
+        auto *bytes = static_cast<unsigned char *>(file.address);
+        for (std::size_t offset = 0; offset < file.length && !cancelled(cancel);
+             offset += kPreloadChunkBytes) {
+            const std::size_t chunk = std::min(kPreloadChunkBytes, file.length - offset);
+            if (lock_available && mlock(bytes + offset, chunk) == 0) {
+                file.locked_length += chunk;
+                report.locked_bytes += chunk;
+                continue;
+            }
+            lock_available = false;
+            const auto *pages = static_cast<const volatile unsigned char *>(bytes + offset);
+            unsigned char sink = 0;
+            for (std::size_t page = 0; page < chunk; page += page_size) {
+                sink ^= pages[page];
+            }
+            (void)sink;
+        }
+    }
+
+    for (const PreloadedFile &file : g_preloaded) {
+        report.resident_bytes += resident_bytes(file, page_size);
+    }
+    return report;
+#endif
+}
+
+void release_preloaded_tables() {
+    std::lock_guard<std::mutex> lock(g_preload_mutex);
+    release_locked();
+}
+
+}  // namespace sirio::syzygy
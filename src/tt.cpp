@@ -7,6 +7,8 @@
 #include <fstream>
 #include <limits>
 #include <mutex>
+#include <new>
+#include <string>
 #include <string_view>
 
 #if defined(__linux__)
@@ -17,6 +19,18 @@
 #    endif
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#    include <cerrno>
+#    include <chrono>
+#    include <cstring>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <thread>
+#    include <unistd.h>
+#    define SIRIO_SHARED_TT_SUPPORTED 1
+#endif
+
 namespace sirio {
 namespace {
 
@@ -25,6 +39,35 @@ constexpr std::size_t kDefaultTranspositionTableSizeMb = 256;
 std::atomic<std::size_t> transposition_table_size_mb{kDefaultTranspositionTableSizeMb};
 std::atomic<std::uint64_t> transposition_table_epoch{1};
 std::atomic<bool> large_pages_enabled{false};
+std::mutex shared_table_name_mutex;
+std::string shared_table_name;
+
+#if defined(SIRIO_SHARED_TT_SUPPORTED)
+constexpr char kSharedTableMagic[8] = {'S', 'I', 'R', 'I', 'O', 'T', 'T', '\0'};
+constexpr std::uint32_t kSharedTableVersion = 2;
+// The clusters start one page after the header so they keep their cache-line alignment.
+constexpr std::size_t kSharedTableHeaderBytes = 4096;
+
+// Versioned header at the start of a shared segment. Every field that determines the cluster
+// layout is recorded so a process built with a different layout refuses to attach.
+struct SharedTableHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t cluster_bytes;
+    std::uint32_t entries_per_cluster;
+    std::uint32_t entry_bytes;
+    std::uint64_t bucket_count;
+    std::uint32_t ready;
+    std::uint32_t attached;
+    std::uint32_t generation;
+};
+
+static_assert(sizeof(SharedTableHeader) <= kSharedTableHeaderBytes, "SharedTableHeader must fit its page");
+
+std::atomic_ref<std::uint32_t> header_atomic(std::uint32_t &field) {
+    return std::atomic_ref<std::uint32_t>(field);
+}
+#endif
 
 bool try_enable_large_pages(void *address, std::size_t length) {
 #if defined(__linux__)
@@ -205,31 +248,59 @@ int GlobalTranspositionTable::replacement_score(const PackedTTEntry &entry,
 std::uint8_t GlobalTranspositionTable::prepare_for_search() {
     std::unique_lock lock(global_mutex_);
     ensure_settings_locked();
+#if defined(SIRIO_SHARED_TT_SUPPORTED)
+    if (shared_mapping_ != nullptr) {
+        // The generation advances in the segment header, so every attached process ages the same
+        // entries; trusts_generation() lets siblings searching a few generations apart still use
+        // each other's entries.
+        auto *header = static_cast<SharedTableHeader *>(shared_mapping_);
+        const std::uint32_t searches = header_atomic(header->generation).fetch_add(1, std::memory_order_relaxed) + 1;
+        generation_counter_ = shared_generation(searches);
+        generation_tag_ = pack_generation(generation_counter_);
+        generation_window_.store(kSharedGenerationWindow, std::memory_order_relaxed);
+        return generation_counter_;
+    }
+#endif
     const std::uint8_t max_generation = static_cast<std::uint8_t>(kGenerationMask >> 2);
     generation_counter_ = static_cast<std::uint8_t>((generation_counter_ % max_generation) + 1);
     generation_tag_ = pack_generation(generation_counter_);
+    generation_window_.store(1, std::memory_order_relaxed);
     return generation_counter_;
 }
 
+bool GlobalTranspositionTable::trusts_generation(std::uint8_t entry_generation,
+                                                 std::uint8_t search_generation) const {
+    if (entry_generation == 0) {
+        return true;
+    }
+    const int max_generation = kGenerationMask >> 2;
+    const int ahead = (entry_generation - search_generation + max_generation) % max_generation;
+    const int distance = std::min(ahead, max_generation - ahead);
+    return distance < generation_window_.load(std::memory_order_relaxed);
+}
+
+std::uint8_t GlobalTranspositionTable::shared_generation(std::uint32_t searches) {
+    const std::uint32_t max_generation = kGenerationMask >> 2;
+    return static_cast<std::uint8_t>((std::max<std::uint32_t>(searches, 1) - 1) % max_generation + 1);
+}
+
 void GlobalTranspositionTable::store(std::uint64_t key, const TTEntry &entry, std::uint8_t generation) {
     std::shared_lock lock(global_mutex_);
-    if (clusters_.empty()) {
+    if (table_size_ == 0) {
         return;
     }
 
     const std::uint16_t key16 = static_cast<std::uint16_t>(key);
     const std::size_t primary_index = cluster_index(key);
-    Cluster *target_cluster = &clusters_[primary_index];
+    Cluster *target_cluster = &table_[primary_index];
     std::size_t target_slot = select_entry_index(*target_cluster, key16);
-    PackedTTEntry primary_entry =
-        target_cluster->entries[target_slot].load(std::memory_order_relaxed);
+    PackedTTEntry primary_entry = target_cluster->entries[target_slot].load();
 
     const std::size_t secondary_index = cluster_index(secondary_hash(key));
     if (secondary_index != primary_index) {
-        Cluster &secondary_cluster = clusters_[secondary_index];
+        Cluster &secondary_cluster = table_[secondary_index];
         std::size_t secondary_slot = select_entry_index(secondary_cluster, key16);
-        PackedTTEntry secondary_entry =
-            secondary_cluster.entries[secondary_slot].load(std::memory_order_relaxed);
+        PackedTTEntry secondary_entry = secondary_cluster.entries[secondary_slot].load();
 
         bool primary_match = primary_entry.occupied() && primary_entry.key16 == key16;
         bool secondary_match = secondary_entry.occupied() && secondary_entry.key16 == key16;
@@ -255,23 +326,23 @@ void GlobalTranspositionTable::store(std::uint64_t key, const TTEntry &entry, st
     packed.score = entry.score;
     packed.static_eval = entry.static_eval;
 
-    target_cluster->entries[target_slot].store(packed, std::memory_order_relaxed);
+    target_cluster->entries[target_slot].store(packed);
 }
 
 std::optional<TTEntry> GlobalTranspositionTable::probe(std::uint64_t key) const {
     std::shared_lock lock(global_mutex_);
-    if (clusters_.empty()) {
+    if (table_size_ == 0) {
         return std::nullopt;
     }
 
     const std::uint16_t key16 = static_cast<std::uint16_t>(key);
     const std::size_t primary_index = cluster_index(key);
-    const Cluster &primary_cluster = clusters_[primary_index];
+    const Cluster &primary_cluster = table_[primary_index];
     auto slot = find_entry(primary_cluster, key16);
     if (!slot.has_value()) {
         const std::size_t secondary_index = cluster_index(secondary_hash(key));
         if (secondary_index != primary_index) {
-            const Cluster &secondary_cluster = clusters_[secondary_index];
+            const Cluster &secondary_cluster = table_[secondary_index];
             slot = find_entry(secondary_cluster, key16);
         }
         if (!slot.has_value()) {
@@ -295,17 +366,17 @@ void GlobalTranspositionTable::prefetch(std::uint64_t key) const {
     if (!lock.try_lock()) {
         return;
     }
-    if (clusters_.empty()) {
+    if (table_size_ == 0) {
         return;
     }
     const std::size_t primary_index = cluster_index(key);
-    const Cluster &primary_cluster = clusters_[primary_index];
+    const Cluster &primary_cluster = table_[primary_index];
     for (const auto &entry : primary_cluster.entries) {
         __builtin_prefetch(static_cast<const void *>(&entry), 0, 1);
     }
     const std::size_t secondary_index = cluster_index(secondary_hash(key));
     if (secondary_index != primary_index) {
-        const Cluster &secondary_cluster = clusters_[secondary_index];
+        const Cluster &secondary_cluster = table_[secondary_index];
         for (const auto &entry : secondary_cluster.entries) {
             __builtin_prefetch(static_cast<const void *>(&entry), 0, 1);
         }
@@ -327,7 +398,7 @@ bool GlobalTranspositionTable::save(const std::string &path, std::string *error)
 
     const char magic[4] = {'S', 'R', 'T', 'T'};
     const std::uint32_t version = 2;
-    const std::uint64_t bucket_count = static_cast<std::uint64_t>(clusters_.size());
+    const std::uint64_t bucket_count = static_cast<std::uint64_t>(table_size_);
     out.write(magic, sizeof(magic));
     out.write(reinterpret_cast<const char *>(&version), sizeof(version));
     out.write(reinterpret_cast<const char *>(&bucket_count), sizeof(bucket_count));
@@ -335,9 +406,9 @@ bool GlobalTranspositionTable::save(const std::string &path, std::string *error)
     out.write(reinterpret_cast<const char *>(&generation_counter_), sizeof(generation_counter_));
     out.write(reinterpret_cast<const char *>(&generation_tag_), sizeof(generation_tag_));
 
-    for (const auto &cluster : clusters_) {
-        for (const auto &entry_atomic : cluster.entries) {
-            PackedTTEntry entry = entry_atomic.load(std::memory_order_relaxed);
+    for (std::size_t index = 0; index < table_size_; ++index) {
+        for (const auto &entry_atomic : table_[index].entries) {
+            PackedTTEntry entry = entry_atomic.load();
             out.write(reinterpret_cast<const char *>(&entry.key16), sizeof(entry.key16));
             out.write(reinterpret_cast<const char *>(&entry.depth8), sizeof(entry.depth8));
             out.write(reinterpret_cast<const char *>(&entry.gen_and_type), sizeof(entry.gen_and_type));
@@ -403,55 +474,276 @@ bool GlobalTranspositionTable::load(const std::string &path, std::string *error)
                 }
                 return false;
             }
-            entry_atomic.store(entry, std::memory_order_relaxed);
+            entry_atomic.store(entry);
         }
     }
 
     std::unique_lock lock(global_mutex_);
-    clusters_ = std::move(new_clusters);
-    update_large_pages_status(clusters_.empty() ? nullptr : static_cast<void *>(clusters_.data()),
-                              clusters_.size() * sizeof(Cluster));
+    if (shared_mapping_ != nullptr) {
+        // Siblings keep their mapping, so the saved table is copied into the segment in place.
+        if (new_clusters.size() != table_size_) {
+            if (error != nullptr) {
+                *error = "La tabla guardada no coincide con el tamaño de la tabla compartida";
+            }
+            return false;
+        }
+        std::copy(new_clusters.begin(), new_clusters.end(), table_);
+    } else {
+        clusters_ = std::move(new_clusters);
+        table_ = clusters_.empty() ? nullptr : clusters_.data();
+        table_size_ = clusters_.size();
+        update_large_pages_status(table_, table_size_ * sizeof(Cluster));
+    }
     configured_size_mb_ = size_mb;
     generation_counter_ = saved_generation_counter == 0 ? 1 : saved_generation_counter;
     generation_tag_ = pack_generation(generation_counter_);
     if (saved_generation_tag != 0) {
         generation_tag_ = saved_generation_tag;
     }
-    epoch_marker_ = transposition_table_epoch.load(std::memory_order_relaxed);
-    transposition_table_size_mb.store(size_mb, std::memory_order_relaxed);
+    if (instance_managed_) {
+        own_size_mb_ = size_mb;
+        epoch_marker_ = own_epoch_;
+    } else {
+        epoch_marker_ = transposition_table_epoch.load(std::memory_order_relaxed);
+        transposition_table_size_mb.store(size_mb, std::memory_order_relaxed);
+    }
     return true;
 }
 
+void GlobalTranspositionTable::resize(std::size_t size_mb) {
+    std::unique_lock lock(global_mutex_);
+    instance_managed_ = true;
+    own_size_mb_ = std::clamp<std::size_t>(size_mb, std::size_t{0}, std::size_t{33'554'432});
+    ++own_epoch_;
+}
+
+void GlobalTranspositionTable::clear() {
+    std::unique_lock lock(global_mutex_);
+    if (!instance_managed_) {
+        instance_managed_ = true;
+        own_size_mb_ = transposition_table_size_mb.load(std::memory_order_relaxed);
+    }
+    ++own_epoch_;
+}
+
 void GlobalTranspositionTable::ensure_settings_locked() {
-    const std::size_t desired = transposition_table_size_mb.load(std::memory_order_relaxed);
-    const std::uint64_t epoch = transposition_table_epoch.load(std::memory_order_relaxed);
+    const std::size_t desired =
+        instance_managed_ ? own_size_mb_ : transposition_table_size_mb.load(std::memory_order_relaxed);
+    const std::uint64_t epoch =
+        instance_managed_ ? own_epoch_ : transposition_table_epoch.load(std::memory_order_relaxed);
     if (configured_size_mb_ != desired || epoch_marker_ != epoch) {
-        rebuild_locked(desired);
+        // Re-attaching a segment a sibling process still maps would keep all of its entries, so a
+        // clear of the attached shared table wipes the clusters in place instead.
+        if (configured_size_mb_ == desired && attached_to_current_segment_locked()) {
+            clear_shared_locked();
+        } else {
+            rebuild_locked(desired);
+        }
         epoch_marker_ = epoch;
     }
 }
 
+bool GlobalTranspositionTable::attached_to_current_segment_locked() const {
+    if (shared_mapping_ == nullptr || instance_managed_) {
+        return false;
+    }
+    const std::string name = get_transposition_table_shared_name();
+    return !name.empty() && (name.front() == '/' ? name : "/" + name) == shared_segment_name_;
+}
+
+void GlobalTranspositionTable::clear_shared_locked() {
+    // Every attached process sees the empty table; the generation counter in the segment header
+    // keeps advancing from where it was.
+    for (std::size_t index = 0; index < table_size_; ++index) {
+        for (auto &entry : table_[index].entries) {
+            entry.store(PackedTTEntry{});
+        }
+    }
+}
+
 void GlobalTranspositionTable::rebuild_locked(std::size_t size_mb) {
+    detach_shared_locked();
+    decltype(clusters_)().swap(clusters_);
+    table_ = nullptr;
+    table_size_ = 0;
+    shared_error_.clear();
     configured_size_mb_ = size_mb;
+    generation_counter_ = 1;
+    generation_tag_ = kGenerationDelta;
     if (size_mb == 0) {
-        clusters_.clear();
-        generation_counter_ = 1;
-        generation_tag_ = kGenerationDelta;
         update_large_pages_status(nullptr, 0);
         return;
     }
     std::size_t bytes = size_mb * 1024ULL * 1024ULL;
     std::size_t bucket_count = std::max<std::size_t>(1, bytes / sizeof(Cluster));
     bucket_count = std::bit_ceil(bucket_count);
+
+    const std::string shared_name = instance_managed_ ? std::string{} : get_transposition_table_shared_name();
+    if (!shared_name.empty() && attach_shared_locked(shared_name, bucket_count)) {
+        return;
+    }
+
     clusters_.assign(bucket_count, Cluster{});
-    update_large_pages_status(clusters_.empty() ? nullptr : static_cast<void *>(clusters_.data()),
-                              clusters_.size() * sizeof(Cluster));
-    generation_counter_ = 1;
-    generation_tag_ = kGenerationDelta;
+    table_ = clusters_.data();
+    table_size_ = clusters_.size();
+    update_large_pages_status(table_, table_size_ * sizeof(Cluster));
+}
+
+bool GlobalTranspositionTable::attach_shared_locked(const std::string &name, std::size_t bucket_count) {
+#if defined(SIRIO_SHARED_TT_SUPPORTED)
+    const std::string segment = name.front() == '/' ? name : "/" + name;
+    // Atomics that need a lock are only synchronised within one process.
+    if (!std::atomic<std::uint64_t>::is_always_lock_free ||
+        !std::atomic_ref<std::uint32_t>::is_always_lock_free) {
+        shared_error_ = "Las operaciones atómicas de 64 bits no son lock-free en esta plataforma; " + segment +
+                        " no se puede compartir";
+        return false;
+    }
+    bool created = true;
+    int fd = ::shm_open(segment.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd = ::shm_open(segment.c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        shared_error_ = "shm_open(" + segment + ") falló: " + std::strerror(errno);
+        return false;
+    }
+
+    std::size_t bytes = kSharedTableHeaderBytes + bucket_count * sizeof(Cluster);
+    if (created) {
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            shared_error_ = "ftruncate de la tabla compartida falló: " + std::string(std::strerror(errno));
+            ::close(fd);
+            ::shm_unlink(segment.c_str());
+            return false;
+        }
+    } else {
+        // The creator may still be sizing the segment; wait briefly for a published header.
+        SharedTableHeader header{};
+        bool ready = false;
+        for (int attempt = 0; attempt < 200 && !ready; ++attempt) {
+            struct stat info {};
+            if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= kSharedTableHeaderBytes &&
+                ::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                header.ready == 1) {
+                ready = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (!ready) {
+            shared_error_ = "La tabla compartida " + segment + " no terminó de inicializarse";
+            ::close(fd);
+            return false;
+        }
+        if (std::string_view(header.magic, sizeof(header.magic)) !=
+                std::string_view(kSharedTableMagic, sizeof(kSharedTableMagic)) ||
+            header.version != kSharedTableVersion || header.cluster_bytes != sizeof(Cluster) ||
+            header.entries_per_cluster != static_cast<std::uint32_t>(kClusterSize) ||
+            header.entry_bytes != sizeof(PackedTTEntry) || header.bucket_count == 0) {
+            shared_error_ = "La tabla compartida " + segment + " tiene un formato incompatible";
+            ::close(fd);
+            return false;
+        }
+        bucket_count = static_cast<std::size_t>(header.bucket_count);
+        bytes = kSharedTableHeaderBytes + bucket_count * sizeof(Cluster);
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < bytes) {
+            shared_error_ = "La tabla compartida " + segment + " está truncada";
+            ::close(fd);
+            return false;
+        }
+    }
+
+    void *address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        shared_error_ = "mmap de la tabla compartida falló: " + std::string(std::strerror(errno));
+        if (created) {
+            ::shm_unlink(segment.c_str());
+        }
+        return false;
+    }
+
+    auto *header = static_cast<SharedTableHeader *>(address);
+    auto *clusters = reinterpret_cast<Cluster *>(static_cast<unsigned char *>(address) + kSharedTableHeaderBytes);
+    if (created) {
+        std::memcpy(header->magic, kSharedTableMagic, sizeof(kSharedTableMagic));
+        header->version = kSharedTableVersion;
+        header->cluster_bytes = sizeof(Cluster);
+        header->entries_per_cluster = static_cast<std::uint32_t>(kClusterSize);
+        header->entry_bytes = sizeof(PackedTTEntry);
+        header->bucket_count = bucket_count;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            new (clusters + i) Cluster();
+        }
+        header_atomic(header->attached).store(1, std::memory_order_relaxed);
+        header_atomic(header->generation).store(generation_counter_, std::memory_order_relaxed);
+        header_atomic(header->ready).store(1, std::memory_order_release);
+    } else {
+        header_atomic(header->attached).fetch_add(1, std::memory_order_relaxed);
+        generation_counter_ =
+            shared_generation(header_atomic(header->generation).load(std::memory_order_relaxed));
+        generation_tag_ = pack_generation(generation_counter_);
+    }
+
+    shared_mapping_ = address;
+    shared_mapping_bytes_ = bytes;
+    shared_segment_name_ = segment;
+    table_ = clusters;
+    table_size_ = bucket_count;
+    update_large_pages_status(nullptr, 0);
+    return true;
+#else
+    (void)name;
+    (void)bucket_count;
+    shared_error_ = "La memoria compartida POSIX no está disponible en esta plataforma";
+    return false;
+#endif
+}
+
+void GlobalTranspositionTable::detach_shared_locked() {
+#if defined(SIRIO_SHARED_TT_SUPPORTED)
+    if (shared_mapping_ == nullptr) {
+        return;
+    }
+    auto *header = static_cast<SharedTableHeader *>(shared_mapping_);
+    // The last process to detach removes the name; a crashed sibling leaves it in /dev/shm.
+    if (header_atomic(header->attached).fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ::shm_unlink(shared_segment_name_.c_str());
+    }
+    ::munmap(shared_mapping_, shared_mapping_bytes_);
+    shared_mapping_ = nullptr;
+    shared_mapping_bytes_ = 0;
+    shared_segment_name_.clear();
+    table_ = nullptr;
+    table_size_ = 0;
+#endif
+}
+
+GlobalTranspositionTable::~GlobalTranspositionTable() {
+    std::unique_lock lock(global_mutex_);
+    detach_shared_locked();
+}
+
+std::size_t GlobalTranspositionTable::allocated_bytes() const {
+    std::shared_lock lock(global_mutex_);
+    return table_size_ * sizeof(Cluster);
+}
+
+bool GlobalTranspositionTable::attached_to_shared_memory() const {
+    std::shared_lock lock(global_mutex_);
+    return shared_mapping_ != nullptr;
+}
+
+std::string GlobalTranspositionTable::shared_memory_error() const {
+    std::shared_lock lock(global_mutex_);
+    return shared_error_;
 }
 
 std::size_t GlobalTranspositionTable::cluster_index(std::uint64_t key) const {
-    const std::size_t bucket_count = clusters_.size();
+    const std::size_t bucket_count = table_size_;
     if (bucket_count == 0) {
         return 0;
     }
@@ -461,7 +753,7 @@ std::size_t GlobalTranspositionTable::cluster_index(std::uint64_t key) const {
 std::size_t GlobalTranspositionTable::select_entry_index(const Cluster &cluster, std::uint16_t key16) {
     std::size_t empty_slot = kClusterSize;
     for (std::size_t i = 0; i < cluster.entries.size(); ++i) {
-        PackedTTEntry entry = cluster.entries[i].load(std::memory_order_acquire);
+        PackedTTEntry entry = cluster.entries[i].load();
         if (entry.occupied() && entry.key16 == key16) {
             return i;
         }
@@ -474,10 +766,10 @@ std::size_t GlobalTranspositionTable::select_entry_index(const Cluster &cluster,
     }
 
     std::size_t replacement = 0;
-    PackedTTEntry best_entry = cluster.entries[0].load(std::memory_order_acquire);
+    PackedTTEntry best_entry = cluster.entries[0].load();
     int best_score = replacement_score(best_entry, generation_tag_);
     for (std::size_t i = 1; i < cluster.entries.size(); ++i) {
-        PackedTTEntry candidate = cluster.entries[i].load(std::memory_order_acquire);
+        PackedTTEntry candidate = cluster.entries[i].load();
         int candidate_score = replacement_score(candidate, generation_tag_);
         if (candidate_score < best_score) {
             replacement = i;
@@ -490,7 +782,7 @@ std::size_t GlobalTranspositionTable::select_entry_index(const Cluster &cluster,
 std::optional<GlobalTranspositionTable::PackedTTEntry> GlobalTranspositionTable::find_entry(
     const Cluster &cluster, std::uint16_t key16) const {
     for (const auto &entry_atomic : cluster.entries) {
-        PackedTTEntry entry = entry_atomic.load(std::memory_order_acquire);
+        PackedTTEntry entry = entry_atomic.load();
         if (entry.occupied() && entry.key16 == key16) {
             return entry;
         }
@@ -500,7 +792,7 @@ std::optional<GlobalTranspositionTable::PackedTTEntry> GlobalTranspositionTable:
 
 std::size_t GlobalTranspositionTable::bucket_count_for_tests() const {
     std::shared_lock lock(global_mutex_);
-    return clusters_.size();
+    return table_size_;
 }
 
 GlobalTranspositionTable &shared_transposition_table() {
@@ -518,6 +810,22 @@ std::size_t get_transposition_table_size() {
     return transposition_table_size_mb.load(std::memory_order_relaxed);
 }
 
+void set_transposition_table_shared_name(const std::string &name) {
+    {
+        std::lock_guard<std::mutex> lock(shared_table_name_mutex);
+        if (shared_table_name == name) {
+            return;
+        }
+        shared_table_name = name;
+    }
+    transposition_table_epoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string get_transposition_table_shared_name() {
+    std::lock_guard<std::mutex> lock(shared_table_name_mutex);
+    return shared_table_name;
+}
+
 void clear_transposition_tables() {
     transposition_table_epoch.fetch_add(1, std::memory_order_relaxed);
 }
@@ -17,8 +17,13 @@
 #include <thread>
 #include <vector>
 
+#include "sirio/analysis_store.hpp"
+#include "sirio/bitboard.hpp"
 #include "sirio/board.hpp"
+#include "sirio/cpu_features.hpp"
+#include "sirio/engine.hpp"
 #include "sirio/evaluation.hpp"
+#include "sirio/main_search_thread.hpp"
 #include "sirio/move.hpp"
 #include "sirio/movegen.hpp"
 #include "sirio/nnue/api.hpp"
@@ -42,17 +47,51 @@ std::string pending_eval_file_small{kDefaultEvalFileSmall};
 std::ofstream debug_log_stream;
 std::streambuf* original_clog_buffer = nullptr;
 
-std::mutex search_thread_mutex;
-std::thread search_thread;
-std::atomic<bool> search_in_progress{false};
+sirio::MainSearchThread& main_search_thread() {
+    static sirio::MainSearchThread thread{sirio::default_engine()};
+    return thread;
+}
 
 std::mutex pending_result_mutex;
 std::optional<sirio::SearchResult> pending_infinite_result;
 
+// Timestamps for `--startup-trace`, measured from static initialisation of this translation unit,
+// which is as close to process start as the engine can observe portably.
+const std::chrono::steady_clock::time_point process_start_time = std::chrono::steady_clock::now();
+bool startup_trace_enabled = false;
+std::mutex startup_trace_mutex;
+
+void trace_startup(std::string_view phase) {
+    if (!startup_trace_enabled) {
+        return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - process_start_time);
+    std::lock_guard<std::mutex> lock(startup_trace_mutex);
+    std::cerr << "startup " << elapsed.count() / 1000 << '.' << (elapsed.count() % 1000) / 100
+              << " ms " << phase << std::endl;
+}
+
+// Work that is not needed to answer `uci`: the sliding attack tables, the transposition table
+// allocation, Syzygy initialisation and the default network. It runs on its own thread while the
+// GUI exchanges `uci`/`uciok`; every other command waits for it first.
+struct StartupTasks {
+    std::thread thread;
+    bool pending = false;
+    std::size_t hash_size_mb = 0;
+    std::string syzygy_path;
+    std::vector<std::string> eval_files;
+    bool nnue_loaded = false;
+    std::vector<std::string> nnue_errors;
+};
+
+StartupTasks startup_tasks;
+
 struct EngineOptions {
     std::string debug_log_file;
     std::string numa_policy = "auto";
     int threads = 1;
+    bool smp_diversity = true;
     std::size_t hash_size_mb = 16;
     bool ponder = false;
     int multi_pv = 1;
@@ -72,8 +111,10 @@ struct EngineOptions {
     int syzygy_probe_depth = 1;
     bool syzygy_50_move_rule = true;
     int syzygy_probe_limit = 7;
+    std::string syzygy_preload = "none";
     bool hash_persist = false;
     std::string hash_persist_file;
+    std::string shared_hash_name;
     bool use_book = true;
     std::string book_file;
     bool persistent_analysis = false;
@@ -124,6 +165,36 @@ bool save_transposition_table_with_feedback(const std::string& path, std::string
 
 void mark_persistent_analysis_unloaded() { persistent_analysis_loaded = false; }
 
+bool load_analysis_store_with_feedback(const std::string& path, bool verbose_success) {
+    std::string error;
+    auto& store = sirio::shared_analysis_store();
+    if (store.open(path, &error)) {
+        if (verbose_success) {
+            const auto stats = store.stats();
+            std::cout << "info string Persistent analysis store loaded from " << path << " ("
+                      << stats.sorted_records + stats.appended_records << " entries)" << std::endl;
+        }
+        return true;
+    }
+    std::cout << "info string Failed to load persistent analysis store: " << error << std::endl;
+    return false;
+}
+
+bool save_analysis_store_with_feedback(const std::string& path, bool verbose_success) {
+    std::string error;
+    auto& store = sirio::shared_analysis_store();
+    const std::size_t pending = store.stats().pending_records;
+    if (store.append_pending(path, &error)) {
+        if (verbose_success) {
+            std::cout << "info string Persistent analysis store saved to " << path << " (" << pending
+                      << " new entries)" << std::endl;
+        }
+        return true;
+    }
+    std::cout << "info string Failed to save persistent analysis store: " << error << std::endl;
+    return false;
+}
+
 void try_autoload_persistent_analysis(bool verbose_success) {
     if (!options.persistent_analysis) {
         return;
@@ -134,9 +205,7 @@ void try_autoload_persistent_analysis(bool verbose_success) {
     if (persistent_analysis_loaded) {
         return;
     }
-    if (load_transposition_table_with_feedback(options.persistent_analysis_file,
-                                               "Persistent analysis table", "persistent analysis table",
-                                               verbose_success)) {
+    if (load_analysis_store_with_feedback(options.persistent_analysis_file, verbose_success)) {
         persistent_analysis_loaded = true;
     }
 }
@@ -145,9 +214,7 @@ void save_persistent_analysis_if_enabled(bool verbose_success) {
     if (!options.persistent_analysis || options.persistent_analysis_file.empty()) {
         return;
     }
-    if (save_transposition_table_with_feedback(options.persistent_analysis_file,
-                                               "Persistent analysis table", "persistent analysis table",
-                                               verbose_success)) {
+    if (save_analysis_store_with_feedback(options.persistent_analysis_file, verbose_success)) {
         persistent_analysis_loaded = true;
     }
 }
@@ -166,8 +233,7 @@ void initialize_engine_options() {
     }
     options.threads = sirio::recommended_search_threads();
     sirio::set_search_threads(options.threads);
-    sirio::set_transposition_table_size(options.hash_size_mb);
-    sirio::shared_transposition_table().prepare_for_search();
+    sirio::set_search_smp_diversity(options.smp_diversity);
     mark_persistent_analysis_unloaded();
     apply_time_management_options();
     if (options.syzygy_path.empty()) {
@@ -175,32 +241,14 @@ void initialize_engine_options() {
             options.syzygy_path = detected->string();
         }
     }
-    if (!options.syzygy_path.empty()) {
-        sirio::syzygy::set_tablebase_path(options.syzygy_path);
-    }
     sirio::syzygy::set_probe_depth_limit(options.syzygy_probe_depth);
     sirio::syzygy::set_probe_piece_limit(options.syzygy_probe_limit);
     sirio::syzygy::set_use_fifty_move_rule(options.syzygy_50_move_rule);
 }
 
 void stop_and_join_search() {
-    if (search_in_progress.load(std::memory_order_acquire)) {
-        sirio::request_stop_search();
-    }
-
-    std::thread local_thread;
-    {
-        std::lock_guard<std::mutex> lock(search_thread_mutex);
-        if (search_thread.joinable()) {
-            local_thread = std::move(search_thread);
-        }
-    }
-
-    if (local_thread.joinable()) {
-        local_thread.join();
-    }
-
-    search_in_progress.store(false, std::memory_order_release);
+    main_search_thread().request_stop();
+    main_search_thread().wait();
 
     std::optional<sirio::SearchResult> pending;
     {
@@ -266,7 +314,11 @@ void output_search_result(const sirio::Board& board, const sirio::SearchLimits&
             };
             std::ostringstream stream;
             stream << "{\"main_nodes\":" << snapshot.main_nodes
-                   << ",\"quiescence_nodes\":" << snapshot.quiescence_nodes << ",\"timeline\":";
+                   << ",\"quiescence_nodes\":" << snapshot.quiescence_nodes
+                   << ",\"lmr_reductions\":" << snapshot.lmr_reductions
+                   << ",\"lmr_reduction_plies\":" << snapshot.lmr_reduction_plies
+                   << ",\"lmr_researches\":" << snapshot.lmr_researches
+                   << ",\"smp_deferrals\":" << snapshot.smp_deferrals << ",\"timeline\":";
             stream << '[';
             bool first = true;
             for (const auto& event : snapshot.timeline) {
@@ -326,34 +378,12 @@ void output_search_result(const sirio::Board& board, const sirio::SearchLimits&
 void start_search_async(const sirio::Board& board, const sirio::SearchLimits& limits) {
     stop_and_join_search();
 
-    sirio::Board board_copy = board;
-    sirio::SearchLimits limits_copy = limits;
-
     {
         std::lock_guard<std::mutex> lock(pending_result_mutex);
         pending_infinite_result.reset();
     }
 
-    search_in_progress.store(true, std::memory_order_release);
-
-    std::thread new_thread;
-
-    try {
-        new_thread = std::thread([board_copy, limits_copy]() mutable {
-            sirio::SearchResult result = sirio::search_best_move(board_copy, limits_copy);
-            output_search_result(board_copy, limits_copy, result);
-            search_in_progress.store(false, std::memory_order_release);
-        });
-
-        std::lock_guard<std::mutex> lock(search_thread_mutex);
-        search_thread = std::move(new_thread);
-    } catch (...) {
-        if (new_thread.joinable()) {
-            new_thread.join();
-        }
-        search_in_progress.store(false, std::memory_order_release);
-        throw;
-    }
+    main_search_thread().start(board, limits, output_search_result);
 }
 
 std::string normalize_eval_path(const std::string& value) {
@@ -407,6 +437,57 @@ bool nnue_try_load(const std::string& path, sirio::Board& board) {
     return true;
 }
 
+void start_startup_tasks() {
+    startup_tasks.hash_size_mb = options.hash_size_mb;
+    startup_tasks.syzygy_path = options.syzygy_path;
+    for (const std::string* file : {&pending_eval_file, &pending_eval_file_small}) {
+        if (!file->empty()) {
+            startup_tasks.eval_files.push_back(*file);
+        }
+    }
+    startup_tasks.pending = true;
+    startup_tasks.thread = std::thread([]() {
+        sirio::initialize_sliding_attack_tables();
+        trace_startup("attack tables built");
+        sirio::set_transposition_table_size(startup_tasks.hash_size_mb);
+        sirio::shared_transposition_table().prepare_for_search();
+        trace_startup("transposition table allocated");
+        if (!startup_tasks.syzygy_path.empty()) {
+            sirio::syzygy::set_tablebase_path(startup_tasks.syzygy_path);
+            trace_startup("syzygy tables initialised");
+        }
+        for (const std::string& file : startup_tasks.eval_files) {
+            std::string error;
+            if (sirio::nnue::init(file, &error)) {
+                startup_tasks.nnue_loaded = true;
+                break;
+            }
+            startup_tasks.nnue_errors.push_back(std::move(error));
+        }
+        trace_startup("network loaded");
+    });
+}
+
+// Joins the startup thread and reports what it loaded. Messages are printed here rather than on
+// the worker so that they never interleave with the `uci` reply.
+void wait_for_startup_tasks(sirio::Board& board) {
+    if (!startup_tasks.pending) {
+        return;
+    }
+    startup_tasks.thread.join();
+    startup_tasks.pending = false;
+    for (const std::string& error : startup_tasks.nnue_errors) {
+        std::cout << "info string Failed to load NNUE: " << error << std::endl;
+    }
+    if (startup_tasks.nnue_loaded) {
+        sirio::initialize_evaluation(board);
+        if (auto meta = sirio::nnue::info()) {
+            print_loaded_nnue_info(*meta);
+        }
+    }
+    trace_startup("startup tasks joined");
+}
+
 void nnue_load_if_pending(sirio::Board& board) {
     if (sirio::nnue::is_loaded()) {
         return;
@@ -476,6 +557,14 @@ void on_threads(const Option& opt) {
     sirio::set_search_threads(options.threads);
 }
 
+void on_smp_diversity(const Option& opt) {
+    options.smp_diversity = static_cast<bool>(opt);
+    if (g_silent_option_update) {
+        return;
+    }
+    sirio::set_search_smp_diversity(options.smp_diversity);
+}
+
 void on_hash(const Option& opt) {
     if (g_silent_option_update) {
         return;
@@ -483,7 +572,6 @@ void on_hash(const Option& opt) {
     std::size_t clamped = static_cast<std::size_t>(static_cast<int>(opt));
     options.hash_size_mb = clamped;
     sirio::set_transposition_table_size(options.hash_size_mb);
-    mark_persistent_analysis_unloaded();
 }
 
 void on_hash_file(const Option& opt) {
@@ -499,6 +587,29 @@ void on_hash_file(const Option& opt) {
     }
 }
 
+void on_shared_hash_name(const Option& opt) {
+    if (g_silent_option_update) {
+        return;
+    }
+    std::string name = normalize_string_option(static_cast<std::string>(opt));
+    if (name == options.shared_hash_name) {
+        return;
+    }
+    options.shared_hash_name = name;
+    sirio::set_transposition_table_shared_name(name);
+    auto& tt = sirio::shared_transposition_table();
+    tt.prepare_for_search();
+    if (name.empty()) {
+        std::cout << "info string Transposition table is private to this process" << std::endl;
+    } else if (tt.attached_to_shared_memory()) {
+        std::cout << "info string Transposition table shared as " << name << " ("
+                  << tt.allocated_bytes() / (1024 * 1024) << " MB)" << std::endl;
+    } else {
+        std::cout << "info string Failed to share transposition table: " << tt.shared_memory_error()
+                  << std::endl;
+    }
+}
+
 void on_hash_persist(const Option& opt) {
     if (g_silent_option_update) {
         return;
@@ -520,6 +631,7 @@ void on_persistent_analysis(const Option& opt) {
     bool enabled = static_cast<bool>(opt);
     if (enabled != options.persistent_analysis) {
         options.persistent_analysis = enabled;
+        sirio::shared_analysis_store().set_enabled(enabled);
         mark_persistent_analysis_unloaded();
         if (enabled) {
             std::cout << "info string Persistent analysis mode enabled" << std::endl;
@@ -560,8 +672,7 @@ void on_persistent_analysis_load(const Option&) {
         std::cout << "info string Persistent analysis file not set" << std::endl;
         return;
     }
-    if (load_transposition_table_with_feedback(options.persistent_analysis_file,
-                                               "Persistent analysis table", "persistent analysis table", true)) {
+    if (load_analysis_store_with_feedback(options.persistent_analysis_file, true)) {
         persistent_analysis_loaded = true;
     }
 }
@@ -571,16 +682,44 @@ void on_persistent_analysis_save(const Option&) {
         std::cout << "info string Persistent analysis file not set" << std::endl;
         return;
     }
-    if (save_transposition_table_with_feedback(options.persistent_analysis_file,
-                                               "Persistent analysis table", "persistent analysis table", true)) {
+    if (save_analysis_store_with_feedback(options.persistent_analysis_file, true)) {
+        persistent_analysis_loaded = true;
+    }
+}
+
+void on_persistent_analysis_merge(const Option& opt) {
+    if (g_silent_option_update) {
+        return;
+    }
+    std::string source = normalize_string_option(static_cast<std::string>(opt));
+    if (source.empty()) {
+        return;
+    }
+    if (options.persistent_analysis_file.empty()) {
+        std::cout << "info string Persistent analysis file not set" << std::endl;
+        return;
+    }
+    // Flush this session first so the merged file holds everything searched so far.
+    if (!save_analysis_store_with_feedback(options.persistent_analysis_file, false)) {
+        return;
+    }
+    std::string error;
+    if (!sirio::merge_analysis_store_files({options.persistent_analysis_file, source},
+                                           options.persistent_analysis_file, &error)) {
+        std::cout << "info string Failed to merge persistent analysis store: " << error << std::endl;
+        return;
+    }
+    std::cout << "info string Persistent analysis store merged from " << source << std::endl;
+    mark_persistent_analysis_unloaded();
+    if (load_analysis_store_with_feedback(options.persistent_analysis_file, true)) {
         persistent_analysis_loaded = true;
     }
 }
 
 void on_persistent_analysis_clear(const Option&) {
-    sirio::clear_transposition_tables();
+    sirio::shared_analysis_store().clear();
     mark_persistent_analysis_unloaded();
-    std::cout << "info string Persistent analysis table cleared" << std::endl;
+    std::cout << "info string Persistent analysis store cleared" << std::endl;
     if (!options.persistent_analysis_file.empty()) {
         std::error_code ec;
         if (std::filesystem::remove(options.persistent_analysis_file, ec)) {
@@ -594,7 +733,11 @@ void on_persistent_analysis_clear(const Option&) {
 
 void on_clear_hash(const Option&) {
     sirio::clear_transposition_tables();
-    mark_persistent_analysis_unloaded();
+    if (sirio::shared_transposition_table().attached_to_shared_memory()) {
+        std::cout << "info string Shared transposition table " << options.shared_hash_name
+                  << " cleared for every attached process" << std::endl;
+        return;
+    }
     std::cout << "info string Transposition table cleared" << std::endl;
 }
 
@@ -713,6 +856,58 @@ void on_uci_show_wdl(const Option& opt) {
     options.uci_show_wdl = static_cast<bool>(opt);
 }
 
+// SyzygyPreload runs on its own thread so that `isready` is not held up by disk reads; the
+// report is printed by the command loop once the thread has finished.
+struct SyzygyPreloadTask {
+    std::thread thread;
+    bool running = false;
+    std::atomic<bool> done{false};
+    std::atomic<bool> cancel{false};
+    sirio::syzygy::PreloadReport report;
+};
+
+SyzygyPreloadTask syzygy_preload_task;
+
+void cancel_syzygy_preload() {
+    if (!syzygy_preload_task.running) {
+        return;
+    }
+    syzygy_preload_task.cancel.store(true, std::memory_order_relaxed);
+    syzygy_preload_task.thread.join();
+    syzygy_preload_task.running = false;
+}
+
+void start_syzygy_preload() {
+    cancel_syzygy_preload();
+    auto policy = sirio::syzygy::parse_preload_policy(options.syzygy_preload);
+    if (!policy.has_value() || policy->mode == sirio::syzygy::PreloadMode::None ||
+        options.syzygy_path.empty()) {
+        sirio::syzygy::release_preloaded_tables();
+        return;
+    }
+    syzygy_preload_task.done.store(false, std::memory_order_relaxed);
+    syzygy_preload_task.cancel.store(false, std::memory_order_relaxed);
+    syzygy_preload_task.running = true;
+    syzygy_preload_task.thread = std::thread([path = options.syzygy_path, policy = *policy]() {
+        syzygy_preload_task.report =
+            sirio::syzygy::preload_tables(path, policy, &syzygy_preload_task.cancel);
+        syzygy_preload_task.done.store(true, std::memory_order_release);
+    });
+}
+
+void report_syzygy_preload_if_done() {
+    if (!syzygy_preload_task.running || !syzygy_preload_task.done.load(std::memory_order_acquire)) {
+        return;
+    }
+    syzygy_preload_task.thread.join();
+    syzygy_preload_task.running = false;
+    const auto& report = syzygy_preload_task.report;
+    constexpr std::uint64_t kMiB = 1024 * 1024;
+    std::cout << "info string Syzygy preload: " << report.files << " files, "
+              << report.resident_bytes / kMiB << " MiB resident of " << report.mapped_bytes / kMiB
+              << " MiB (" << report.locked_bytes / kMiB << " MiB locked)" << std::endl;
+}
+
 void on_syzygy_path(const Option& opt) {
     if (g_silent_option_update) {
         return;
@@ -720,6 +915,15 @@ void on_syzygy_path(const Option& opt) {
     std::string path = normalize_string_option(static_cast<std::string>(opt));
     options.syzygy_path = path;
     sirio::syzygy::set_tablebase_path(path);
+    start_syzygy_preload();
+}
+
+void on_syzygy_preload(const Option& opt) {
+    if (g_silent_option_update) {
+        return;
+    }
+    options.syzygy_preload = static_cast<std::string>(opt);
+    start_syzygy_preload();
 }
 
 void on_syzygy_probe_depth(const Option& opt) {
@@ -947,6 +1151,9 @@ void ensure_options_registered() {
     g_options["HashFile"] = Option(std::string(""));
     g_options["HashFile"].after_set(on_hash_file);
 
+    g_options["SharedHashName"] = Option(std::string(""));
+    g_options["SharedHashName"].after_set(on_shared_hash_name);
+
     g_options["HashPersist"] = Option(false);
     g_options["HashPersist"].after_set(on_hash_persist);
 
@@ -958,6 +1165,8 @@ void ensure_options_registered() {
 
     g_options["PersistentAnalysisLoad"] = Option::Button(on_persistent_analysis_load);
     g_options["PersistentAnalysisSave"] = Option::Button(on_persistent_analysis_save);
+    g_options["PersistentAnalysisMerge"] = Option(std::string(""));
+    g_options["PersistentAnalysisMerge"].after_set(on_persistent_analysis_merge);
     g_options["PersistentAnalysisClear"] = Option::Button(on_persistent_analysis_clear);
 
     g_options["Analysis Lines"] = Option(1, 1, 256);
@@ -972,6 +1181,13 @@ void ensure_options_registered() {
     g_options["SyzygyProbeLimit"] = Option(7, 0, 7);
     g_options["SyzygyProbeLimit"].after_set(on_syzygy_probe_limit);
 
+    g_options["SMPDiversity"] = Option(true);
+    g_options["SMPDiversity"].after_set(on_smp_diversity);
+
+    g_options["SyzygyPreload"] =
+        Option::Combo("none", {"none", "wdl3", "wdl4", "wdl5", "wdl6", "wdl7", "all"});
+    g_options["SyzygyPreload"].after_set(on_syzygy_preload);
+
     g_options["EvalFileSmall"] = Option(std::string(kDefaultEvalFileSmall));
     g_options["EvalFileSmall"].after_set(on_eval_file_small);
 
@@ -1005,6 +1221,9 @@ void sync_options_from_state() {
     if (auto* opt = find_option("Threads")) {
         opt->set_int(options.threads);
     }
+    if (auto* opt = find_option("SMPDiversity")) {
+        opt->set_bool(options.smp_diversity);
+    }
     if (auto* opt = find_option("Hash")) {
         opt->set_int(static_cast<int>(options.hash_size_mb));
     }
@@ -1059,12 +1278,18 @@ void sync_options_from_state() {
     if (auto* opt = find_option("Syzygy50MoveRule")) {
         opt->set_bool(options.syzygy_50_move_rule);
     }
+    if (auto* opt = find_option("SyzygyPreload")) {
+        opt->set_string(options.syzygy_preload);
+    }
     if (auto* opt = find_option("SyzygyProbeLimit")) {
         opt->set_int(options.syzygy_probe_limit);
     }
     if (auto* opt = find_option("HashFile")) {
         opt->set_string(options.hash_persist_file);
     }
+    if (auto* opt = find_option("SharedHashName")) {
+        opt->set_string(options.shared_hash_name);
+    }
     if (auto* opt = find_option("HashPersist")) {
         opt->set_bool(options.hash_persist);
     }
@@ -1124,6 +1349,7 @@ void send_uci_id() {
     const char* large_page_status =
         sirio::transposition_table_large_pages_enabled() ? "available" : "not available";
     std::cout << "info string Large Memory Pages    : " << large_page_status << std::endl;
+    std::cout << "info string SIMD                  : " << sirio::cpu::describe_simd() << std::endl;
     print_uci_options(std::cout, g_options);
     std::cout << "uciok" << std::endl;
 }
@@ -1215,6 +1441,7 @@ void handle_go(const std::string& command_args, const sirio::Board& board) {
     bool has_time_information = false;
     bool infinite_requested = false;
     bool any_limit_specified = false;
+    bool reading_search_moves = false;
 
     try_autoload_persistent_analysis(false);
 
@@ -1288,8 +1515,18 @@ void handle_go(const std::string& command_args, const sirio::Board& board) {
             }
         } else if (token == "infinite") {
             infinite_requested = true;
+        } else if (token == "searchmoves") {
+            reading_search_moves = true;
+        } else if (reading_search_moves) {
+            // The move list runs until the next keyword; anything that is not a legal move is
+            // skipped.
+            try {
+                limits.search_moves.push_back(sirio::move_from_uci(board, token));
+            } catch (const std::exception&) {
+            }
         }
     }
+    limits.multi_pv = options.multi_pv;
 
     if (infinite_requested || (!any_limit_specified && !has_time_information && !depth_overridden &&
                                limits.max_nodes == 0)) {
@@ -1416,8 +1653,25 @@ void handle_bench() {
 
 void initialize() { initialize_impl(); }
 
-int run() {
+int run(int argc, char* argv[]) {
+    constexpr std::string_view simd_prefix = "--simd=";
+    for (int index = 1; index < argc; ++index) {
+        const std::string_view arg{argv[index]};
+        if (arg == "--startup-trace") {
+            startup_trace_enabled = true;
+        } else if (arg.rfind(simd_prefix, 0) == 0) {
+            // Caps the kernels below what CPUID reports, e.g. to reproduce another machine's results.
+            if (auto level = sirio::cpu::parse_simd_level(arg.substr(simd_prefix.size()))) {
+                sirio::cpu::set_simd_level(*level);
+            } else {
+                std::cerr << "Unknown SIMD level: " << arg.substr(simd_prefix.size()) << std::endl;
+            }
+        }
+    }
+    trace_startup("main");
     initialize();
+    trace_startup("options ready");
+    start_startup_tasks();
 
     sirio::Board board;
     sirio::initialize_evaluation(board);
@@ -1435,11 +1689,17 @@ int run() {
         stream >> command;
 
         try {
+            if (command != "uci") {
+                wait_for_startup_tasks(board);
+                report_syzygy_preload_if_done();
+            }
             if (command == "uci") {
                 send_uci_id();
+                trace_startup("uciok");
             } else if (command == "isready") {
                 stop_and_join_search();
                 send_ready(board);
+                trace_startup("readyok");
             } else if (command == "ucinewgame") {
                 stop_and_join_search();
                 board = sirio::Board{};
@@ -1479,6 +1739,11 @@ int run() {
     }
 
     stop_and_join_search();
+    cancel_syzygy_preload();
+    if (startup_tasks.pending) {
+        startup_tasks.thread.join();
+        startup_tasks.pending = false;
+    }
     save_persistent_analysis_if_enabled(false);
     return 0;
 }
@@ -3,10 +3,17 @@
 #include <fstream>
 #include <bit>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
+#include "sirio/bitboard.hpp"
 #include "sirio/board.hpp"
+#include "sirio/cpu_features.hpp"
 #include "sirio/draws.hpp"
 #include "sirio/endgame.hpp"
 #include "sirio/move.hpp"
@@ -15,7 +22,9 @@
 #include "sirio/syzygy.hpp"
 
 void run_perft_tests();
+void run_pgn_tests();
 void run_tt_tests();
+void run_libsirio_tests();
 void run_evaluation_phase_tests();
 void run_evaluation_route_harness_tests();
 void run_search_tests();
@@ -75,6 +84,42 @@ void test_fen_roundtrip() {
     assert(board.fullmove_number() == 42);
 }
 
+void test_fen_parser_reports_errors() {
+    sirio::Board board;
+    assert(board.parse_fen("8/8/8/3k4/4R3/8/8/4K3 w - -") == sirio::FenError::MissingFields);
+    assert(board.parse_fen("8/8/8/3k4/4R3/8/8/4K3/8 w - - 0 1") == sirio::FenError::InvalidPlacement);
+    assert(board.parse_fen("8/8/8/3k4/4X3/8/8/4K3 w - - 0 1") == sirio::FenError::InvalidPlacement);
+    assert(board.parse_fen("8/8/8/3k4/4R3/8/8/4K3 x - - 0 1") == sirio::FenError::InvalidSideToMove);
+    assert(board.parse_fen("8/8/8/3k4/4R3/8/8/4K3 w KX - 0 1") == sirio::FenError::InvalidCastling);
+    assert(board.parse_fen("8/8/8/3k4/4R3/8/8/4K3 w - z9 0 1") == sirio::FenError::InvalidEnPassant);
+    assert(board.parse_fen("8/8/8/3k4/4R3/8/8/4K3 w - - 1x 1") == sirio::FenError::InvalidCounters);
+    assert(board.parse_fen("8/8/8/3k4/4R3/8/8/4K3 w - - 0 0") == sirio::FenError::InvalidCounters);
+    assert(board.occupancy() == 0);
+
+    bool threw = false;
+    try {
+        board.set_from_fen("8/8/8/3k4/4R3/8/8/4K3 w KX - 0 1");
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    const std::string fen = "r3k2r/pp3ppp/8/3pP3/8/8/PPP2PPP/R3K2R w KQkq d6 0 12";
+    assert(board.parse_fen("  " + fen + "  extra") == sirio::FenError::None);
+    assert(board.zobrist_hash() == sirio::Board{fen}.zobrist_hash());
+    char buffer[sirio::Board::max_fen_length];
+    const std::size_t length = board.write_fen(buffer, sizeof(buffer));
+    assert(std::string_view(buffer, length) == fen);
+    assert(buffer[length] == '\0');
+    assert(board.write_fen(buffer, length) == 0);
+
+    std::string_view operations;
+    assert(board.parse_epd("r3k2r/pp3ppp/8/3pP3/8/8/PPP2PPP/R3K2R w KQkq d6 bm e5d6; id \"ep\";",
+                           &operations) == sirio::FenError::None);
+    assert(operations == "bm e5d6; id \"ep\";");
+    assert(board.to_fen() == "r3k2r/pp3ppp/8/3pP3/8/8/PPP2PPP/R3K2R w KQkq d6 0 1");
+}
+
 void test_attack_detection() {
     const std::string fen = "8/8/8/3k4/4R3/8/8/4K3 w - - 0 1";
     sirio::Board board{fen};
@@ -90,6 +135,132 @@ void test_attack_detection() {
     assert(!knight_board.is_square_attacked(e4, sirio::Color::White));
 }
 
+void test_simd_levels_agree_with_scalar() {
+    using sirio::cpu::SimdLevel;
+    const SimdLevel detected = sirio::cpu::detected_simd_level();
+    assert(sirio::cpu::active_simd_level() == detected);
+
+    // Odd lengths exercise the scalar tails after the vector loops.
+    constexpr std::size_t kCount = 37;
+    std::vector<std::int16_t> weights(kCount);
+    std::vector<std::int32_t> accumulator(kCount);
+    std::vector<double> double_weights(kCount);
+    std::vector<int> values(kCount);
+    std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    const auto next = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    for (std::size_t i = 0; i < kCount; ++i) {
+        weights[i] = static_cast<std::int16_t>(next());
+        accumulator[i] = static_cast<std::int32_t>(next() % 2000001) - 1000000;
+        double_weights[i] = static_cast<double>(static_cast<int>(next() % 2001) - 1000) / 8.0;
+        values[i] = static_cast<int>(next() % 17);
+    }
+
+    const std::string fen = "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 9";
+    const sirio::Board board{fen};
+    const auto occupancy = board.occupancy();
+
+    const auto run_level = [&](SimdLevel level) {
+        assert(sirio::cpu::set_simd_level(level) == level);
+        const auto &kernels = sirio::cpu::kernels();
+        assert(kernels.level == level);
+        std::vector<std::int32_t> updated = accumulator;
+        kernels.accumulate_row(updated.data(), weights.data(), kCount, -3);
+        std::uint64_t attacks = 0;
+        for (int square = 0; square < 64; ++square) {
+            attacks = attacks * 31 + sirio::rook_attacks(square, occupancy);
+            attacks = attacks * 31 + sirio::bishop_attacks(square, occupancy);
+        }
+        return std::tuple{updated, kernels.relu_dot(accumulator.data(), weights.data(), kCount),
+                          kernels.dot_weights(double_weights.data(), values.data(), kCount), attacks};
+    };
+
+    const auto reference = run_level(SimdLevel::Scalar);
+    for (int level = 1; level <= static_cast<int>(detected); ++level) {
+        const auto result = run_level(static_cast<SimdLevel>(level));
+        assert(std::get<0>(result) == std::get<0>(reference));
+        assert(std::get<1>(result) == std::get<1>(reference));
+        // Weights are multiples of 1/8, so every summation order is exact.
+        assert(std::get<2>(result) == std::get<2>(reference));
+        assert(std::get<3>(result) == std::get<3>(reference));
+    }
+    assert(sirio::cpu::set_simd_level(SimdLevel::Avx512) == detected);
+    assert(sirio::cpu::parse_simd_level("avx-512") == SimdLevel::Avx512);
+    assert(sirio::cpu::parse_simd_level("SSE4.1") == SimdLevel::Sse41);
+    assert(!sirio::cpu::parse_simd_level("neon").has_value());
+}
+
+void test_cached_checkers_and_king_blockers() {
+    // Black rook on e8 checks the white king on e1; the white bishop on d2 is pinned by the
+    // black queen on a5.
+    sirio::Board board{"4r1k1/8/8/q7/8/8/3B4/4K3 w - - 0 1"};
+    const int e1 = square_index('e', 1);
+    const int d2 = square_index('d', 2);
+    const int e8 = square_index('e', 8);
+    assert(board.in_check(sirio::Color::White));
+    assert(board.checkers() == sirio::one_bit(e8));
+    assert(board.pinned_pieces(sirio::Color::White) == sirio::one_bit(d2));
+    assert(board.pinned_pieces(sirio::Color::Black) == 0);
+
+    // Only king moves off the e-file and the pinned bishop cannot interpose.
+    for (const auto &move : sirio::generate_legal_moves(board)) {
+        assert(move.piece == sirio::PieceType::King);
+        assert(move.from == e1);
+    }
+
+    // The white bishop on e2 shields the black king from the rook on e1, so moving it gives a
+    // discovered (here double) check that is visible in the cached state after make_move.
+    sirio::Board discovered{"4k3/8/8/8/8/8/4B3/4R1K1 w - - 0 1"};
+    const int e2 = square_index('e', 2);
+    const int b5 = square_index('b', 5);
+    assert(discovered.king_blockers(sirio::Color::Black) == sirio::one_bit(e2));
+    assert(discovered.pinned_pieces(sirio::Color::White) == 0);
+    const auto move = sirio::move_from_uci(discovered, "e2b5");
+    sirio::Board::UndoState undo;
+    discovered.make_move(move, undo);
+    assert(discovered.in_check(sirio::Color::Black));
+    assert(discovered.checkers() == (sirio::one_bit(e1) | sirio::one_bit(b5)));
+    discovered.undo_move(move, undo);
+    assert(discovered.checkers() == 0);
+    assert(discovered.king_blockers(sirio::Color::Black) == sirio::one_bit(e2));
+}
+
+void test_gives_check_matches_make_move() {
+    // Covers direct, discovered, promotion, en passant and castling checks.
+    const std::vector<std::string> fens{
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/8/8/K2pP2q/8/8/8/7k w - d6 0 1",
+        "5k2/8/8/8/8/8/8/4K2R w K - 0 1",
+        "3k4/1P6/8/8/8/8/4B3/4R1K1 w - - 0 1",
+    };
+    for (const auto &fen : fens) {
+        sirio::Board board{fen};
+        for (const auto &move : sirio::generate_legal_moves(board)) {
+            const bool predicted = board.gives_check(move);
+            sirio::Board::UndoState undo;
+            board.make_move(move, undo);
+            assert(predicted == board.in_check(board.side_to_move()));
+            board.undo_move(move, undo);
+        }
+    }
+
+    // Every bishop move off the e-file uncovers the rook; no rook move checks.
+    const sirio::Board discovered{"4k3/8/8/8/8/8/4B3/4R1K1 w - - 0 1"};
+    const auto quiet_checks = sirio::generate_pseudo_legal_quiet_checks(discovered);
+    assert(quiet_checks.size() == 9);
+    for (const auto &move : quiet_checks) {
+        assert(move.piece == sirio::PieceType::Bishop);
+        assert(!move.captured.has_value());
+    }
+}
+
 void test_en_passant() {
     const std::string fen = "8/8/8/3Pp3/8/8/8/4K3 w - e6 0 1";
     sirio::Board board{fen};
@@ -305,6 +476,44 @@ void test_syzygy_option_configuration() {
     assert(!sirio::syzygy::available());
 }
 
+void test_syzygy_preload_selects_tables_by_policy() {
+    assert(sirio::syzygy::parse_preload_policy("none")->mode == sirio::syzygy::PreloadMode::None);
+    assert(sirio::syzygy::parse_preload_policy("WDL5")->max_pieces == 5);
+    assert(sirio::syzygy::parse_preload_policy("all")->mode == sirio::syzygy::PreloadMode::All);
+    assert(!sirio::syzygy::parse_preload_policy("wdl9").has_value());
+
+    const auto directory = std::filesystem::temp_directory_path() / "sirio_syzygy_preload";
+    std::filesystem::create_directories(directory);
+    for (const char *name : {"KQvK.rtbw", "KQvK.rtbz", "KRPPvKR.rtbw", "notes.txt"}) {
+        std::ofstream out(directory / name, std::ios::binary);
+        out << std::string(10000, 'x');
+    }
+
+    sirio::syzygy::PreloadPolicy small_wdl{sirio::syzygy::PreloadMode::WdlUpTo, 5};
+    auto report = sirio::syzygy::preload_tables(directory.string(), small_wdl);
+#if !defined(_WIN32)
+    assert(report.files == 1 && report.mapped_bytes == 10000);
+    assert(report.resident_bytes == 10000);
+
+    report = sirio::syzygy::preload_tables(directory.string(),
+                                           *sirio::syzygy::parse_preload_policy("all"));
+    assert(report.files == 3 && report.mapped_bytes == 30000);
+
+    // A table spanning several preload chunks is still brought in completely.
+    const std::uintmax_t large_size = 40ULL << 20;
+    std::ofstream(directory / "KRvK.rtbw", std::ios::binary).close();
+    std::filesystem::resize_file(directory / "KRvK.rtbw", large_size);
+    report = sirio::syzygy::preload_tables(directory.string(), small_wdl);
+    assert(report.files == 2 && report.mapped_bytes == large_size + 10000);
+    assert(report.resident_bytes == report.mapped_bytes);
+    assert(report.locked_bytes <= report.mapped_bytes);
+#endif
+    report = sirio::syzygy::preload_tables(directory.string(), sirio::syzygy::PreloadPolicy{});
+    assert(report.files == 0);
+    sirio::syzygy::release_preloaded_tables();
+    std::filesystem::remove_all(directory);
+}
+
 void test_sufficient_material_to_force_checkmate() {
     sirio::Board only_kings{"7k/8/8/8/8/8/8/4K3 w - - 0 1"};
     assert(!sirio::sufficient_material_to_force_checkmate(only_kings));
@@ -424,7 +633,11 @@ void test_nnue_backend_material_weights() {
 int main() {
     test_start_position();
     test_fen_roundtrip();
+    test_fen_parser_reports_errors();
     test_attack_detection();
+    test_simd_levels_agree_with_scalar();
+    test_cached_checkers_and_king_blockers();
+    test_gives_check_matches_make_move();
     test_en_passant();
     test_en_passant_zobrist_hash_without_capture();
     test_en_passant_zobrist_hash_with_capture();
@@ -446,6 +659,7 @@ int main() {
     test_king_safety_weak_squares();
     test_evaluation_passed_pawn();
     test_syzygy_option_configuration();
+    test_syzygy_preload_selects_tables_by_policy();
     test_evaluation_backend_consistency();
     test_nnue_backend_material_weights();
     run_nnue_backend_tests();
@@ -472,7 +686,9 @@ int main() {
     run_evaluation_phase_tests();
     run_evaluation_route_harness_tests();
     run_tt_tests();
+    run_libsirio_tests();
     run_perft_tests();
+    run_pgn_tests();
     std::cout << "All tests passed.\n";
     return 0;
 }
@@ -1,10 +1,13 @@
 #include <cassert>
+#include <cmath>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "sirio/board.hpp"
 #include "sirio/evaluation.hpp"
+#include "sirio/evaluation_trace.hpp"
 
 namespace {
 
@@ -21,6 +24,26 @@ void test_passed_pawn_scaling() {
     assert(end_eval > 0);
 }
 
+void test_pawn_structure_is_colour_symmetric() {
+    // Each pair is the same position with the board mirrored and the colours swapped; the
+    // set-wise pawn terms run through separate white and black instantiations.
+    const std::vector<std::pair<std::string, std::string>> pairs{
+        {"8/pp3k2/2p1pp2/3p4/3P1P2/2P1P1P1/PP3K2/8 w - - 0 1",
+         "8/pp3k2/2p1p1p1/3p1p2/3P4/2P1PP2/PP3K2/8 b - - 0 1"},
+        {"4k3/1p1p4/8/2P1P3/8/8/P7/4K3 w - - 0 1", "4k3/p7/8/8/2p1p3/8/1P1P4/4K3 b - - 0 1"},
+        {"r1bq1rk1/pp2ppbp/2np1np1/8/3NP3/2N1BP2/PPPQ2PP/R3KB1R w - - 0 9",
+         "r3kb1r/pppq2pp/2n1bp2/3np3/8/2NP1NP1/PP2PPBP/R1BQ1RK1 b - - 0 1"},
+    };
+    for (const auto &[fen, mirrored_fen] : pairs) {
+        sirio::Board board{fen};
+        sirio::initialize_evaluation(board);
+        const int eval = sirio::evaluate(board);
+        sirio::Board mirrored{mirrored_fen};
+        sirio::initialize_evaluation(mirrored);
+        assert(sirio::evaluate(mirrored) == -eval);
+    }
+}
+
 void test_king_safety_tapering() {
     sirio::Board exposed_mid{"r4rk1/ppp2ppp/8/8/8/6q1/PP3PPP/R4RK1 w - - 0 1"};
     sirio::initialize_evaluation(exposed_mid);
@@ -78,12 +101,44 @@ void test_pawn_cache_stability_on_non_pawn_moves() {
     assert(sirio::classical_evaluation_pawn_cache_misses() == baseline_misses);
 }
 
+void test_classical_trace_reproduces_evaluation() {
+    const std::vector<sirio::ClassicalWeight> weights = sirio::classical_weights();
+    std::size_t expected = 0;
+    for (const sirio::ClassicalWeightGroup &group : sirio::classical_weight_groups()) {
+        expected += group.size == 0 ? 1 : group.size;
+    }
+    assert(weights.size() == expected);
+
+    sirio::ClassicalEvaluationTrace trace;
+    sirio::Board start;
+    bool traced = sirio::trace_classical_evaluation(start, trace);
+    assert(traced && trace.phase == 24 && trace.scale == 1.0F);
+    assert(trace.evaluation == 0 && sirio::evaluate_classical_trace(trace, weights) == 0.0);
+
+    // Away from the bare-king endgame heuristics only the rounding of each scaled term differs.
+    for (const char *fen : {"r1bq1rk1/pp2ppbp/2np1np1/8/3NP3/2N1BP2/PPPQ2PP/R3KB1R w KQ - 0 9",
+                            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                            "2r2rk1/pp3ppp/2n1b3/8/3P4/2B2N2/PP3PPP/2R2RK1 b - - 0 18"}) {
+        sirio::Board board{fen};
+        traced = sirio::trace_classical_evaluation(board, trace);
+        assert(traced && !trace.terms.empty());
+        const double linear = sirio::evaluate_classical_trace(trace, weights);
+        assert(std::abs(linear - trace.evaluation) <= 4.0);
+    }
+
+    // KPK is scored by the specialised endgame evaluator.
+    sirio::Board kpk{"8/8/8/4k3/8/8/4P3/4K3 w - - 0 1"};
+    assert(!sirio::trace_classical_evaluation(kpk, trace));
+}
+
 }  // namespace
 
 void run_evaluation_phase_tests() {
     sirio::use_classical_evaluation();
     test_passed_pawn_scaling();
+    test_pawn_structure_is_colour_symmetric();
     test_king_safety_tapering();
     test_queen_ring_pressure_penalty();
     test_pawn_cache_stability_on_non_pawn_moves();
+    test_classical_trace_reproduces_evaluation();
 }
@@ -802,6 +802,20 @@ void test_reverse_futility_helper_allows_pruning_only_when_guards_and_margin_pas
         depth, beta + margin - 1, beta, false, false, false, false));
 }
 
+void test_late_move_reduction_adjustment_follows_history_and_node_type() {
+    using sirio::search_params::late_move_reduction_adjustment;
+    const int neutral = late_move_reduction_adjustment(0, true, false, false, false);
+    assert(neutral == 0);
+    assert(late_move_reduction_adjustment(sirio::search_params::history_max, true, false, false, false) <
+           neutral);
+    assert(late_move_reduction_adjustment(sirio::search_params::history_min, true, false, false, false) >
+           neutral);
+    assert(late_move_reduction_adjustment(0, false, false, false, false) > neutral);
+    assert(late_move_reduction_adjustment(0, true, true, false, false) > neutral);
+    assert(late_move_reduction_adjustment(0, true, false, true, false) > neutral);
+    assert(late_move_reduction_adjustment(0, true, false, false, true) < neutral);
+}
+
 void test_reverse_futility_margin_helper_is_deterministic_and_non_negative() {
     constexpr int depth = 5;
     const int first = sirio::search_params::reverse_futility_margin(depth, false);
@@ -870,6 +884,40 @@ void test_reverse_futility_helper_no_side_effects_or_history_dependency() {
 }
 
 
+void test_null_move_helper_allows_pruning_only_when_guards_pass() {
+    constexpr int depth = 6;
+    const int beta = 120;
+    assert(sirio::search_params::should_apply_null_move_pruning(depth, beta, beta, false, false, false, true, false));
+    assert(!sirio::search_params::should_apply_null_move_pruning(depth, beta - 1, beta, false, false, false, true, false));
+    assert(!sirio::search_params::should_apply_null_move_pruning(depth, beta + 50, beta, true, false, false, true, false));
+    assert(!sirio::search_params::should_apply_null_move_pruning(depth, beta + 50, beta, false, true, false, true, false));
+    assert(!sirio::search_params::should_apply_null_move_pruning(depth, beta + 50, beta, false, false, true, true, false));
+    assert(!sirio::search_params::should_apply_null_move_pruning(depth, beta + 50, beta, false, false, false, false, false));
+    assert(!sirio::search_params::should_apply_null_move_pruning(depth, beta + 50, beta, false, false, false, true, true));
+    assert(!sirio::search_params::should_apply_null_move_pruning(
+        sirio::search_params::null_move_depth_limit - 1, beta + 50, beta, false, false, false, true, false));
+}
+
+void test_null_move_reduction_grows_with_depth_and_eval_margin() {
+    const int beta = 0;
+    const int shallow = sirio::search_params::null_move_reduction(4, beta, beta);
+    const int deep = sirio::search_params::null_move_reduction(16, beta, beta);
+    const int large_margin = sirio::search_params::null_move_reduction(4, beta + 1000, beta);
+    const int huge_margin = sirio::search_params::null_move_reduction(4, beta + 100000, beta);
+
+    assert(shallow >= sirio::search_params::null_move_base_reduction);
+    assert(deep > shallow);
+    assert(large_margin > shallow);
+    assert(huge_margin - shallow <= sirio::search_params::null_move_max_eval_reduction);
+}
+
+void test_null_move_verification_only_at_high_depth() {
+    assert(!sirio::search_params::null_move_requires_verification(
+        sirio::search_params::null_move_verification_depth - 1));
+    assert(sirio::search_params::null_move_requires_verification(
+        sirio::search_params::null_move_verification_depth));
+}
+
 void test_move_count_pruning_constants_are_conservative_and_explicit() {
     assert(sirio::search_params::selectivity_move_count_pruning_enabled);
     assert(sirio::search_params::move_count_pruning_depth_limit > 0);
@@ -1517,6 +1565,80 @@ void test_move_count_pruning_continue_observability_counter_lifecycle() {
     assert(history.move_count_pruning_continue_count_for_tests() == 0);
 }
 
+void test_null_move_pruning_observability_counter_lifecycle() {
+    sirio::SearchHistory history;
+    assert(history.null_move_cutoff_count_for_tests() == 0);
+    assert(history.null_move_verification_count_for_tests() == 0);
+    assert(history.null_move_verification_failed_count_for_tests() == 0);
+    assert(history.null_move_tt_skip_count_for_tests() == 0);
+    history.record_null_move_cutoff();
+    history.record_null_move_verification();
+    history.record_null_move_verification_failed();
+    history.record_null_move_tt_skip();
+    assert(history.null_move_cutoff_count_for_tests() == 1);
+    assert(history.null_move_verification_count_for_tests() == 1);
+    assert(history.null_move_verification_failed_count_for_tests() == 1);
+    assert(history.null_move_tt_skip_count_for_tests() == 1);
+    assert(history.null_move_pruning_runtime_counters().cutoff_applied == 1);
+    history.clear();
+    assert(history.null_move_cutoff_count_for_tests() == 0);
+    assert(history.null_move_verification_count_for_tests() == 0);
+    assert(history.null_move_verification_failed_count_for_tests() == 0);
+    assert(history.null_move_tt_skip_count_for_tests() == 0);
+}
+void test_mate_distance_bounds_clamp_window_to_reachable_mates() {
+    using namespace sirio::search_params;
+    assert(mate_in(3) == mate_score - 3);
+    assert(mated_in(3) == -mate_score + 3);
+    assert(is_mate_score(mate_in(10)));
+    assert(is_mate_score(mated_in(10)));
+    assert(!is_mate_score(900));
+
+    assert(mate_distance_alpha(-mate_score, 4) == mated_in(4));
+    assert(mate_distance_alpha(50, 4) == 50);
+    assert(mate_distance_beta(mate_score, 4) == mate_in(5));
+    assert(mate_distance_beta(50, 4) == 50);
+
+    // Once a mate in 3 plies is known at the root, a node at ply 3 cannot improve on it.
+    const int alpha = mate_distance_alpha(mate_in(3), 3);
+    const int beta = mate_distance_beta(mate_score, 3);
+    assert(alpha >= beta);
+}
+void test_mate_distance_observability_counter_lifecycle() {
+    sirio::SearchHistory history;
+    assert(history.mate_distance_prune_count_for_tests() == 0);
+    history.record_mate_distance_prune();
+    assert(history.mate_distance_prune_count_for_tests() == 1);
+    assert(history.mate_distance_runtime_counters().prune_applied == 1);
+    history.clear();
+    assert(history.mate_distance_prune_count_for_tests() == 0);
+}
+void test_research_observability_counter_lifecycle() {
+    sirio::SearchHistory history;
+    assert(history.zero_window_search_count_for_tests() == 0);
+    assert(history.lmr_research_count_for_tests() == 0);
+    assert(history.pvs_research_count_for_tests() == 0);
+    history.record_zero_window_search();
+    history.record_zero_window_search();
+    history.record_lmr_research(40);
+    history.record_pvs_research(25);
+    history.record_pvs_research(5);
+    assert(history.zero_window_search_count_for_tests() == 2);
+    assert(history.lmr_research_count_for_tests() == 1);
+    assert(history.pvs_research_count_for_tests() == 2);
+    assert(history.research_runtime_counters().lmr_research_nodes == 40);
+    assert(history.research_runtime_counters().pvs_research_nodes == 30);
+    history.record_lmr_reduction(2);
+    history.record_lmr_reduction(3);
+    assert(history.research_runtime_counters().lmr_reduction_applied == 2);
+    assert(history.research_runtime_counters().lmr_reduction_plies == 5);
+    history.clear();
+    assert(history.research_runtime_counters().lmr_reduction_applied == 0);
+    assert(history.zero_window_search_count_for_tests() == 0);
+    assert(history.lmr_research_count_for_tests() == 0);
+    assert(history.pvs_research_count_for_tests() == 0);
+    assert(history.research_runtime_counters().pvs_research_nodes == 0);
+}
 void test_probcut_probe_observability_counter_lifecycle() {
     sirio::SearchHistory history;
     assert(history.probcut_probe_count_for_tests() == 0);
@@ -2263,6 +2385,7 @@ void run_history_tests() {
     test_search_selectivity_foundation_flags_contract();
     test_search_selectivity_foundation_helpers_contract();
     test_reverse_futility_helper_allows_pruning_only_when_guards_and_margin_pass();
+    test_late_move_reduction_adjustment_follows_history_and_node_type();
     test_reverse_futility_margin_helper_is_deterministic_and_non_negative();
     test_reverse_futility_margin_helper_depth_progression_is_stable();
     test_reverse_futility_margin_helper_improving_mode_is_deterministic();
@@ -2271,6 +2394,9 @@ void run_history_tests() {
     test_reverse_futility_helper_root_node_is_disabled();
     test_reverse_futility_helper_invalid_depth_is_disabled();
     test_reverse_futility_helper_no_side_effects_or_history_dependency();
+    test_null_move_helper_allows_pruning_only_when_guards_pass();
+    test_null_move_reduction_grows_with_depth_and_eval_margin();
+    test_null_move_verification_only_at_high_depth();
     test_move_count_pruning_constants_are_conservative_and_explicit();
     test_move_count_pruning_helper_allows_continue_only_when_all_guards_pass_and_move_count_exceeds_threshold();
     test_move_count_pruning_threshold_helper_is_deterministic();
@@ -2353,6 +2479,10 @@ void run_history_tests() {
     test_probcut_helper_rejects_explicit_classified_quiet_and_promotion_candidates();
     test_reverse_futility_return_observability_counter_lifecycle();
     test_move_count_pruning_continue_observability_counter_lifecycle();
+    test_null_move_pruning_observability_counter_lifecycle();
+    test_mate_distance_bounds_clamp_window_to_reachable_mates();
+    test_mate_distance_observability_counter_lifecycle();
+    test_research_observability_counter_lifecycle();
     test_probcut_probe_observability_counter_lifecycle();
     test_probcut_candidate_source_none_observability_counter_lifecycle();
     test_probcut_candidate_source_explicit_flags_observability_counter_lifecycle();
@@ -0,0 +1,126 @@
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "sirio/libsirio.h"
+
+namespace {
+
+struct CallbackLog {
+    int calls = 0;
+    int last_depth = 0;
+};
+
+void record_info(const sirio_search_info *info, void *user_data) {
+    auto *log = static_cast<CallbackLog *>(user_data);
+    assert(info != nullptr);
+    assert(info->depth >= log->last_depth);
+    log->last_depth = info->depth;
+    ++log->calls;
+}
+
+void test_search_reports_structured_results() {
+    assert(sirio_api_version() == SIRIO_API_VERSION);
+    sirio_engine *engine = sirio_engine_create(8, 1);
+    assert(engine != nullptr);
+
+    // Scholar's mate setup: Qxf7# is the only mate in one.
+    const char *moves[] = {"e2e4", "e7e5", "f1c4", "b8c6", "d1h5", "g8f6"};
+    assert(sirio_engine_set_position(engine, nullptr, moves, 6) == SIRIO_OK);
+
+    sirio_search_limits limits{};
+    limits.depth = 3;
+    CallbackLog log;
+    sirio_search_info result{};
+    assert(sirio_engine_search(engine, &limits, record_info, &log, &result) == SIRIO_OK);
+    assert(log.calls > 0);
+    assert(result.is_mate == 1 && result.score == 1);
+    assert(result.pv_length >= 1 && result.pv[0] == result.best_move);
+    char uci[6];
+    assert(sirio_move_to_uci(result.best_move, uci, sizeof(uci)) == SIRIO_OK);
+    assert(std::string{uci} == "h5f7");
+    assert(result.nodes > 0);
+
+    const char *illegal[] = {"e2e5"};
+    assert(sirio_engine_set_position(engine, nullptr, illegal, 1) == SIRIO_ERROR_ILLEGAL_MOVE);
+    assert(std::strlen(sirio_engine_last_error(engine)) > 0);
+    assert(sirio_engine_set_position(engine, "not a fen", nullptr, 0) == SIRIO_ERROR_INVALID_FEN);
+
+    assert(sirio_engine_set_option(engine, "Threads", "2") == SIRIO_OK);
+    assert(sirio_engine_set_option(engine, "Hash", "zero") == SIRIO_ERROR_INVALID_VALUE);
+    assert(sirio_engine_set_option(engine, "Ponder", "true") == SIRIO_ERROR_UNKNOWN_OPTION);
+    assert(sirio_engine_set_option(engine, "Clear Hash", nullptr) == SIRIO_OK);
+    assert(std::strlen(sirio_engine_last_error(engine)) == 0);
+
+    sirio_engine_destroy(engine);
+}
+
+void test_batch_evaluation_uses_side_to_move_perspective() {
+    sirio_engine *engine = sirio_engine_create(1, 1);
+    assert(engine != nullptr);
+    assert(sirio_engine_set_option(engine, "EvalFile", "classical") == SIRIO_OK);
+
+    const char *fens[] = {
+        "4k3/8/8/8/8/8/8/3QK3 w - - 0 1",
+        "4k3/8/8/8/8/8/8/3QK3 b - - 0 1",
+        "invalid",
+    };
+    std::int32_t scores[3] = {0, 0, 0};
+    assert(sirio_engine_evaluate(engine, fens, 3, scores) == SIRIO_ERROR_INVALID_FEN);
+    assert(scores[0] > 500);
+    assert(scores[1] == -scores[0]);
+    assert(scores[2] == SIRIO_EVAL_INVALID);
+    assert(sirio_engine_evaluate(engine, fens, 2, scores) == SIRIO_OK);
+
+    sirio_engine_destroy(engine);
+}
+
+void test_stop_while_idle_does_not_cut_the_next_search() {
+    sirio_engine *engine = sirio_engine_create(8, 1);
+    assert(engine != nullptr);
+    assert(sirio_engine_set_position(engine, nullptr, nullptr, 0) == SIRIO_OK);
+
+    sirio_engine_stop(engine);
+    sirio_search_limits limits{};
+    limits.depth = 4;
+    sirio_search_info result{};
+    assert(sirio_engine_search(engine, &limits, nullptr, nullptr, &result) == SIRIO_OK);
+    assert(result.depth == 4);
+    assert(result.best_move != SIRIO_NULL_MOVE);
+
+    sirio_engine_destroy(engine);
+}
+
+void test_clock_limits_are_never_infinite() {
+    sirio_engine *engine = sirio_engine_create(8, 1);
+    assert(engine != nullptr);
+    assert(sirio_engine_set_position(engine, nullptr, nullptr, 0) == SIRIO_OK);
+
+    // An increment alone is a clock for the side to move, so the search ends on its own.
+    sirio_search_limits limits{};
+    limits.white_increment_ms = 50;
+    sirio_search_info result{};
+    assert(sirio_engine_search(engine, &limits, nullptr, nullptr, &result) == SIRIO_OK);
+    assert(result.best_move != SIRIO_NULL_MOVE);
+
+    // Without a time or increment for the side to move there is nothing to budget from.
+    limits = sirio_search_limits{};
+    limits.moves_to_go = 20;
+    assert(sirio_engine_search(engine, &limits, nullptr, nullptr, &result) ==
+           SIRIO_ERROR_INVALID_ARGUMENT);
+    limits.black_increment_ms = 50;
+    assert(sirio_engine_search(engine, &limits, nullptr, nullptr, &result) ==
+           SIRIO_ERROR_INVALID_ARGUMENT);
+
+    sirio_engine_destroy(engine);
+}
+
+}  // namespace
+
+void run_libsirio_tests() {
+    test_search_reports_structured_results();
+    test_batch_evaluation_uses_side_to_move_perspective();
+    test_stop_while_idle_does_not_cut_the_next_search();
+    test_clock_limits_are_never_infinite();
+}
@@ -1,7 +1,10 @@
 #include <cassert>
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "sirio/nnue/backend.hpp"
 
@@ -149,6 +152,64 @@ void test_white_pov_accumulator_side_to_move_invariant() {
     assert(white_score == black_score);
 }
 
+void test_memory_mapped_network_matches_file_load() {
+    // Synthetic network with a deterministic weight pattern, so the test needs no exporter.
+    const auto header = sirio::nnue::make_default_nnue2_header();
+    std::vector<std::int16_t> payload(
+        (header.input_weights_bytes + header.hidden_bias_bytes + header.output_weights_bytes) /
+        sizeof(std::int16_t));
+    for (std::size_t index = 0; index < payload.size(); ++index) {
+        payload[index] = static_cast<std::int16_t>(static_cast<int>((index * 2654435761u) % 97) - 48);
+    }
+    const std::int32_t output_bias = 1234;
+    std::vector<char> raw(sizeof(header) + header.payload_bytes);
+    std::memcpy(raw.data(), &header, sizeof(header));
+    std::memcpy(raw.data() + sizeof(header), payload.data(), payload.size() * sizeof(std::int16_t));
+    std::memcpy(raw.data() + raw.size() - sizeof(output_bias), &output_bias, sizeof(output_bias));
+
+    const auto path = std::filesystem::temp_directory_path() / "sirio_nnue2_mapped.nnue2";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(raw.data(), static_cast<std::streamsize>(raw.size()));
+    }
+    sirio::nnue::Nnue2NetworkParameters file_net;
+    std::string error;
+    assert(sirio::nnue::load_nnue2_network_file(path.string(), file_net, error));
+
+    // 4-byte words keep the image aligned the way the embedded section is.
+    std::vector<std::uint32_t> storage((raw.size() + 3) / 4);
+    std::memcpy(storage.data(), raw.data(), raw.size());
+    const std::span<const std::byte> image{reinterpret_cast<const std::byte *>(storage.data()), raw.size()};
+
+    sirio::nnue::Nnue2NetworkParameters mapped;
+    assert(sirio::nnue::map_nnue2_network_memory(image, mapped, error));
+    assert(mapped.is_borrowed() && mapped.input_weights.empty());
+    assert(reinterpret_cast<const std::byte *>(mapped.input_weights_view().data()) ==
+           image.data() + sizeof(sirio::nnue::Nnue2BinaryHeader));
+    assert(mapped.output_bias == output_bias && file_net.output_bias == output_bias);
+
+    for (const char *fen : {
+             "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+             "r3k2r/pp3ppp/2n1bn2/3p4/3P4/2N1PN2/PP3PPP/R3K2R w KQkq - 0 1",
+         }) {
+        sirio::Board board{fen};
+        std::int32_t file_score = 0;
+        std::int32_t mapped_score = 0;
+        assert(sirio::nnue::evaluate_loaded_nnue2_minimal_v1(board, file_net, file_score, error));
+        assert(sirio::nnue::evaluate_loaded_nnue2_minimal_v1(board, mapped, mapped_score, error));
+        assert(file_score == mapped_score);
+    }
+
+    assert(!sirio::nnue::map_nnue2_network_memory(image.first(image.size() - 1), mapped, error));
+    assert(error == "Truncated SirioNNUE2 payload");
+    assert(!mapped.is_initialized());
+
+    // Test builds carry no embedded network.
+    assert(sirio::nnue::embedded_network_image().empty());
+    assert(sirio::nnue::embedded_network(&error) == nullptr);
+    std::filesystem::remove(path);
+}
+
 }  // namespace
 
 void run_nnue_inference_v2_tests() {
@@ -160,4 +221,5 @@ void run_nnue_inference_v2_tests() {
     test_reject_malformed_section_size();
     test_accumulator_reject_unvalidated_network();
     test_white_pov_accumulator_side_to_move_invariant();
+    test_memory_mapped_network_matches_file_load();
 }
@@ -57,6 +57,64 @@ void test_promotion_and_castling_perft() {
     assert(perft(board, 3) == 2391);
 }
 
+bool same_move(const sirio::Move &lhs, const sirio::Move &rhs) {
+    return lhs.from == rhs.from && lhs.to == rhs.to && lhs.piece == rhs.piece &&
+           lhs.promotion == rhs.promotion && lhs.captured == rhs.captured &&
+           lhs.is_en_passant == rhs.is_en_passant && lhs.is_castling == rhs.is_castling;
+}
+
+void check_generation_types(const sirio::Board &board, int depth) {
+    const auto all = sirio::generate_pseudo_legal_moves(board);
+    std::vector<sirio::Move> captures;
+    std::vector<sirio::Move> quiets;
+    sirio::generate_moves<sirio::GenType::Captures>(board, captures);
+    sirio::generate_moves<sirio::GenType::Quiets>(board, quiets);
+    assert(captures.size() + quiets.size() == all.size());
+    for (const auto &move : captures) {
+        assert(move.captured.has_value() || move.promotion.has_value());
+    }
+    for (const auto &move : quiets) {
+        assert(!move.captured.has_value() && !move.promotion.has_value());
+    }
+
+    // Legal moves come from the evasion generator in check; they must match the full list.
+    std::vector<sirio::Move> expected_legal;
+    std::vector<sirio::Move> expected_checks;
+    for (const auto &move : all) {
+        if (!board.is_legal(move)) {
+            continue;
+        }
+        expected_legal.push_back(move);
+        if (!move.captured && !move.promotion && !move.is_castling && board.gives_check(move)) {
+            expected_checks.push_back(move);
+        }
+    }
+    const auto legal = sirio::generate_legal_moves(board);
+    assert(legal.size() == expected_legal.size());
+    for (std::size_t index = 0; index < legal.size(); ++index) {
+        assert(same_move(legal[index], expected_legal[index]));
+    }
+    const auto quiet_checks = sirio::generate_pseudo_legal_quiet_checks(board);
+    assert(quiet_checks.size() == expected_checks.size());
+    for (std::size_t index = 0; index < quiet_checks.size(); ++index) {
+        assert(same_move(quiet_checks[index], expected_checks[index]));
+    }
+
+    if (depth > 1) {
+        for (const auto &move : legal) {
+            check_generation_types(board.apply_move(move), depth - 1);
+        }
+    }
+}
+
+void test_generation_types_match_full_generation() {
+    for (const char *fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"}) {
+        check_generation_types(sirio::Board{fen}, 3);
+    }
+}
+
 }  // namespace
 
 void run_perft_tests() {
@@ -64,5 +122,6 @@ void run_perft_tests() {
     test_kiwipete_position();
     test_en_passant_perft();
     test_promotion_and_castling_perft();
+    test_generation_types_match_full_generation();
 }
 
@@ -0,0 +1,196 @@
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sirio/board.hpp"
+#include "sirio/move.hpp"
+#include "sirio/movegen.hpp"
+#include "sirio/pgn.hpp"
+
+namespace {
+
+bool same_move(const sirio::Move &lhs, const sirio::Move &rhs) {
+    return lhs.from == rhs.from && lhs.to == rhs.to && lhs.piece == rhs.piece &&
+           lhs.captured == rhs.captured && lhs.promotion == rhs.promotion &&
+           lhs.is_en_passant == rhs.is_en_passant && lhs.is_castling == rhs.is_castling;
+}
+
+// Fully disambiguated SAN ("Ng1f3", "e5xd6", "e7e8=Q"), which must resolve to the same move.
+std::string long_san(const sirio::Move &move) {
+    if (move.is_castling) {
+        return move.to > move.from ? "O-O" : "O-O-O";
+    }
+    std::string text;
+    constexpr std::string_view letters = "PNBRQK";
+    if (move.piece != sirio::PieceType::Pawn) {
+        text += letters[static_cast<std::size_t>(move.piece)];
+    }
+    const std::string uci = sirio::move_to_uci(move);
+    text += uci.substr(0, 2);
+    if (move.captured) {
+        text += 'x';
+    }
+    text += uci.substr(2, 2);
+    if (move.promotion) {
+        text += '=';
+        text += letters[static_cast<std::size_t>(*move.promotion)];
+    }
+    return text;
+}
+
+void test_san_resolves_every_legal_move() {
+    const char *fens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"};
+    for (const char *fen : fens) {
+        sirio::Board board{fen};
+        for (const sirio::Move &move : sirio::generate_legal_moves(board)) {
+            const auto resolved = sirio::move_from_san(board, long_san(move));
+            assert(resolved && same_move(*resolved, move));
+        }
+    }
+}
+
+void test_san_disambiguation_and_annotations() {
+    sirio::Board board{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"};
+    auto move = sirio::move_from_san(board, "O-O-O+!?");
+    assert(move && move->is_castling && move->to == 2);
+    move = sirio::move_from_san(board, "Nxf7");
+    assert(move && move->from == 36 && move->captured == sirio::PieceType::Pawn);
+    move = sirio::move_from_san(board, "dxe6");
+    assert(move && move->from == 35 && move->to == 44);
+    // The h1 rook is blocked by the king.
+    move = sirio::move_from_san(board, "Rd1");
+    assert(move && move->from == 0);
+    assert(!sirio::move_from_san(board, "Qe2"));
+    assert(!sirio::move_from_san(board, "Bd3x"));
+    assert(!sirio::move_from_san(board, "e4"));
+
+    // Both knights reach d2; only the file tells them apart.
+    sirio::Board knights{"4k3/8/8/8/8/8/8/1N2KN2 w - - 0 1"};
+    assert(!sirio::move_from_san(knights, "Nd2"));
+    move = sirio::move_from_san(knights, "Nbd2");
+    assert(move && move->from == 1);
+    move = sirio::move_from_san(knights, "Nfd2");
+    assert(move && move->from == 5);
+
+    // A pinned knight does not count towards ambiguity.
+    sirio::Board pinned{"4k3/4r3/8/8/8/8/4N3/1N2K3 w - - 0 1"};
+    move = sirio::move_from_san(pinned, "Nc3");
+    assert(move && move->from == 1);
+    assert(!sirio::move_from_san(pinned, "Nd4"));
+
+    sirio::Board promotion{"3r3k/4P3/8/8/8/8/8/4K3 w - - 0 1"};
+    move = sirio::move_from_san(promotion, "exd8=N#");
+    assert(move && move->promotion == sirio::PieceType::Knight);
+    assert(move->captured == sirio::PieceType::Rook);
+    move = sirio::move_from_san(promotion, "e8Q");
+    assert(move && move->promotion == sirio::PieceType::Queen);
+    assert(!sirio::move_from_san(promotion, "e8"));
+}
+
+constexpr std::string_view kSamplePgn =
+    "\xEF\xBB\xBF[Event \"Sample\"]\n"
+    "[White \"A\"]\n"
+    "[Result \"1-0\"]\n"
+    "\n"
+    "1. e4 {king's pawn} e5 2. Nf3 (2. f4 exf4 3. Nf3) Nc6 $1 3. Bb5 a6 ; Morphy\n"
+    "4.Ba4 Nf6 5. O-O 1-0\n"
+    "\n"
+    "[Event \"Setup\"]\n"
+    "[FEN \"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1\"]\n"
+    "[Result \"*\"]\n"
+    "\n"
+    "1. e4 Kd7 2. e5 Ke6 *\n"
+    "\n"
+    "[Event \"Broken\"]\n"
+    "[Result \"0-1\"]\n"
+    "\n"
+    "1. e4 e5 2. Ke3 Nc6 0-1\n";
+
+void test_read_games_parses_tags_movetext_and_errors() {
+    std::mutex mutex;
+    std::vector<sirio::pgn::Game> games;
+    std::size_t positions = 0;
+    sirio::pgn::Visitor visitor;
+    visitor.on_position = [&](const sirio::pgn::Game &game, const sirio::Board &board,
+                              const sirio::Move &move, unsigned) {
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(board.is_legal(move));
+        assert(board.fullmove_number() == static_cast<int>(game.moves.size() / 2) + 1 ||
+               !game.tag("FEN").empty());
+        ++positions;
+    };
+    visitor.on_game = [&](const sirio::pgn::Game &game, unsigned) {
+        std::lock_guard<std::mutex> lock(mutex);
+        games.push_back(game);
+    };
+    const auto stats = sirio::pgn::read_games(kSamplePgn, visitor, 2);
+    assert(stats.games == 3);
+    assert(stats.errors == 1);
+    assert(stats.moves == 9 + 4 + 2);
+    assert(positions == stats.moves);
+    assert(games.size() == 3);
+
+    for (const auto &game : games) {
+        const std::string_view event = game.tag("Event");
+        if (event == "Sample") {
+            assert(game.tag("White") == "A");
+            assert(game.result == sirio::pgn::GameResult::WhiteWins);
+            assert(game.error.empty() && game.moves.size() == 9);
+            assert(game.moves.back().is_castling);
+            assert(kSamplePgn.substr(game.offset, 7) == "[Event ");
+        } else if (event == "Setup") {
+            assert(game.result == sirio::pgn::GameResult::Unknown);
+            assert(game.moves.size() == 4);
+        } else {
+            assert(event == "Broken");
+            assert(game.error == "Ke3");
+            assert(game.moves.size() == 2);
+            assert(game.result == sirio::pgn::GameResult::BlackWins);
+        }
+    }
+}
+
+void test_pgn_file_maps_and_splits_into_chunks() {
+    const auto path = std::filesystem::temp_directory_path() / "sirio_pgn_tests.pgn";
+    {
+        std::ofstream out(path, std::ios::binary);
+        // Enough games to cross the chunk size, so several workers share the file.
+        for (int index = 0; index < 30000; ++index) {
+            out << "[Event \"Game " << index << "\"]\n[Result \"1/2-1/2\"]\n\n"
+                << "1. d4 d5 2. c4 e6 3. Nc3 Nf6 4. Bg5 Be7 1/2-1/2\n\n";
+        }
+    }
+    sirio::pgn::PgnFile file;
+    std::string error;
+    const bool opened = file.open(path.string(), &error);
+    assert(opened);
+    const auto stats = sirio::pgn::read_games(file.text(), {}, 3);
+    assert(stats.games == 30000);
+    assert(stats.moves == 30000 * 8);
+    assert(stats.errors == 0);
+    assert(stats.threads == 3);
+    file.close();
+    std::filesystem::remove(path);
+
+    const bool missing_opened =
+        file.open((std::filesystem::temp_directory_path() / "sirio_missing.pgn").string(), &error);
+    assert(!missing_opened && !error.empty());
+}
+
+}  // namespace
+
+void run_pgn_tests() {
+    test_san_resolves_every_legal_move();
+    test_san_disambiguation_and_annotations();
+    test_read_games_parses_tags_movetext_and_errors();
+    test_pgn_file_maps_and_splits_into_chunks();
+}
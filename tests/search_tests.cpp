@@ -1,16 +1,31 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "sirio/board.hpp"
+#include "sirio/engine.hpp"
+#include "sirio/evaluation.hpp"
+#include "sirio/main_search_thread.hpp"
 #include "sirio/move.hpp"
 #include "sirio/movegen.hpp"
 #include "sirio/search.hpp"
+#include "sirio/search_params.hpp"
 
 namespace sirio {
 bool creates_delayed_capture_threat_for_tests(const Board &, const Move &, Color);
 bool is_central_pawn_sacrifice_for_tests(const Board &, const Move &, Color);
 bool responds_to_direct_threat_for_tests(const Board &, const Move &, Color, bool);
 int static_exchange_eval_for_tests(const Board &, const Move &);
+std::array<bool, 4> searching_table_probe_for_tests(std::uint64_t, std::uint64_t, std::uint64_t,
+                                                    std::uint64_t);
 }  // namespace sirio
 
 namespace {
@@ -54,6 +69,32 @@ void test_static_exchange_losing_capture() {
     assert(see_score < 0);
 }
 
+void test_mate_search_reports_shortest_distance() {
+    // Ra6! bxa6 b7# is a mate in two; deeper iterations must keep the exact distance.
+    sirio::Board board{"kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1"};
+    sirio::SearchLimits limits;
+    limits.max_depth = 6;
+    sirio::set_search_threads(1);
+    auto result = sirio::search_best_move(board, limits);
+    assert(result.has_move);
+    assert(sirio::move_to_uci(result.best_move) == "a1a6");
+    assert(result.score == sirio::search_params::mate_in(3));
+    assert(result.instrumentation.mate_distance_prunes > 0);
+}
+
+void test_quiescence_detects_mate_after_checking_capture() {
+    // Rxd8# lands at the horizon of a one-ply search: quiescence must search the evasions and
+    // report the mate instead of standing pat in check.
+    sirio::Board board{"3r2k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1"};
+    sirio::SearchLimits limits;
+    limits.max_depth = 1;
+    sirio::set_search_threads(1);
+    auto result = sirio::search_best_move(board, limits);
+    assert(result.has_move);
+    assert(sirio::move_to_uci(result.best_move) == "d1d8");
+    assert(result.score == sirio::search_params::mate_in(1));
+}
+
 void test_autoplayer_short_match() {
     sirio::Board board;
     sirio::SearchLimits limits;
@@ -70,6 +111,284 @@ void test_autoplayer_short_match() {
     }
 }
 
+class ConstantEvaluation final : public sirio::EvaluationBackend {
+public:
+    explicit ConstantEvaluation(int score = 0) : score_(score) {}
+    void initialize(const sirio::Board &) override {}
+    void reset(const sirio::Board &) override {}
+    void push(const sirio::Board &, const std::optional<sirio::Move> &, sirio::Color) override {}
+    void pop() override {}
+    int evaluate(const sirio::Board &) override { return score_; }
+    std::unique_ptr<sirio::EvaluationBackend> clone() const override {
+        return std::make_unique<ConstantEvaluation>(score_);
+    }
+
+private:
+    int score_;
+};
+
+int evaluate_with(sirio::EvaluationPrototype &prototype, const sirio::Board &board) {
+    sirio::ScopedEvaluationPrototype scope{prototype};
+    sirio::initialize_evaluation(board);
+    return sirio::evaluate(board);
+}
+
+void test_prototype_at_a_reused_address_gets_a_fresh_clone() {
+    const sirio::Board start;
+    std::optional<sirio::EvaluationPrototype> prototype;
+    prototype.emplace();
+    prototype->set_backend(std::make_unique<ConstantEvaluation>(111));
+    assert(evaluate_with(*prototype, start) == 111);
+
+    // The replacement lives at the same address, so only its generation tells it apart.
+    const sirio::EvaluationPrototype *address = &*prototype;
+    prototype.reset();
+    prototype.emplace();
+    assert(&*prototype == address);
+    prototype->set_backend(std::make_unique<ConstantEvaluation>(222));
+    assert(evaluate_with(*prototype, start) == 222);
+}
+
+void test_engines_search_concurrently_with_isolated_state() {
+    sirio::Engine flat{1, 1};
+    flat.evaluation().set_backend(std::make_unique<ConstantEvaluation>());
+    sirio::Engine classical{1, 1};
+    sirio::Engine background{1, 1};
+
+    const sirio::Board start;
+    const sirio::Board queen_up{"4k3/8/8/8/8/8/8/3QK3 w - - 0 1"};
+    sirio::SearchLimits fixed;
+    fixed.max_depth = 3;
+    sirio::SearchLimits infinite;
+    infinite.infinite = true;
+
+    sirio::SearchResult background_result;
+    std::thread background_thread([&]() { background_result = background.search(start, infinite); });
+
+    sirio::SearchResult flat_result;
+    sirio::SearchResult classical_result;
+    std::thread flat_thread([&]() { flat_result = flat.search(start, fixed); });
+    std::thread classical_thread([&]() { classical_result = classical.search(queen_up, fixed); });
+    flat_thread.join();
+    classical_thread.join();
+
+    // Each engine evaluates with its own prototype and is not stopped by its neighbours.
+    assert(flat_result.has_move && flat_result.depth_reached == 3);
+    assert(flat_result.score == 0);
+    assert(classical_result.has_move && classical_result.depth_reached == 3);
+    assert(classical_result.score > 500);
+    assert(flat.transposition_table().probe(start.zobrist_hash()).has_value());
+    assert(!classical.transposition_table().probe(start.zobrist_hash()).has_value());
+
+    background.request_stop();
+    background_thread.join();
+    assert(background_result.has_move);
+}
+
+void test_main_search_thread_is_reused_across_searches() {
+    sirio::Engine engine{1, 1};
+    engine.set_uci_output(false);
+    sirio::MainSearchThread driver{engine};
+
+    std::vector<std::thread::id> search_threads;
+    std::vector<sirio::SearchResult> results;
+    auto record = [&](const sirio::Board &, const sirio::SearchLimits &,
+                      const sirio::SearchResult &result) {
+        search_threads.push_back(std::this_thread::get_id());
+        results.push_back(result);
+    };
+
+    const sirio::Board start;
+    sirio::SearchLimits fixed;
+    fixed.max_depth = 2;
+    driver.start(start, fixed, record);
+    // A new search waits for the previous one instead of racing it.
+    driver.start(sirio::Board{"4k3/8/8/8/8/8/8/3QK3 w - - 0 1"}, fixed, record);
+    driver.wait();
+    assert(!driver.searching());
+    assert(results.size() == 2);
+    assert(results[0].depth_reached == 2 && results[1].score > 500);
+    assert(search_threads[0] == search_threads[1]);
+    assert(search_threads[0] != std::this_thread::get_id());
+    assert(driver.last_latency().stop_to_result_us == 0);
+
+    sirio::SearchLimits infinite;
+    infinite.infinite = true;
+    driver.start(start, infinite, record);
+    assert(driver.searching());
+    driver.request_stop();
+    driver.wait();
+    assert(results.size() == 3 && results[2].has_move);
+    assert(search_threads[2] == search_threads[0]);
+}
+
+void test_thread_pool_tracks_configured_helpers() {
+    const int baseline = sirio::search_thread_pool_size();
+    {
+        sirio::Engine single{1, 1};
+        assert(sirio::search_thread_pool_size() == baseline);
+
+        sirio::Engine wide{1, 3};
+        assert(sirio::search_thread_pool_size() == baseline + 2);
+        sirio::SearchLimits fixed;
+        fixed.max_depth = 3;
+        assert(wide.search(sirio::Board{}, fixed).has_move);
+
+        wide.set_threads(2);
+        assert(sirio::search_thread_pool_size() == baseline + 1);
+    }
+    assert(sirio::search_thread_pool_size() == baseline);
+}
+
+void test_helper_threads_share_work_without_losing_the_mate() {
+    sirio::Board board{"kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1"};
+    sirio::SearchLimits limits;
+    limits.max_depth = 7;
+
+    sirio::Engine single{4, 1};
+    single.set_uci_output(false);
+    const auto alone = single.search(board, limits);
+    assert(alone.instrumentation.smp_deferrals == 0);
+
+    // Deferred moves are still searched at the end of the move loop, so helpers that skip
+    // each other's subtrees must agree on the forced line.
+    sirio::Engine shared{4, 4};
+    shared.set_uci_output(false);
+    const auto together = shared.search(board, limits);
+    assert(together.has_move);
+    assert(sirio::move_to_uci(together.best_move) == "a1a6");
+    assert(together.score == sirio::search_params::mate_in(3));
+}
+
+void test_searching_table_defers_only_to_other_threads() {
+    const std::uint64_t key = 0x9E3779B97F4A7C00ULL;
+
+    // Thread 2 defers a node thread 1 is searching; thread 1 never defers to itself, and the
+    // node is free again once thread 1 leaves it.
+    auto seen = sirio::searching_table_probe_for_tests(key, 1, key, 2);
+    assert(seen[0]);
+    assert(!seen[1]);
+    assert(seen[2]);
+    assert(!seen[3]);
+
+    // A different node in the same slot is not deferred, and thread 2 failing to claim that slot
+    // does not release thread 1's entry.
+    const std::uint64_t neighbour = key + (std::uint64_t{1} << 40);
+    seen = sirio::searching_table_probe_for_tests(key, 1, neighbour, 2);
+    assert(!seen[0]);
+    assert(!seen[2]);
+}
+
+void test_diversity_profiles_keep_helpers_on_the_mate() {
+    sirio::Board board{"kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1"};
+    sirio::SearchLimits limits;
+    limits.max_depth = 7;
+
+    // Helpers with perturbed reductions, rotated root quiets and skipped iterations must not
+    // pull a different move into the shared result.
+    sirio::Engine engine{4, 8};
+    engine.set_uci_output(false);
+    assert(engine.smp_diversity());
+    for (bool diversity : {true, false}) {
+        engine.set_smp_diversity(diversity);
+        engine.clear_hash();
+        const auto result = engine.search(board, limits);
+        assert(result.has_move);
+        assert(sirio::move_to_uci(result.best_move) == "a1a6");
+        assert(result.score == sirio::search_params::mate_in(3));
+    }
+}
+
+void test_root_moves_drive_multipv_and_searchmoves() {
+    sirio::Engine engine{4, 1};
+    engine.set_uci_output(false);
+
+    sirio::Board start{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+    sirio::SearchLimits multipv;
+    multipv.max_depth = 5;
+    multipv.multi_pv = 3;
+    const auto lines = engine.search(start, multipv);
+    assert(lines.lines.size() == 3);
+    assert(sirio::move_to_uci(lines.lines[0].move) == sirio::move_to_uci(lines.best_move));
+    for (std::size_t index = 0; index < lines.lines.size(); ++index) {
+        const auto &line = lines.lines[index];
+        assert(!line.principal_variation.empty());
+        assert(sirio::move_to_uci(line.principal_variation.front()) ==
+               sirio::move_to_uci(line.move));
+        if (index > 0) {
+            assert(line.score <= lines.lines[index - 1].score);
+            assert(sirio::move_to_uci(line.move) != sirio::move_to_uci(lines.lines[index - 1].move));
+        }
+    }
+
+    // Restricting the root keeps the search off the mating move, and the partial root search
+    // leaves no TT entry that would hide the mate from the next, unrestricted one.
+    sirio::Board board{"kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1"};
+    sirio::SearchLimits restricted;
+    restricted.max_depth = 7;
+    restricted.search_moves = {sirio::move_from_uci(board, "a1a2"), sirio::move_from_uci(board, "a1b1")};
+    const auto limited = engine.search(board, restricted);
+    assert(limited.has_move);
+    const auto limited_move = sirio::move_to_uci(limited.best_move);
+    assert(limited_move == "a1a2" || limited_move == "a1b1");
+
+    sirio::SearchLimits open;
+    open.max_depth = 7;
+    const auto full = engine.search(board, open);
+    assert(sirio::move_to_uci(full.best_move) == "a1a6");
+    assert(full.score == sirio::search_params::mate_in(3));
+}
+
+void test_multipv_scores_every_root_move() {
+    sirio::Engine engine{4, 1};
+    engine.set_uci_output(false);
+
+    // Nxe5 and Bxf7+ lose material by SEE; with every move requested they still get real lines.
+    sirio::Board board{"r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4"};
+    const std::size_t legal = sirio::generate_legal_moves(board).size();
+    for (int depth = 1; depth <= 5; ++depth) {
+        sirio::SearchLimits limits;
+        limits.max_depth = depth;
+        limits.multi_pv = static_cast<int>(legal);
+        engine.clear_hash();
+        const auto result = engine.search(board, limits);
+        assert(result.lines.size() == legal);
+        for (const auto &line : result.lines) {
+            assert(line.score != std::numeric_limits<int>::min());
+            assert(std::abs(line.score) < sirio::search_params::mate_score);
+        }
+    }
+}
+
+void test_multipv_lines_keep_their_own_principal_variation() {
+    sirio::Engine engine{16, 1};
+    engine.set_uci_output(false);
+
+    const sirio::Board board{"r1bq1rk1/pp2ppbp/2np1np1/8/3NP3/2N1BP2/PPPQ2PP/R3KB1R w KQ - 0 9"};
+    sirio::SearchLimits limits;
+    limits.max_depth = 7;
+    limits.multi_pv = 4;
+    const auto result = engine.search(board, limits);
+    assert(result.lines.size() == 4);
+    for (const auto &line : result.lines) {
+        // Each line is the move's own search: it starts with the move, plays out legally and
+        // reports how deep that search went.
+        assert(line.principal_variation.size() >= 2);
+        assert(line.principal_variation.front().from == line.move.from);
+        assert(line.principal_variation.front().to == line.move.to);
+        assert(line.seldepth > 0);
+        sirio::Board position = board;
+        for (const auto &move : line.principal_variation) {
+            const auto legal = sirio::generate_legal_moves(position);
+            assert(std::any_of(legal.begin(), legal.end(), [&](const sirio::Move &candidate) {
+                return candidate.from == move.from && candidate.to == move.to &&
+                       candidate.promotion == move.promotion;
+            }));
+            position = position.apply_move(move);
+        }
+    }
+}
+
 }  // namespace
 
 void run_search_tests() {
@@ -78,5 +397,17 @@ void run_search_tests() {
     test_direct_threat_response_detection();
     test_static_exchange_positive_capture();
     test_static_exchange_losing_capture();
+    test_mate_search_reports_shortest_distance();
+    test_quiescence_detects_mate_after_checking_capture();
     test_autoplayer_short_match();
+    test_engines_search_concurrently_with_isolated_state();
+    test_prototype_at_a_reused_address_gets_a_fresh_clone();
+    test_main_search_thread_is_reused_across_searches();
+    test_thread_pool_tracks_configured_helpers();
+    test_helper_threads_share_work_without_losing_the_mate();
+    test_searching_table_defers_only_to_other_threads();
+    test_diversity_profiles_keep_helpers_on_the_mate();
+    test_root_moves_drive_multipv_and_searchmoves();
+    test_multipv_scores_every_root_move();
+    test_multipv_lines_keep_their_own_principal_variation();
 }
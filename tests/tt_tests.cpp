@@ -1,9 +1,19 @@
 #include <cassert>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
 #include <vector>
 
+#include "sirio/analysis_store.hpp"
 #include "sirio/transposition_table.hpp"
 
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
 namespace {
 
 std::uint64_t mul_high_u64(std::uint64_t lhs, std::uint64_t rhs) {
@@ -231,6 +241,8 @@ void test_collision_prefers_older_generations_for_eviction() {
     }
 
     std::uint8_t new_generation = table.prepare_for_search();
+    assert(table.trusts_generation(new_generation, new_generation));
+    assert(!table.trusts_generation(initial_generation, new_generation));
 
     for (std::size_t i = 0; i < sirio::GlobalTranspositionTable::cluster_capacity(); ++i) {
         sirio::TTEntry entry;
@@ -287,6 +299,193 @@ void test_disabling_transposition_table() {
     sirio::clear_transposition_tables();
 }
 
+#if defined(__unix__) || defined(__APPLE__)
+void test_shared_memory_table_is_visible_across_mappings() {
+    const std::size_t previous_size = sirio::get_transposition_table_size();
+    const std::string name = "/sirio_tt_test_" + std::to_string(::getpid());
+    sirio::set_transposition_table_size(1);
+    sirio::set_transposition_table_shared_name(name);
+
+    {
+        // Two tables map the segment independently, exactly like two engine processes would.
+        sirio::GlobalTranspositionTable first;
+        sirio::GlobalTranspositionTable second;
+        const std::uint8_t generation = first.prepare_for_search();
+        const std::uint8_t sibling_generation = second.prepare_for_search();
+        // The generation advances in the segment, and siblings a search apart trust each other.
+        assert(sibling_generation != generation);
+        assert(second.trusts_generation(generation, sibling_generation));
+        assert(first.trusts_generation(sibling_generation, generation));
+        assert(first.attached_to_shared_memory());
+        assert(second.attached_to_shared_memory());
+        assert(first.bucket_count_for_tests() == second.bucket_count_for_tests());
+
+        sirio::TTEntry entry;
+        entry.best_move.from = 6;
+        entry.best_move.to = 21;
+        entry.best_move.piece = sirio::PieceType::Knight;
+        entry.depth = 9;
+        entry.score = 33;
+        entry.type = sirio::TTNodeType::Exact;
+        first.store(0x1234'5678'9ABC'DEF0ULL, entry, generation);
+        const auto seen = second.probe(0x1234'5678'9ABC'DEF0ULL);
+        assert(seen.has_value());
+        assert(seen->depth == 9 && seen->score == 33 && seen->best_move.to == 21);
+
+        // Clear Hash empties the segment for every process that maps it, and both keep sharing it.
+        sirio::clear_transposition_tables();
+        const std::uint8_t cleared_generation = first.prepare_for_search();
+        assert(first.attached_to_shared_memory());
+        assert(!second.probe(0x1234'5678'9ABC'DEF0ULL).has_value());
+        second.prepare_for_search();
+        first.store(0x1234'5678'9ABC'DEF0ULL, entry, cleared_generation);
+        assert(second.probe(0x1234'5678'9ABC'DEF0ULL).has_value());
+
+        // Entries age: a search several generations later no longer trusts them.
+        std::uint8_t later_generation = cleared_generation;
+        for (int search = 0; search < 8; ++search) {
+            later_generation = second.prepare_for_search();
+        }
+        assert(!second.trusts_generation(cleared_generation, later_generation));
+    }
+    // The last table to detach removes the segment name.
+    assert(::shm_open(name.c_str(), O_RDONLY, 0600) < 0);
+
+    // A segment with a foreign layout is rejected and the table falls back to private memory.
+    const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    assert(fd >= 0);
+    assert(::ftruncate(fd, 8192) == 0);
+    struct {
+        char magic[8] = {'S', 'I', 'R', 'I', 'O', 'T', 'T', '\0'};
+        std::uint32_t version = 99;
+        std::uint32_t cluster_bytes = 0;
+        std::uint32_t entries_per_cluster = 0;
+        std::uint32_t entry_bytes = 0;
+        std::uint64_t bucket_count = 1;
+        std::uint32_t ready = 1;
+        std::uint32_t attached = 1;
+        std::uint32_t generation = 1;
+    } foreign;
+    assert(::pwrite(fd, &foreign, sizeof(foreign), 0) == static_cast<ssize_t>(sizeof(foreign)));
+    ::close(fd);
+    {
+        sirio::GlobalTranspositionTable table;
+        table.prepare_for_search();
+        assert(!table.attached_to_shared_memory());
+        assert(!table.shared_memory_error().empty());
+        assert(table.bucket_count_for_tests() > 0);
+    }
+    ::shm_unlink(name.c_str());
+
+    sirio::set_transposition_table_shared_name("");
+    sirio::set_transposition_table_size(previous_size);
+    sirio::clear_transposition_tables();
+}
+#endif
+
+sirio::TTEntry analysis_entry(int depth, int score, sirio::TTNodeType type) {
+    sirio::TTEntry entry;
+    entry.best_move.from = 12;
+    entry.best_move.to = 28;
+    entry.best_move.piece = sirio::PieceType::Pawn;
+    entry.depth = depth;
+    entry.score = score;
+    entry.type = type;
+    entry.static_eval = 17;
+    return entry;
+}
+
+std::filesystem::path analysis_store_path(const std::string &name) {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    return path;
+}
+
+void test_analysis_store_keeps_only_deep_exact_entries() {
+    const auto path = analysis_store_path("sirio_analysis_store_admission.bin");
+    sirio::AnalysisStore store;
+    store.set_min_depth(10);
+    store.record(1ULL, analysis_entry(6, 30, sirio::TTNodeType::Exact));
+    store.record(2ULL, analysis_entry(14, 40, sirio::TTNodeType::LowerBound));
+    store.record(0xDEADBEEFCAFEF00DULL, analysis_entry(14, -55, sirio::TTNodeType::Exact));
+    assert(store.stats().pending_records == 1);
+    assert(store.append_pending(path.string()));
+    assert(store.stats().pending_records == 0);
+    assert(std::filesystem::file_size(path) == 24 + sizeof(sirio::AnalysisRecord));
+
+    sirio::AnalysisStore reloaded;
+    assert(reloaded.open(path.string()));
+    assert(reloaded.stats().sorted_records == 1);
+    assert(!reloaded.probe(1ULL).has_value());
+    assert(!reloaded.probe(2ULL).has_value());
+    // The full key is stored, so a key sharing the low bits does not alias.
+    assert(!reloaded.probe(0xDEADBEEFCAFEF00DULL ^ (1ULL << 40)).has_value());
+    const auto hit = reloaded.probe(0xDEADBEEFCAFEF00DULL);
+    assert(hit.has_value());
+    assert(hit->depth == 14);
+    assert(hit->score == -55);
+    assert(hit->type == sirio::TTNodeType::Exact);
+    assert(hit->best_move.from == 12 && hit->best_move.to == 28);
+    assert(reloaded.stats().hits == 1);
+
+    std::filesystem::remove(path);
+}
+
+void test_analysis_store_appends_compacts_and_merges() {
+    const auto first = analysis_store_path("sirio_analysis_store_a.bin");
+    const auto second = analysis_store_path("sirio_analysis_store_b.bin");
+    const auto merged = analysis_store_path("sirio_analysis_store_merged.bin");
+
+    sirio::AnalysisStore store;
+    store.set_min_depth(10);
+    store.record(100ULL, analysis_entry(12, 10, sirio::TTNodeType::Exact));
+    assert(store.append_pending(first.string()));
+    store.record(100ULL, analysis_entry(16, 20, sirio::TTNodeType::Exact));
+    store.record(200ULL, analysis_entry(11, 30, sirio::TTNodeType::Exact));
+    assert(store.append_pending(first.string()));
+    auto stats = store.stats();
+    assert(stats.sorted_records == 1);
+    assert(stats.appended_records == 2);
+    assert(store.probe(100ULL)->depth == 16);
+
+    assert(store.compact(first.string()));
+    stats = store.stats();
+    assert(stats.sorted_records == 2);
+    assert(stats.appended_records == 0);
+    assert(store.probe(100ULL)->score == 20);
+    assert(store.probe(200ULL)->score == 30);
+
+    sirio::AnalysisStore other;
+    other.set_min_depth(10);
+    other.record(100ULL, analysis_entry(20, 25, sirio::TTNodeType::Exact));
+    other.record(300ULL, analysis_entry(10, 35, sirio::TTNodeType::Exact));
+    assert(other.append_pending(second.string()));
+
+    assert(sirio::merge_analysis_store_files({first.string(), second.string()}, merged.string()));
+    assert(std::filesystem::file_size(merged) == 24 + 3 * sizeof(sirio::AnalysisRecord));
+    sirio::AnalysisStore combined;
+    assert(combined.open(merged.string()));
+    assert(combined.stats().sorted_records == 3);
+    assert(combined.probe(100ULL)->depth == 20);
+    assert(combined.probe(200ULL)->score == 30);
+    assert(combined.probe(300ULL)->score == 35);
+
+    const auto invalid = analysis_store_path("sirio_analysis_store_invalid.bin");
+    {
+        std::ofstream out(invalid, std::ios::binary);
+        out << "SRTT not an analysis store";
+    }
+    std::string error;
+    assert(!combined.open(invalid.string(), &error));
+    assert(!error.empty());
+    assert(!combined.probe(100ULL).has_value());
+    std::filesystem::remove(invalid);
+
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+    std::filesystem::remove(merged);
+}
+
 }  // namespace
 
 void run_tt_tests() {
@@ -295,5 +494,10 @@ void run_tt_tests() {
     test_collision_replaces_shallow_entries();
     test_collision_prefers_older_generations_for_eviction();
     test_disabling_transposition_table();
+#if defined(__unix__) || defined(__APPLE__)
+    test_shared_memory_table_is_visible_across_mappings();
+#endif
+    test_analysis_store_keeps_only_deep_exact_entries();
+    test_analysis_store_appends_compacts_and_merges();
 }
 
@@ -0,0 +1,503 @@
+// Texel tuner for the classical evaluation. Every position of the dataset is traced once into the
+// sparse coefficients of sirio/evaluation_trace.hpp; each epoch then only runs dot products over
+// those coefficients, split across threads, and Adam updates the weights. The result replaces
+// include/sirio/evaluation_weights.hpp.
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "sirio/board.hpp"
+#include "sirio/evaluation.hpp"
+#include "sirio/evaluation_trace.hpp"
+#include "sirio/pgn.hpp"
+
+namespace {
+
+struct Options {
+    std::string dataset;
+    std::string output = "include/sirio/evaluation_weights.hpp";
+    int epochs = 300;
+    unsigned threads = 0;
+    double learning_rate = 1.0;
+    double k = 0.0;
+    std::size_t limit = 0;
+    // PGN input: plies skipped at the start of every game.
+    int skip_plies = 16;
+};
+
+// Positions in structure-of-arrays form; the terms of position i are
+// terms[offsets[i]] .. terms[offsets[i + 1]].
+struct Dataset {
+    std::vector<std::uint32_t> offsets{0};
+    std::vector<sirio::ClassicalTraceTerm> terms;
+    // scale * phase / 24 and scale * (24 - phase) / 24.
+    std::vector<float> mg_factor;
+    std::vector<float> eg_factor;
+    // Evaluation minus its linear part under the compiled-in weights: the terms not tuned.
+    std::vector<float> fixed;
+    // Game result from white's point of view.
+    std::vector<float> result;
+
+    [[nodiscard]] std::size_t size() const { return result.size(); }
+
+    void add(const sirio::ClassicalEvaluationTrace &trace, double linear, float game_result) {
+        terms.insert(terms.end(), trace.terms.begin(), trace.terms.end());
+        offsets.push_back(static_cast<std::uint32_t>(terms.size()));
+        mg_factor.push_back(trace.scale * static_cast<float>(trace.phase) / 24.0F);
+        eg_factor.push_back(trace.scale * static_cast<float>(24 - trace.phase) / 24.0F);
+        fixed.push_back(static_cast<float>(trace.evaluation - linear));
+        result.push_back(game_result);
+    }
+
+    void append(const Dataset &other) {
+        const auto base = static_cast<std::uint32_t>(terms.size());
+        terms.insert(terms.end(), other.terms.begin(), other.terms.end());
+        for (std::size_t index = 1; index < other.offsets.size(); ++index) {
+            offsets.push_back(base + other.offsets[index]);
+        }
+        mg_factor.insert(mg_factor.end(), other.mg_factor.begin(), other.mg_factor.end());
+        eg_factor.insert(eg_factor.end(), other.eg_factor.begin(), other.eg_factor.end());
+        fixed.insert(fixed.end(), other.fixed.begin(), other.fixed.end());
+        result.insert(result.end(), other.result.begin(), other.result.end());
+    }
+};
+
+void print_usage() {
+    std::cerr << "usage: sirio_tune <dataset.epd|dataset.pgn> [--output PATH] [--epochs N]\n"
+                 "                  [--threads N] [--learning-rate X] [--k X] [--limit N]\n"
+                 "                  [--skip-plies N]\n"
+                 "EPD lines carry the result as 1-0, 0-1, 1/2-1/2 or [1.0]/[0.5]/[0.0];\n"
+                 "PGN games are sampled at every quiet move after the skipped opening plies.\n";
+}
+
+bool parse_options(int argc, char **argv, Options &options) {
+    for (int index = 1; index < argc; ++index) {
+        const std::string_view arg = argv[index];
+        auto value = [&]() -> const char * { return index + 1 < argc ? argv[++index] : nullptr; };
+        const char *text = nullptr;
+        if (arg == "--output" && (text = value())) {
+            options.output = text;
+        } else if (arg == "--epochs" && (text = value())) {
+            options.epochs = std::atoi(text);
+        } else if (arg == "--threads" && (text = value())) {
+            options.threads = static_cast<unsigned>(std::atoi(text));
+        } else if (arg == "--learning-rate" && (text = value())) {
+            options.learning_rate = std::atof(text);
+        } else if (arg == "--k" && (text = value())) {
+            options.k = std::atof(text);
+        } else if (arg == "--limit" && (text = value())) {
+            options.limit = static_cast<std::size_t>(std::atoll(text));
+        } else if (arg == "--skip-plies" && (text = value())) {
+            options.skip_plies = std::atoi(text);
+        } else if (!arg.empty() && arg.front() != '-' && options.dataset.empty()) {
+            options.dataset = arg;
+        } else {
+            return false;
+        }
+    }
+    return !options.dataset.empty() && options.epochs >= 0;
+}
+
+// The result recorded after the four EPD fields, or a negative value when there is none.
+float parse_result(std::string_view operations) {
+    if (operations.find("1/2-1/2") != std::string_view::npos) {
+        return 0.5F;
+    }
+    if (operations.find("1-0") != std::string_view::npos) {
+        return 1.0F;
+    }
+    if (operations.find("0-1") != std::string_view::npos) {
+        return 0.0F;
+    }
+    const std::size_t open = operations.find('[');
+    if (open != std::string_view::npos) {
+        float value = -1.0F;
+        const char *first = operations.data() + open + 1;
+        const char *last = operations.data() + operations.size();
+        const auto [end, error] = std::from_chars(first, last, value);
+        if (error == std::errc{} && end != first && end != last && *end == ']' &&
+            value >= 0.0F && value <= 1.0F) {
+            return value;
+        }
+    }
+    return -1.0F;
+}
+
+bool add_position(Dataset &dataset, const sirio::Board &board, float game_result,
+                  const std::vector<sirio::ClassicalWeight> &weights,
+                  sirio::ClassicalEvaluationTrace &trace) {
+    if (!sirio::trace_classical_evaluation(board, trace)) {
+        return false;
+    }
+    dataset.add(trace, sirio::evaluate_classical_trace(trace, weights), game_result);
+    return true;
+}
+
+Dataset load_epd(std::string_view text, unsigned threads,
+                 const std::vector<sirio::ClassicalWeight> &weights, std::size_t &rejected) {
+    std::vector<std::string_view> lines;
+    while (!text.empty()) {
+        const std::size_t end = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, end);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (!line.empty() && line.front() != '#') {
+            lines.push_back(line);
+        }
+        text.remove_prefix(std::min(end + 1, text.size()));
+    }
+
+    std::vector<Dataset> parts(threads);
+    std::vector<std::size_t> part_rejected(threads, 0);
+    std::vector<std::thread> workers;
+    for (unsigned thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([&, thread] {
+            const std::size_t begin = lines.size() * thread / threads;
+            const std::size_t end = lines.size() * (thread + 1) / threads;
+            sirio::Board board;
+            sirio::ClassicalEvaluationTrace trace;
+            for (std::size_t index = begin; index < end; ++index) {
+                std::string_view operations;
+                float game_result = -1.0F;
+                if (board.parse_epd(lines[index], &operations) == sirio::FenError::None) {
+                    game_result = parse_result(operations);
+                }
+                if (game_result < 0.0F ||
+                    !add_position(parts[thread], board, game_result, weights, trace)) {
+                    ++part_rejected[thread];
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    Dataset dataset;
+    for (unsigned thread = 0; thread < threads; ++thread) {
+        dataset.append(parts[thread]);
+        rejected += part_rejected[thread];
+    }
+    return dataset;
+}
+
+// Positions before quiet moves (no capture, promotion or check) of games with a decisive or drawn
+// result, past the opening.
+Dataset load_pgn(std::string_view text, unsigned threads, int skip_plies,
+                 const std::vector<sirio::ClassicalWeight> &weights, std::size_t &rejected) {
+    std::vector<Dataset> parts(threads);
+    std::vector<std::size_t> part_rejected(threads, 0);
+    std::vector<sirio::ClassicalEvaluationTrace> traces(threads);
+    sirio::pgn::Visitor visitor;
+    visitor.on_position = [&](const sirio::pgn::Game &game, const sirio::Board &board,
+                              const sirio::Move &move, unsigned thread) {
+        if (game.result == sirio::pgn::GameResult::Unknown ||
+            static_cast<int>(game.moves.size()) < skip_plies ||
+            board.in_check(board.side_to_move()) || move.captured || move.promotion) {
+            return;
+        }
+        const float game_result = game.result == sirio::pgn::GameResult::WhiteWins   ? 1.0F
+                                  : game.result == sirio::pgn::GameResult::BlackWins ? 0.0F
+                                                                                     : 0.5F;
+        if (!add_position(parts[thread], board, game_result, weights, traces[thread])) {
+            ++part_rejected[thread];
+        }
+    };
+    sirio::pgn::read_games(text, visitor, threads);
+
+    Dataset dataset;
+    for (unsigned thread = 0; thread < threads; ++thread) {
+        dataset.append(parts[thread]);
+        rejected += part_rejected[thread];
+    }
+    return dataset;
+}
+
+// Weights as two flat arrays, middlegame values first, so each epoch reads them contiguously.
+struct Parameters {
+    std::vector<double> mg;
+    std::vector<double> eg;
+};
+
+constexpr double kLn10 = 2.302585092994046;
+
+double sigmoid(double k, double evaluation) {
+    return 1.0 / (1.0 + std::pow(10.0, -k * evaluation / 400.0));
+}
+
+double linear_evaluation(const Dataset &dataset, const Parameters &parameters, std::size_t index) {
+    double mg = 0.0;
+    double eg = 0.0;
+    for (std::uint32_t term = dataset.offsets[index]; term < dataset.offsets[index + 1]; ++term) {
+        const sirio::ClassicalTraceTerm &coefficient = dataset.terms[term];
+        mg += coefficient.mg * parameters.mg[coefficient.index];
+        eg += coefficient.eg * parameters.eg[coefficient.index];
+    }
+    return dataset.fixed[index] + dataset.mg_factor[index] * mg + dataset.eg_factor[index] * eg;
+}
+
+// Mean squared error of the predicted results; with `gradient`, also its gradient with respect to
+// the weights (middlegame half first). The positions are split into one contiguous range per
+// thread, each accumulating into its own gradient.
+double compute_error(const Dataset &dataset, const Parameters &parameters, double k,
+                     unsigned threads, std::vector<double> *gradient) {
+    const std::size_t weight_count = parameters.mg.size();
+    std::vector<double> errors(threads, 0.0);
+    std::vector<std::vector<double>> gradients(gradient ? threads : 0);
+    std::vector<std::thread> workers;
+    for (unsigned thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([&, thread] {
+            const std::size_t begin = dataset.size() * thread / threads;
+            const std::size_t end = dataset.size() * (thread + 1) / threads;
+            std::vector<double> *local = nullptr;
+            if (gradient) {
+                gradients[thread].assign(weight_count * 2, 0.0);
+                local = &gradients[thread];
+            }
+            double error = 0.0;
+            for (std::size_t index = begin; index < end; ++index) {
+                const double predicted = sigmoid(k, linear_evaluation(dataset, parameters, index));
+                const double residual = predicted - dataset.result[index];
+                error += residual * residual;
+                if (!local) {
+                    continue;
+                }
+                // d(error)/d(evaluation), up to the constant 2 * k * ln(10) / 400 applied below.
+                const double slope = residual * predicted * (1.0 - predicted);
+                const double mg_slope = slope * dataset.mg_factor[index];
+                const double eg_slope = slope * dataset.eg_factor[index];
+                for (std::uint32_t term = dataset.offsets[index];
+                     term < dataset.offsets[index + 1]; ++term) {
+                    const sirio::ClassicalTraceTerm &coefficient = dataset.terms[term];
+                    (*local)[coefficient.index] += mg_slope * coefficient.mg;
+                    (*local)[weight_count + coefficient.index] += eg_slope * coefficient.eg;
+                }
+            }
+            errors[thread] = error;
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    double error = 0.0;
+    for (double value : errors) {
+        error += value;
+    }
+    const double count = static_cast<double>(std::max<std::size_t>(dataset.size(), 1));
+    if (gradient) {
+        const double constant = 2.0 * k * kLn10 / 400.0 / count;
+        gradient->assign(weight_count * 2, 0.0);
+        for (const auto &local : gradients) {
+            for (std::size_t index = 0; index < local.size(); ++index) {
+                (*gradient)[index] += local[index] * constant;
+            }
+        }
+    }
+    return error / count;
+}
+
+// Golden-section search for the K that makes the untuned evaluation predict results best.
+double fit_k(const Dataset &dataset, const Parameters &parameters, unsigned threads) {
+    constexpr double kRatio = 0.6180339887498949;
+    double low = 0.05;
+    double high = 4.0;
+    double left = high - kRatio * (high - low);
+    double right = low + kRatio * (high - low);
+    double left_error = compute_error(dataset, parameters, left, threads, nullptr);
+    double right_error = compute_error(dataset, parameters, right, threads, nullptr);
+    for (int iteration = 0; iteration < 40 && high - low > 1e-4; ++iteration) {
+        if (left_error < right_error) {
+            high = right;
+            right = left;
+            right_error = left_error;
+            left = high - kRatio * (high - low);
+            left_error = compute_error(dataset, parameters, left, threads, nullptr);
+        } else {
+            low = left;
+            left = right;
+            left_error = right_error;
+            right = low + kRatio * (high - low);
+            right_error = compute_error(dataset, parameters, right, threads, nullptr);
+        }
+    }
+    return (low + high) / 2.0;
+}
+
+void write_value_list(std::ostream &out, const std::vector<int> &values) {
+    if (values.size() != 64) {
+        out << '{';
+        for (std::size_t index = 0; index < values.size(); ++index) {
+            out << (index ? ", " : "") << values[index];
+        }
+        out << "};\n";
+        return;
+    }
+    out << "{\n";
+    for (std::size_t rank = 0; rank < 8; ++rank) {
+        out << "    ";
+        for (std::size_t file = 0; file < 8; ++file) {
+            out << std::setw(3) << values[rank * 8 + file] << (file < 7 ? ", " : "");
+        }
+        out << (rank < 7 ? ",\n" : "};\n");
+    }
+}
+
+bool write_header(const std::string &path, const std::vector<sirio::ClassicalWeight> &weights) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    out << "// Generated by sirio_tune; see docs/evaluation.md. Edits by hand are overwritten on "
+           "the next run.\n"
+           "#pragma once\n\n"
+           "#include <array>\n\n"
+           "namespace sirio::evaluation_weights {\n";
+    std::size_t index = 0;
+    bool previous_scalar = false;
+    for (const sirio::ClassicalWeightGroup &group : sirio::classical_weight_groups()) {
+        if (group.size == 0) {
+            if (!previous_scalar) {
+                out << '\n';
+            }
+            out << "inline constexpr int " << group.mg_name << " = " << weights[index].mg << ";\n"
+                << "inline constexpr int " << group.eg_name << " = " << weights[index].eg << ";\n";
+            ++index;
+            previous_scalar = true;
+            continue;
+        }
+        std::vector<int> mg;
+        std::vector<int> eg;
+        for (std::size_t offset = 0; offset < group.size; ++offset, ++index) {
+            mg.push_back(weights[index].mg);
+            eg.push_back(weights[index].eg);
+        }
+        const bool table = group.size == 64;
+        out << '\n' << "inline constexpr std::array<int, " << group.size << "> " << group.mg_name
+            << " = ";
+        write_value_list(out, mg);
+        out << (table ? "\n" : "") << "inline constexpr std::array<int, " << group.size << "> "
+            << group.eg_name << " = ";
+        write_value_list(out, eg);
+        previous_scalar = false;
+    }
+    out << "\n}  // namespace sirio::evaluation_weights\n";
+    return static_cast<bool>(out);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage();
+        return 2;
+    }
+    const unsigned threads =
+        options.threads != 0 ? options.threads : std::max(1U, std::thread::hardware_concurrency());
+    sirio::use_classical_evaluation();
+
+    sirio::pgn::PgnFile file;
+    std::string error;
+    if (!file.open(options.dataset, &error)) {
+        std::cerr << "sirio_tune: " << error << "\n";
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto load_start = Clock::now();
+    const std::vector<sirio::ClassicalWeight> initial = sirio::classical_weights();
+    std::size_t rejected = 0;
+    const std::string_view extension = std::string_view{options.dataset}.substr(
+        std::min(options.dataset.rfind('.'), options.dataset.size()));
+    Dataset dataset = extension == ".pgn"
+                          ? load_pgn(file.text(), threads, options.skip_plies, initial, rejected)
+                          : load_epd(file.text(), threads, initial, rejected);
+    file.close();
+    if (options.limit != 0 && dataset.size() > options.limit) {
+        dataset.offsets.resize(options.limit + 1);
+        dataset.terms.resize(dataset.offsets.back());
+        dataset.mg_factor.resize(options.limit);
+        dataset.eg_factor.resize(options.limit);
+        dataset.fixed.resize(options.limit);
+        dataset.result.resize(options.limit);
+    }
+    if (dataset.size() == 0) {
+        std::cerr << "sirio_tune: no usable positions in " << options.dataset << "\n";
+        return 1;
+    }
+    const double load_seconds = std::chrono::duration<double>(Clock::now() - load_start).count();
+    std::cout << "Positions: " << dataset.size() << " (" << rejected << " skipped), "
+              << dataset.terms.size() / dataset.size() << " terms each, loaded in " << std::fixed
+              << std::setprecision(2) << load_seconds << " s on " << threads << " threads\n";
+
+    Parameters parameters;
+    for (const sirio::ClassicalWeight &weight : initial) {
+        parameters.mg.push_back(weight.mg);
+        parameters.eg.push_back(weight.eg);
+    }
+    const double k = options.k > 0.0 ? options.k : fit_k(dataset, parameters, threads);
+    std::cout << "K: " << std::setprecision(4) << k << "\n";
+    std::cout << "Initial error: " << std::setprecision(6)
+              << compute_error(dataset, parameters, k, threads, nullptr) << "\n";
+
+    // Adam, with the learning rate in centipawns per step.
+    constexpr double kBeta1 = 0.9;
+    constexpr double kBeta2 = 0.999;
+    constexpr double kEpsilon = 1e-8;
+    const std::size_t weight_count = parameters.mg.size();
+    std::vector<double> gradient;
+    std::vector<double> first_moment(weight_count * 2, 0.0);
+    std::vector<double> second_moment(weight_count * 2, 0.0);
+    const auto tune_start = Clock::now();
+    for (int epoch = 1; epoch <= options.epochs; ++epoch) {
+        const double epoch_error = compute_error(dataset, parameters, k, threads, &gradient);
+        const double correction1 = 1.0 - std::pow(kBeta1, epoch);
+        const double correction2 = 1.0 - std::pow(kBeta2, epoch);
+        for (std::size_t index = 0; index < weight_count * 2; ++index) {
+            first_moment[index] = kBeta1 * first_moment[index] + (1.0 - kBeta1) * gradient[index];
+            second_moment[index] =
+                kBeta2 * second_moment[index] + (1.0 - kBeta2) * gradient[index] * gradient[index];
+            const double step = options.learning_rate * (first_moment[index] / correction1) /
+                                (std::sqrt(second_moment[index] / correction2) + kEpsilon);
+            double &weight = index < weight_count ? parameters.mg[index]
+                                                  : parameters.eg[index - weight_count];
+            weight -= step;
+        }
+        if (epoch % 25 == 0 || epoch == options.epochs) {
+            std::cout << "Epoch " << epoch << ": error " << epoch_error << "\n";
+        }
+    }
+    const double tune_seconds = std::chrono::duration<double>(Clock::now() - tune_start).count();
+
+    std::vector<sirio::ClassicalWeight> tuned;
+    for (std::size_t index = 0; index < weight_count; ++index) {
+        tuned.push_back({static_cast<int>(std::lround(parameters.mg[index])),
+                         static_cast<int>(std::lround(parameters.eg[index]))});
+    }
+    for (std::size_t index = 0; index < weight_count; ++index) {
+        parameters.mg[index] = tuned[index].mg;
+        parameters.eg[index] = tuned[index].eg;
+    }
+    std::cout << "Final error: " << compute_error(dataset, parameters, k, threads, nullptr) << " ("
+              << std::setprecision(2) << tune_seconds << " s)\n";
+
+    if (!write_header(options.output, tuned)) {
+        std::cerr << "sirio_tune: cannot write " << options.output << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << options.output << "\n";
+    return 0;
+}